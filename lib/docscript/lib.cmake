@@ -16,6 +16,7 @@ set (docscript_cpp
 #	lib/docscript/src/generator.cpp  
 #	lib/docscript/src/library.cpp  
 	lib/docscript/src/statistics.cpp  
+	lib/docscript/src/tracer.cpp
 )
     
 set (docscript_h
@@ -33,6 +34,7 @@ set (docscript_h
 #	src/main/include/docscript/generator.h  
 #	src/main/include/docscript/library.h  
 	src/main/include/docscript/statistics.h  
+	src/main/include/docscript/tracer.h
 )
 
 set (docscript_generator
@@ -43,6 +45,24 @@ set (docscript_generator
 	src/main/include/docscript/generator/gen_asciidoc.h  
 	src/main/include/docscript/generator/gen_LaTeX.h  
 	src/main/include/docscript/generator/numbering.h
+	src/main/include/docscript/generator/assets.h
+	src/main/include/docscript/generator/base64.h
+	src/main/include/docscript/generator/cache.h
+	src/main/include/docscript/generator/escape.h
+	src/main/include/docscript/generator/image.h
+	src/main/include/docscript/generator/labels.h
+	src/main/include/docscript/generator/minify.h
+	src/main/include/docscript/generator/placeholder.h
+	src/main/include/docscript/generator/pool.h
+	src/main/include/docscript/generator/precompress.h
+	src/main/include/docscript/generator/profiler.h
+	src/main/include/docscript/generator/rope.h
+	src/main/include/docscript/generator/sink.h
+	src/main/include/docscript/generator/source.h
+	src/main/include/docscript/generator/style.h
+	src/main/include/docscript/generator/svg.h
+	src/main/include/docscript/generator/table.h
+	src/main/include/docscript/generator/workers.h
 	lib/docscript/src/generator/generator.cpp
 	lib/docscript/src/generator/gen_html.cpp
 	lib/docscript/src/generator/gen_bootstrap.cpp
@@ -50,6 +70,24 @@ set (docscript_generator
 	lib/docscript/src/generator/gen_asciidoc.cpp
 	lib/docscript/src/generator/gen_LaTeX.cpp
 	lib/docscript/src/generator/numbering.cpp
+	lib/docscript/src/generator/assets.cpp
+	lib/docscript/src/generator/base64.cpp
+	lib/docscript/src/generator/cache.cpp
+	lib/docscript/src/generator/escape.cpp
+	lib/docscript/src/generator/image.cpp
+	lib/docscript/src/generator/labels.cpp
+	lib/docscript/src/generator/minify.cpp
+	lib/docscript/src/generator/placeholder.cpp
+	lib/docscript/src/generator/pool.cpp
+	lib/docscript/src/generator/precompress.cpp
+	lib/docscript/src/generator/profiler.cpp
+	lib/docscript/src/generator/rope.cpp
+	lib/docscript/src/generator/sink.cpp
+	lib/docscript/src/generator/source.cpp
+	lib/docscript/src/generator/style.cpp
+	lib/docscript/src/generator/svg.cpp
+	lib/docscript/src/generator/table.cpp
+	lib/docscript/src/generator/workers.cpp
 )
 
 set (docscript_filter
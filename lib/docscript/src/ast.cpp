@@ -7,6 +7,7 @@
 
 #include <docscript/ast.h>
 #include <docscript/lookup.h>
+#include <docscript/generator/escape.h>
 
 #include <cyng/object.h>
 #include <cyng/vm/generator.h>
@@ -739,24 +740,22 @@ namespace docscript
 					;
 			}
 			else {
-				os
-					<< sym.value_
-					;
+				escape_html(os, sym.value_);
 			}
 		}
 		else if (sym.is_type(SYM_VERBATIM)) {
 			os
 				<< "'"
 				<< color_green_
-				<< sym.value_
+				;
+			escape_html(os, sym.value_);
+			os
 				<< end_
 				<< "'"
 				;
 		}
 		else {
-			os
-				<< sym.value_
-				;
+			escape_html(os, sym.value_);
 		}
 	}
 
@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/assets.h>
+#include <docscript/generator/cache.h>
+#include <docscript/generator/precompress.h>
+
+#include <cyng/factory.h>
+#include <cyng/json.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+namespace docscript
+{
+	asset_store::asset_store(cyng::filesystem::path const& root, std::uintmax_t threshold, bool hardlink)
+		: dir_(root / "assets")
+		, threshold_(threshold)
+		, hardlink_(hardlink)
+		, precompress_(PRECOMPRESS_NONE)
+		, mutex_()
+		, assets_()
+	{}
+
+	bool asset_store::is_inline(std::uintmax_t size) const
+	{
+		return size <= threshold_;
+	}
+
+	void asset_store::set_precompress(unsigned formats)
+	{
+		precompress_ = formats;
+	}
+
+	std::string asset_store::emit(cyng::filesystem::path const& p, std::string hash)
+	{
+		cyng::error_code ec;
+		auto const size = cyng::filesystem::file_size(p, ec);
+		if (ec) {
+			std::cerr
+				<< "***error cannot read asset ["
+				<< p
+				<< "]: "
+				<< ec.message()
+				<< std::endl;
+			return std::string();
+		}
+
+		if (hash.empty()) {
+			std::ifstream ifs(p.string(), std::ios::binary);
+			std::stringstream ss;
+			ss << ifs.rdbuf();
+			hash = compute_hash(ss.str());
+		}
+
+		//
+		//	64 bit of the content hash are sufficient to
+		//	distinguish all images of a site
+		//
+		auto const name = hash.substr(0, 16) + boost::algorithm::to_lower_copy(p.extension().string());
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (assets_.find(name) == assets_.end()) {
+
+			auto const target = dir_ / name;
+			bool created{ false };
+			if (!cyng::filesystem::exists(target, ec)) {
+
+				cyng::filesystem::create_directories(dir_, ec);
+
+				ec.clear();
+				if (hardlink_) {
+					cyng::filesystem::create_hard_link(p, target, ec);
+				}
+				if (!hardlink_ || ec) {
+
+					//
+					//	fallback if source and target are on different devices
+					//
+					ec.clear();
+					cyng::filesystem::copy_file(p, target, ec);
+				}
+				if (ec) {
+					std::cerr
+						<< "***error cannot create asset ["
+						<< target
+						<< "]: "
+						<< ec.message()
+						<< std::endl;
+					return std::string();
+				}
+				created = true;
+			}
+			assets_.emplace(name, asset{ cyng::filesystem::absolute(p).string(), size, created });
+
+			//
+			//	images in other formats are already compressed.
+			//	Sidecars of unchanged assets are kept.
+			//
+			if (precompress_ != PRECOMPRESS_NONE && boost::algorithm::ends_with(name, ".svg")) {
+				lock.unlock();
+				precompress_file(target, precompress_);
+			}
+		}
+		return "assets/" + name;
+	}
+
+	cyng::object asset_store::to_object() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		cyng::vector_t vec;
+		for (auto const& a : assets_) {
+			vec.push_back(cyng::param_map_factory("file", "assets/" + a.first)
+				("source", a.second.source_)
+				("size", a.second.size_)
+				("created", a.second.created_)());
+		}
+		return cyng::param_map_factory("count", assets_.size())
+			("assets", vec)();
+	}
+
+	bool asset_store::write_manifest() const
+	{
+		cyng::error_code ec;
+		cyng::filesystem::create_directories(dir_, ec);
+
+		auto const p = dir_ / "manifest.json";
+		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		if (!ofs.is_open())	return false;
+		ofs << cyng::json::to_string(to_object()) << std::flush;
+		return true;
+	}
+}
@@ -0,0 +1,262 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/base64.h>
+
+#include <array>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DOCSCRIPT_BASE64_X86 1
+#define DOCSCRIPT_TARGET(X) __attribute__((target(X)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define DOCSCRIPT_BASE64_X86 1
+#define DOCSCRIPT_TARGET(X)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace docscript
+{
+	namespace {
+
+		char const alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		/**
+		 * Encodes all remaining bytes including padding
+		 */
+		std::size_t encode_scalar(unsigned char const* src, std::size_t size, char* dst)
+		{
+			char* const start = dst;
+			std::size_t idx = 0;
+			for (; idx + 3 <= size; idx += 3) {
+				std::uint32_t const v = (std::uint32_t(src[idx]) << 16) | (std::uint32_t(src[idx + 1]) << 8) | src[idx + 2];
+				*dst++ = alphabet[(v >> 18) & 0x3f];
+				*dst++ = alphabet[(v >> 12) & 0x3f];
+				*dst++ = alphabet[(v >> 6) & 0x3f];
+				*dst++ = alphabet[v & 0x3f];
+			}
+
+			switch (size - idx) {
+			case 1:
+				*dst++ = alphabet[src[idx] >> 2];
+				*dst++ = alphabet[(src[idx] & 0x03) << 4];
+				*dst++ = '=';
+				*dst++ = '=';
+				break;
+			case 2:
+				*dst++ = alphabet[src[idx] >> 2];
+				*dst++ = alphabet[((src[idx] & 0x03) << 4) | (src[idx + 1] >> 4)];
+				*dst++ = alphabet[(src[idx + 1] & 0x0f) << 2];
+				*dst++ = '=';
+				break;
+			default:
+				break;
+			}
+			return dst - start;
+		}
+
+#if defined(DOCSCRIPT_BASE64_X86)
+
+		/**
+		 * Split 12 bytes into 16 indices (6 bit) and translate them
+		 * into ASCII. Since the lookup table has only 16 entries the
+		 * indices are mapped to an offset that is added to the index.
+		 *
+		 * @see http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+		 */
+		DOCSCRIPT_TARGET("ssse3")
+		std::size_t encode_ssse3(unsigned char const* src, std::size_t size, char* dst)
+		{
+			__m128i const shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+			__m128i const shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+			std::size_t idx = 0;
+
+			//
+			//	16 bytes are loaded but only 12 are consumed
+			//
+			for (; idx + 16 <= size; idx += 12, dst += 16) {
+				__m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + idx));
+				in = _mm_shuffle_epi8(in, shuffle);
+
+				__m128i const t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+				__m128i const t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+				__m128i const t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+				__m128i const t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+				__m128i const indices = _mm_or_si128(t1, t3);
+
+				__m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+				__m128i const less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+				result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+				result = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, result), indices);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), result);
+			}
+			return idx;
+		}
+
+		/**
+		 * Same as SSSE3 with 24 bytes per iteration. Each 128 bit lane
+		 * gets 12 bytes of input.
+		 */
+		DOCSCRIPT_TARGET("avx2")
+		std::size_t encode_avx2(unsigned char const* src, std::size_t size, char* dst)
+		{
+			__m256i const shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1
+				, 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+			__m256i const shift_lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+				, 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+			std::size_t idx = 0;
+
+			//
+			//	28 bytes are loaded but only 24 are consumed
+			//
+			for (; idx + 28 <= size; idx += 24, dst += 32) {
+				__m128i const lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + idx));
+				__m128i const hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + idx + 12));
+				__m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+				in = _mm256_shuffle_epi8(in, shuffle);
+
+				__m256i const t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+				__m256i const t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+				__m256i const t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+				__m256i const t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+				__m256i const indices = _mm256_or_si256(t1, t3);
+
+				__m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+				__m256i const less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+				result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+				result = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, result), indices);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), result);
+			}
+			return idx;
+		}
+
+		enum class kernel {
+			SCALAR,
+			SSSE3,
+			AVX2
+		};
+
+		kernel detect_kernel()
+		{
+#if defined(__GNUC__)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))	return kernel::AVX2;
+			if (__builtin_cpu_supports("ssse3"))	return kernel::SSSE3;
+#else
+			int info[4] = { 0 };
+			__cpuid(info, 0);
+			int const max_id = info[0];
+			bool ssse3 = false, avx2 = false;
+			if (max_id >= 1) {
+				__cpuid(info, 1);
+				ssse3 = (info[2] & (1 << 9)) != 0;
+				bool const osxsave = (info[2] & (1 << 27)) != 0;
+				bool const avx = (info[2] & (1 << 28)) != 0;
+				if (max_id >= 7 && osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6)) {
+					__cpuidex(info, 7, 0);
+					avx2 = (info[1] & (1 << 5)) != 0;
+				}
+			}
+			if (avx2)	return kernel::AVX2;
+			if (ssse3)	return kernel::SSSE3;
+#endif
+			return kernel::SCALAR;
+		}
+#else
+		enum class kernel {
+			SCALAR
+		};
+
+		kernel detect_kernel()
+		{
+			return kernel::SCALAR;
+		}
+#endif
+
+		kernel get_kernel()
+		{
+			static kernel const k = detect_kernel();
+			return k;
+		}
+	}
+
+	std::size_t base64_encoded_size(std::size_t size)
+	{
+		return ((size + 2) / 3) * 4;
+	}
+
+	std::size_t base64_encode(char const* src, std::size_t size, char* dst)
+	{
+		auto const* p = reinterpret_cast<unsigned char const*>(src);
+		std::size_t idx = 0;
+		char* out = dst;
+
+#if defined(DOCSCRIPT_BASE64_X86)
+		switch (get_kernel()) {
+		case kernel::AVX2:
+			idx = encode_avx2(p, size, out);
+			out += (idx / 3) * 4;
+			//	fall through
+		case kernel::SSSE3:
+		{
+			auto const n = encode_ssse3(p + idx, size - idx, out);
+			idx += n;
+			out += (n / 3) * 4;
+		}
+			break;
+		default:
+			break;
+		}
+#endif
+
+		out += encode_scalar(p + idx, size - idx, out);
+		return out - dst;
+	}
+
+	void base64_encode(std::string& str, char const* src, std::size_t size)
+	{
+		auto const pos = str.size();
+		str.resize(pos + base64_encoded_size(size));
+		base64_encode(src, size, &str[pos]);
+	}
+
+	void base64_encode(std::ostream& os, char const* src, std::size_t size)
+	{
+		//
+		//	3 KB input per chunk
+		//
+		std::array<char, 4096> buffer;
+		std::size_t const chunk = (buffer.size() / 4) * 3;
+
+		while (size != 0) {
+			auto const n = (size < chunk) ? size : chunk;
+			auto const len = base64_encode(src, n, buffer.data());
+			os.write(buffer.data(), static_cast<std::streamsize>(len));
+			src += n;
+			size -= n;
+		}
+	}
+
+	char const* base64_kernel()
+	{
+		switch (get_kernel()) {
+#if defined(DOCSCRIPT_BASE64_X86)
+		case kernel::AVX2:	return "avx2";
+		case kernel::SSSE3:	return "ssse3";
+#endif
+		default:
+			break;
+		}
+		return "scalar";
+	}
+}
@@ -0,0 +1,297 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/generator/cache.h>
+
+#include <openssl/evp.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace docscript
+{
+	std::string to_hex(unsigned char const* p, std::size_t size)
+	{
+		static char const hex[] = "0123456789abcdef";
+		std::string str;
+		str.reserve(size * 2);
+		for (std::size_t idx = 0; idx < size; ++idx) {
+			str.push_back(hex[p[idx] >> 4]);
+			str.push_back(hex[p[idx] & 0x0f]);
+		}
+		return str;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 *
+	 * @return temporary file name that is unique for each writer: a random
+	 * token of this process, the thread id and a counter
+	 */
+	cyng::filesystem::path make_temp_path(cyng::filesystem::path p)
+	{
+		static std::string const process = []() {
+			std::random_device rd;
+			std::array<unsigned char, 8> token;
+			for (auto& c : token) {
+				c = static_cast<unsigned char>(rd());
+			}
+			return to_hex(token.data(), token.size());
+		}();
+		static std::atomic<std::uint64_t> counter{ 0 };
+
+		std::ostringstream ss;
+		ss
+			<< '.'
+			<< process
+			<< '-'
+			<< std::this_thread::get_id()
+			<< '-'
+			<< ++counter
+			<< ".tmp"
+			;
+		p += ss.str();
+		return p;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Replace the target with the temporary file or remove
+	 * the temporary file on failure.
+	 */
+	void commit_temp_file(cyng::filesystem::path const& tmp, cyng::filesystem::path const& p)
+	{
+		cyng::error_code ec;
+		cyng::filesystem::rename(tmp, p, ec);
+		if (ec) {
+			cyng::filesystem::remove(tmp, ec);
+		}
+	}
+
+	content_cache::content_cache(cyng::filesystem::path const& dir, std::size_t limit)
+		: dir_(dir)
+		, limit_(limit)
+		, mutex_()
+		, files_()
+		, values_()
+		, size_(0)
+	{
+		if (!dir_.empty()) {
+			cyng::error_code ec;
+			cyng::filesystem::create_directories(dir_, ec);
+			if (ec) {
+				std::cerr
+					<< "***error cannot create cache directory ["
+					<< dir_
+					<< "]: "
+					<< ec.message()
+					<< std::endl;
+			}
+			load_index();
+		}
+	}
+
+	content_cache::~content_cache()
+	{
+		if (!dir_.empty()) {
+			save_index();
+		}
+	}
+
+	std::string content_cache::get_hash(cyng::filesystem::path const& p)
+	{
+		cyng::error_code ec;
+		auto const size = cyng::filesystem::file_size(p, ec);
+		if (ec)	return std::string();
+		auto const mtime = static_cast<std::int64_t>(cyng::filesystem::get_write_time(p).time_since_epoch().count());
+
+		auto const key = cyng::filesystem::absolute(p).string();
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto const pos = files_.find(key);
+			if (pos != files_.end() && pos->second.size_ == size && pos->second.mtime_ == mtime) {
+
+				//
+				//	unchanged - no need to read the file
+				//
+				return pos->second.hash_;
+			}
+		}
+
+		std::ifstream ifs(p.string(), std::ios::binary);
+		if (!ifs.is_open())	return std::string();
+
+		std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+		EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr);
+
+		std::array<char, 0x10000> buffer;
+		while (ifs) {
+			ifs.read(buffer.data(), buffer.size());
+			auto const n = ifs.gcount();
+			if (n > 0)	EVP_DigestUpdate(ctx.get(), buffer.data(), static_cast<std::size_t>(n));
+		}
+
+		std::array<unsigned char, EVP_MAX_MD_SIZE> md;
+		unsigned int len{ 0 };
+		EVP_DigestFinal_ex(ctx.get(), md.data(), &len);
+		auto const hash = to_hex(md.data(), len);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		files_[key] = fingerprint{ size, mtime, hash };
+		return hash;
+	}
+
+	bool content_cache::get(std::string const& key, std::string& value)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto const pos = values_.find(key);
+			if (pos != values_.end()) {
+				value = pos->second;
+				return true;
+			}
+		}
+
+		if (!dir_.empty()) {
+			std::ifstream ifs(get_entry_path(key).string(), std::ios::binary);
+			if (ifs.is_open()) {
+				std::stringstream ss;
+				ss << ifs.rdbuf();
+				value = ss.str();
+
+				std::lock_guard<std::mutex> lock(mutex_);
+				remember(key, value);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void content_cache::put(std::string const& key, std::string const& value)
+	{
+		if (!dir_.empty()) {
+
+			//
+			//	write into a temporary file first so parallel
+			//	builds never read an incomplete entry. Each writer
+			//	has its own temporary file.
+			//
+			auto const p = get_entry_path(key);
+			auto const tmp = make_temp_path(p);
+			std::ofstream ofs(tmp.string(), std::ios::binary | std::ios::trunc);
+			if (ofs.is_open()) {
+				ofs.write(value.data(), value.size());
+				ofs.close();
+				if (ofs) {
+					commit_temp_file(tmp, p);
+				}
+				else {
+					cyng::error_code ec;
+					cyng::filesystem::remove(tmp, ec);
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		remember(key, value);
+	}
+
+	bool content_cache::is_persistent() const
+	{
+		return !dir_.empty();
+	}
+
+	void content_cache::remember(std::string const& key, std::string const& value)
+	{
+		if (size_ + value.size() <= limit_) {
+			if (values_.emplace(key, value).second) {
+				size_ += value.size();
+			}
+		}
+	}
+
+	cyng::filesystem::path content_cache::get_entry_path(std::string const& key) const
+	{
+		return dir_ / compute_hash(key);
+	}
+
+	void content_cache::load_index()
+	{
+		//
+		//	format: size mtime hash path
+		//
+		std::ifstream ifs((dir_ / "index.txt").string());
+		std::string line;
+		while (std::getline(ifs, line)) {
+			std::istringstream iss(line);
+			fingerprint fp;
+			std::string name;
+			if (iss >> fp.size_ >> fp.mtime_ >> fp.hash_) {
+				std::getline(iss >> std::ws, name);
+				if (!name.empty())	files_.emplace(name, fp);
+			}
+		}
+	}
+
+	void content_cache::save_index() const
+	{
+		auto const p = dir_ / "index.txt";
+		auto const tmp = make_temp_path(p);
+		std::ofstream ofs(tmp.string(), std::ios::trunc);
+		if (!ofs.is_open())	return;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			for (auto const& f : files_) {
+				ofs
+					<< f.second.size_
+					<< ' '
+					<< f.second.mtime_
+					<< ' '
+					<< f.second.hash_
+					<< ' '
+					<< f.first
+					<< '\n'
+					;
+			}
+		}
+		ofs.close();
+		if (ofs) {
+			commit_temp_file(tmp, p);
+		}
+		else {
+			cyng::error_code ec;
+			cyng::filesystem::remove(tmp, ec);
+		}
+	}
+
+	std::string compute_hash(char const* p, std::size_t size)
+	{
+		std::array<unsigned char, EVP_MAX_MD_SIZE> md;
+		unsigned int len{ 0 };
+		EVP_Digest(p, size, md.data(), &len, EVP_sha256(), nullptr);
+		return to_hex(md.data(), len);
+	}
+
+	std::string compute_hash(std::string const& s)
+	{
+		return compute_hash(s.data(), s.size());
+	}
+
+	std::string make_key(std::string const& hash, std::string const& kind, std::string const& params)
+	{
+		return hash + ':' + kind + ':' + params;
+	}
+
+}
@@ -0,0 +1,240 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/escape.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define DOCSCRIPT_ESCAPE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit.
+	 *
+	 * @return index of the lowest set bit. mask must not be 0.
+	 */
+	std::size_t first_bit(unsigned mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long idx{ 0 };
+		_BitScanForward(&idx, mask);
+		return static_cast<std::size_t>(idx);
+#else
+		return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+	}
+
+	char_set::char_set(std::string_view chars)
+		: table_()
+		, chars_()
+		, needles_()
+		, size_(0)
+		, simd_(false)
+	{
+		table_.fill(false);
+		std::size_t distinct{ 0 };
+		for (auto const c : chars) {
+			auto const idx = static_cast<unsigned char>(c);
+			if (table_.at(idx))	continue;
+			table_.at(idx) = true;
+			++distinct;
+			if (size_ < chars_.size()) {
+				needles_.at(size_).fill(c);
+				chars_.at(size_++) = c;
+			}
+		}
+
+		//
+		//	pair rules repeat characters - only distinct characters count
+		//
+#if defined(DOCSCRIPT_ESCAPE_SSE2)
+		simd_ = (distinct <= chars_.size());
+#endif
+	}
+
+	bool char_set::is_simd() const
+	{
+		return simd_ && size_ != 0;
+	}
+
+	bool char_set::contains(char c) const
+	{
+		return table_.at(static_cast<unsigned char>(c));
+	}
+
+	char const* char_set::find(char const* pos, char const* end) const
+	{
+		if (simd_ && size_ != 0) {
+#if defined(__AVX2__)
+			while (end - pos >= 32) {
+				auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(pos));
+				auto hit = _mm256_cmpeq_epi8(block, _mm256_load_si256(reinterpret_cast<__m256i const*>(needles_[0].data())));
+				for (std::size_t i = 1; i < size_; ++i) {
+					hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, _mm256_load_si256(reinterpret_cast<__m256i const*>(needles_[i].data()))));
+				}
+				auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+				if (mask != 0)	return pos + first_bit(mask);
+				pos += 32;
+			}
+#endif
+#if defined(DOCSCRIPT_ESCAPE_SSE2)
+			while (end - pos >= 16) {
+				auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pos));
+				auto hit = _mm_cmpeq_epi8(block, _mm_load_si128(reinterpret_cast<__m128i const*>(needles_[0].data())));
+				for (std::size_t i = 1; i < size_; ++i) {
+					hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, _mm_load_si128(reinterpret_cast<__m128i const*>(needles_[i].data()))));
+				}
+				auto const mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+				if (mask != 0)	return pos + first_bit(mask);
+				pos += 16;
+			}
+#endif
+		}
+
+		//
+		//	tail
+		//
+		while (pos != end && !contains(*pos)) {
+			++pos;
+		}
+		return pos;
+	}
+
+	escape_table::escape_table(std::initializer_list<std::pair<char, std::string_view>> singles
+		, std::initializer_list<pair_rule> pairs)
+		: specials_(make_specials(singles, pairs))
+		, singles_()
+		, pairs_(pairs)
+	{
+		for (auto const& s : singles) {
+			singles_.at(static_cast<unsigned char>(s.first)) = s.second;
+		}
+	}
+
+	char_set escape_table::make_specials(std::initializer_list<std::pair<char, std::string_view>> singles
+		, std::initializer_list<pair_rule> pairs)
+	{
+		std::string chars;
+		for (auto const& s : singles) {
+			chars.push_back(s.first);
+		}
+		for (auto const& p : pairs) {
+			chars.push_back(p.first_);
+		}
+		return char_set(chars);
+	}
+
+	template<typename F>
+	void escape_table::scan(std::string_view s, F&& emit) const
+	{
+		auto pos = s.data();
+		auto const end = pos + s.size();
+		while (pos != end) {
+
+			//
+			//	copy clean run
+			//
+			auto const next = specials_.find(pos, end);
+			if (next != pos)	emit(pos, static_cast<std::size_t>(next - pos));
+			if (next == end)	break;
+
+			pos = next;
+			bool matched{ false };
+			if (pos + 1 != end) {
+				for (auto const& rule : pairs_) {
+					if (rule.first_ == pos[0] && rule.second_ == pos[1]) {
+						emit(rule.replacement_.data(), rule.replacement_.size());
+						pos += 2;
+						matched = true;
+						break;
+					}
+				}
+			}
+			if (!matched) {
+				auto const r = get(*pos);
+				if (r.data() != nullptr) {
+					emit(r.data(), r.size());
+				}
+				else {
+					emit(pos, 1);
+				}
+				++pos;
+			}
+		}
+	}
+
+	void escape_table::append(std::string& out, std::string_view s) const
+	{
+		out.reserve(out.size() + s.size());
+		scan(s, [&out](char const* p, std::size_t n) {
+			out.append(p, n);
+		});
+	}
+
+	std::string escape_table::operator()(std::string_view s) const
+	{
+		std::string r;
+		append(r, s);
+		return r;
+	}
+
+	void escape_table::write(std::ostream& os, std::string_view s) const
+	{
+		scan(s, [&os](char const* p, std::size_t n) {
+			os.write(p, static_cast<std::streamsize>(n));
+		});
+	}
+
+	std::string_view escape_table::get(char c) const
+	{
+		return singles_.at(static_cast<unsigned char>(c));
+	}
+
+	escape_table const& html_text_escape()
+	{
+		static escape_table const table({
+			{ '&', "&amp;" },
+			{ '<', "&lt;" },
+			{ '>', "&gt;" },
+			{ '"', "&quot;" } });
+		return table;
+	}
+
+	escape_table const& html_attribute_escape()
+	{
+		static escape_table const table({
+			{ '&', "&amp;" },
+			{ '<', "&lt;" },
+			{ '>', "&gt;" },
+			{ '"', "&quot;" },
+			{ '\'', "&#39;" } });
+		return table;
+	}
+
+	void escape_html(std::ostream& os, std::string_view s)
+	{
+		html_text_escape().write(os, s);
+	}
+
+	std::string escape_html(std::string_view s)
+	{
+		return html_text_escape()(s);
+	}
+
+	void escape_html_attribute(std::ostream& os, std::string_view s)
+	{
+		html_attribute_escape().write(os, s);
+	}
+}
@@ -6,27 +6,26 @@
  */
 
 #include "binary_to_html.h"
+#include <docscript/generator/escape.h>
 #include <sstream>
 #include <iomanip>
 #include <bitset>
 
 namespace docscript
 {
-	std::string to_html(char c)
+	/**
+	 * Only visible in this compilation unit
+	 */
+	std::ostream& to_html(std::ostream& os, char c)
 	{
-		switch (c) {
-		case '<':	return "&lt;";
-		case '>':	return "&gt;";
-		case '"':	return "&quot;";
-		case '&':	return "&amp;";
-		default:
-			break;
+		auto const entity = html_text_escape().get(c);
+		if (entity.data() != nullptr) {
+			os << entity;
 		}
-
-		return ((c >= 0x20) && (c <= 0x7e))
-			? std::string(1, c)
-			: "."
-			;
+		else {
+			os.put(((c >= 0x20) && (c <= 0x7e)) ? c : '.');
+		}
+		return os;
 	}
 
 	binary_to_html::binary_to_html(bool linenumbers, boost::uuids::uuid tag)
@@ -37,10 +36,10 @@ namespace docscript
 
 	void binary_to_html::convert(std::ostream& os, cyng::buffer_t const& inp)
 	{
-		convert(os, inp.begin(), inp.end());
+		convert(os, inp.data(), inp.data() + inp.size());
 	}
 
-	void binary_to_html::convert(std::ostream& os, cyng::buffer_t::const_iterator begin, cyng::buffer_t::const_iterator end)
+	void binary_to_html::convert(std::ostream& os, char const* begin, char const* end)
 	{
 		std::stringstream	ascii_values;
 		bool gap = false;
@@ -97,7 +96,8 @@ namespace docscript
 				<< std::dec	
 				<< ((*pos) & 0xFF)
 				<< " / "
-				<< to_html(*pos)
+				;
+			to_html(os, *pos)
 				<< "\">"
 				<< std::setfill('0')
 				<< std::setw(2)
@@ -110,7 +110,7 @@ namespace docscript
 			//
 			//	HTML entities
 			//
-			ascii_values << to_html(*pos);
+			to_html(ascii_values, *pos);
 
 			//	detect end of line
 			if ((count_ > 0) && ((count_ % width_) == (width_ - 1)))
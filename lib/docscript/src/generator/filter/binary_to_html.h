@@ -22,9 +22,7 @@ namespace docscript
 	public:
 		binary_to_html(bool linenumbers, boost::uuids::uuid);
 		void convert(std::ostream&, cyng::buffer_t const&);
-
-	private:
-		void convert(std::ostream&, cyng::buffer_t::const_iterator, cyng::buffer_t::const_iterator);
+		void convert(std::ostream&, char const* begin, char const* end);
 
 	private:
 		bool const linenumbers_;
@@ -43,11 +43,11 @@ namespace docscript
 	void binary_to_latex::convert(std::ostream& os, cyng::buffer_t const& inp)
 	{
 // 		os << std::string(3, '`') << std::endl;
-		convert(os, inp.begin(), inp.end());
+		convert(os, inp.data(), inp.data() + inp.size());
 // 		os << std::string(3, '`') << std::endl;
 	}
 
-	void binary_to_latex::convert(std::ostream& os, cyng::buffer_t::const_iterator begin, cyng::buffer_t::const_iterator end)
+	void binary_to_latex::convert(std::ostream& os, char const* begin, char const* end)
 	{
 		std::stringstream	ascii_values;
 		bool gap = false;
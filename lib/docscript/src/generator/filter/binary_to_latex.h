@@ -22,9 +22,8 @@ namespace docscript
 	public:
 		binary_to_latex(bool linenumbers, boost::uuids::uuid);
 		void convert(std::ostream&, cyng::buffer_t const&);
+		void convert(std::ostream&, char const* begin, char const* end);
 
-	private:
-		void convert(std::ostream&, cyng::buffer_t::const_iterator, cyng::buffer_t::const_iterator);
 	private:
 
 		bool const linenumbers_;
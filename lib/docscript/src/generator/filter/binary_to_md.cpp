@@ -38,13 +38,18 @@ namespace docscript
 	{}
 
 	void binary_to_md::convert(std::ostream& os, cyng::buffer_t const& inp)
+	{
+		convert(os, inp.data(), inp.data() + inp.size());
+	}
+
+	void binary_to_md::convert(std::ostream& os, char const* begin, char const* end)
 	{
 		os << std::string(3, '`') << std::endl;
-		convert(os, inp.begin(), inp.end());
+		dump(os, begin, end);
 		os << std::string(3, '`') << std::endl;
 	}
 
-	void binary_to_md::convert(std::ostream& os, cyng::buffer_t::const_iterator begin, cyng::buffer_t::const_iterator end)
+	void binary_to_md::dump(std::ostream& os, char const* begin, char const* end)
 	{
 		std::stringstream	ascii_values;
 		bool gap = false;
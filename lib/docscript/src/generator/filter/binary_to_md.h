@@ -22,9 +22,10 @@ namespace docscript
 	public:
 		binary_to_md(bool linenumbers, boost::uuids::uuid);
 		void convert(std::ostream&, cyng::buffer_t const&);
+		void convert(std::ostream&, char const* begin, char const* end);
 
 	private:
-		void convert(std::ostream&, cyng::buffer_t::const_iterator, cyng::buffer_t::const_iterator);
+		void dump(std::ostream&, char const* begin, char const* end);
 	private:
 
 		bool const linenumbers_;
@@ -7,6 +7,7 @@
 
 #include "cpp_to_html.h"
 #include <docscript/sanitizer.h>
+#include <docscript/generator/escape.h>
 
 #include <cctype>
 #include <iomanip>
@@ -531,12 +532,18 @@ namespace docscript
 		};
 	}
 
-	cpp_to_html::cpp_to_html(bool linenumbers, boost::uuids::uuid tag)
+	cpp_to_html::cpp_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, offset_(offset)
 	{}
 
 	void cpp_to_html::convert(std::ostream& os, std::string const& inp)
+	{
+		convert(os, inp.data(), inp.data() + inp.size());
+	}
+
+	void cpp_to_html::convert(std::ostream& os, char const* start, char const* stop)
 	{
 		/**
 		 * Process the stream of input tokens and generate symbols
@@ -552,7 +559,7 @@ namespace docscript
 				os << "???";
 				break;
 			case cpp::SYM_MARK:
-				os << sym.value_;
+				write_entity(os, sym.value_);
 				break;
 			case cpp::SYM_ENITIY:
 				write_entity(os, sym.value_);
@@ -561,25 +568,31 @@ namespace docscript
 				os
 					<< '#'
 					<< color_grey_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					<< ' '
 					;
 				break;
 			case cpp::SYM_INC_SYS:
 				os
-					<< '<'
+					<< "&lt;"
 					<< color_red_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
-					<< '>'
+					<< "&gt;"
 					;
 				break;
 			case cpp::SYM_INC_USER:
 				os
 					<< '"'
 					<< color_red_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					<< '"'
 					;
@@ -587,7 +600,9 @@ namespace docscript
 			case cpp::SYM_PRE_STM:
 				os
 					<< color_brown_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					;
 				break;
@@ -595,7 +610,9 @@ namespace docscript
 				os
 					<< "// "
 					<< color_green_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					;
 				break;
@@ -607,9 +624,7 @@ namespace docscript
 					;
 				break;
 			case cpp::SYM_LITERAL:
-				os
-					<< sym.value_
-					;
+				write_entity(os, sym.value_);
 				break;
 			case cpp::SYM_NUMBER:
 				os
@@ -622,7 +637,9 @@ namespace docscript
 				os
 					<< '"'
 					<< color_red_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					<< '"'
 					;
@@ -631,7 +648,9 @@ namespace docscript
 				os
 					<< '\''
 					<< color_red_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_);
+				os
 					<< end_
 					<< '\''
 					;
@@ -639,8 +658,9 @@ namespace docscript
 			case cpp::SYM_DBL_OP:
 				os
 					<< color_green_
-					<< sym.value_
-					<< sym.value_
+					;
+				write_entity(os, sym.value_ + sym.value_);
+				os
 					<< end_
 					;
 				break;
@@ -670,9 +690,7 @@ namespace docscript
 		//
 		//	read input
 		//
-		auto const start = std::begin(inp);
-		auto const stop = std::end(inp);
-		san.read(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
+		san.read(boost::u8_to_u32_iterator<char const*>(start), boost::u8_to_u32_iterator<char const*>(stop));
 		san.flush(true);
 	}
 
@@ -694,11 +712,11 @@ namespace docscript
 				<< "<span style = \"color: DarkCyan; font-size: smaller;\" id=\""
 				<< tag_
 				<< '-'
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "\">"
 				<< std::setw(4)
 				<< std::setfill(' ')
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "</span> "
 				;
 		}
@@ -706,25 +724,7 @@ namespace docscript
 
 	void cpp_to_html::write_entity(std::ostream& os, std::string entity)
 	{
-		for (auto const c : entity) {
-			switch (c) {
-			case '<':
-				os << "&lt;";
-				break;
-			case '>':
-				os << "&gt;";
-				break;
-			case '&':
-				os << "&amp;";
-				break;
-			case '"':
-				os << "&quot;";
-				break;
-			default:
-				os << c;
-				break;
-			}
-		}
+		escape_html(os, entity);
 	}
 
 
@@ -22,13 +22,18 @@ namespace docscript
 	class cpp_to_html
 	{
 	public:
-		cpp_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param offset number of lines skipped before the input
+		 */
+		cpp_to_html(bool linenumbers, boost::uuids::uuid, std::size_t offset = 0);
 		void convert(std::ostream&, std::string const&);
+		void convert(std::ostream& os, char const* begin, char const* end);
 
 	private:
 
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 
 
 	private:
@@ -11,14 +11,25 @@
 #include <docscript/symbol.h>
 #include <docscript/parser.h>
 
+#include <iomanip>
+#include <sstream>
+
+#include <boost/uuid/uuid_io.hpp>
+
 namespace docscript
 {
-	docscript_to_html::docscript_to_html(bool linenumbers, boost::uuids::uuid tag)
+	docscript_to_html::docscript_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, offset_(offset)
 	{}
 
 	void docscript_to_html::convert(std::ostream& os, std::string const& inp)
+	{
+		convert(os, inp.data(), inp.data() + inp.size());
+	}
+
+	void docscript_to_html::convert(std::ostream& os, char const* start, char const* stop)
 	{
 		std::list<symbol>		stream;
 
@@ -50,9 +61,7 @@ namespace docscript
 		//
 		//	read input
 		//
-		auto const start = std::begin(inp);
-		auto const stop = std::end(inp);
-		san.read(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
+		san.read(boost::u8_to_u32_iterator<char const*>(start), boost::u8_to_u32_iterator<char const*>(stop));
 		san.flush(true);
 
 		//
@@ -69,7 +78,45 @@ namespace docscript
 		//	convert parse tree to html
 		//
 		auto const& ast  = p.get_ast();
-		ast.generate_html(os, linenumbers_);
+		if (!linenumbers_) {
+			ast.generate_html(os, false);
+			return;
+		}
+
+		//
+		//	prefix each line of the generated html with its number
+		//
+		std::ostringstream ss;
+		ast.generate_html(ss, false);
+		auto const html = ss.str();
+
+		std::size_t linenumber{ offset_ };
+		std::size_t pos{ 0 };
+		while (pos < html.size()) {
+			write_linenumber(os, ++linenumber);
+			auto const next = html.find('\n', pos);
+			if (next == std::string::npos) {
+				os.write(html.data() + pos, static_cast<std::streamsize>(html.size() - pos));
+				break;
+			}
+			os.write(html.data() + pos, static_cast<std::streamsize>(next + 1 - pos));
+			pos = next + 1;
+		}
+	}
+
+	void docscript_to_html::write_linenumber(std::ostream& os, std::size_t linenumber) const
+	{
+		os
+			<< "<span style = \"color: DarkCyan; font-size: smaller;\" id=\""
+			<< tag_
+			<< '-'
+			<< linenumber
+			<< "\">"
+			<< std::setw(4)
+			<< std::setfill(' ')
+			<< linenumber
+			<< "</span> "
+			;
 	}
 
 	void docscript_to_html::print_error(cyng::logging::severity level, std::string msg)
@@ -19,16 +19,22 @@ namespace docscript
 	class docscript_to_html
 	{
 	public:
-		docscript_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param offset number of lines skipped before the input
+		 */
+		docscript_to_html(bool linenumbers, boost::uuids::uuid, std::size_t offset = 0);
 		void convert(std::ostream&, std::string const&);
+		void convert(std::ostream& os, char const* begin, char const* end);
 
 	private:
 		void print_error(cyng::logging::severity level, std::string msg);
+		void write_linenumber(std::ostream&, std::size_t linenumber) const;
 
 	private:
 
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 	};
 
 }
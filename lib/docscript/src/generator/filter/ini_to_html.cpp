@@ -7,6 +7,7 @@
 
 #include "ini_to_html.h"
 #include <docscript/sanitizer.h>
+#include <docscript/generator/escape.h>
 
 #include <cctype>
 #include <iomanip>
@@ -15,17 +16,18 @@
 
 namespace docscript
 {
-	ini_to_html::ini_to_html(bool linenumbers, boost::uuids::uuid tag)
+	ini_to_html::ini_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, offset_(offset)
 	{}
 
 	void ini_to_html::convert(std::ostream& os, std::string const& inp)
 	{
-		convert(os, inp.begin(), inp.end());
+		convert(os, inp.data(), inp.data() + inp.size());
 	}
 
-	void ini_to_html::convert(std::ostream& os, std::string::const_iterator pos, std::string::const_iterator end)
+	void ini_to_html::convert(std::ostream& os, char const* pos, char const* end)
 	{
 
 		std::size_t linenumber{ 0 };
@@ -42,18 +44,6 @@ namespace docscript
 				break;
 			case '\r':
 				break;
-			case '<':
-				line.append("&lt;");
-				break;
-			case '>':
-				line.append("&gt;");
-				break;
-			case '"':
-				line.append("&quot;");
-				break;
-			case '&':
-				line.append("&amp;");
-				break;
 			case '#':
 				if (line.empty()) {
 					write_nl(++linenumber, os);
@@ -78,7 +68,12 @@ namespace docscript
 				line.append(end_);
 				break;
 			default:
-				line += *pos;
+				if (auto const entity = html_text_escape().get(*pos); entity.data() != nullptr) {
+					line.append(entity);
+				}
+				else {
+					line += *pos;
+				}
 				break;
 			}
 
@@ -92,62 +87,44 @@ namespace docscript
 
 	}
 
-	std::string::const_iterator ini_to_html::comment(std::ostream& os, std::string::const_iterator pos, std::string::const_iterator end)
+	char const* ini_to_html::comment(std::ostream& os, char const* pos, char const* end)
 	{
 		os
 			<< color_green_
 			;
 
-		while (pos != end) {
-			switch (*pos) {
-			case '\n':
-			case '\r':
-				os << end_;
-				return pos;
-			default:
-				os << *pos;
-				break;
-			}
-
-			//
-			//	next char
-			//
+		//
+		//	comment ends with the line
+		//
+		auto const start = pos;
+		while (pos != end && *pos != '\n' && *pos != '\r') {
 			++pos;
-
 		}
+		html_text_escape().write(os, std::string_view(start, pos - start));
+		os << end_;
 		return pos;
 	}
 
-	std::string::const_iterator ini_to_html::section(std::ostream& os, std::string::const_iterator pos, std::string::const_iterator end)
+	char const* ini_to_html::section(std::ostream& os, char const* pos, char const* end)
 	{
 		os
 			<< color_red_
 			<< '['
 			;
 
-		while (pos != end) {
-			switch (*pos) {
-			case '\n':
-			case '\r':
-				return pos;
-			case ']':
-				os 
-					<< end_
-					<< *pos
-					;
-				return ++pos;
-			default:
-				os << *pos;
-				break;
-			}
-
-			//
-			//	next char
-			//
+		auto const start = pos;
+		while (pos != end && *pos != '\n' && *pos != '\r' && *pos != ']') {
 			++pos;
-
 		}
+		html_text_escape().write(os, std::string_view(start, pos - start));
 
+		if (pos != end && *pos == ']') {
+			os 
+				<< end_
+				<< *pos
+				;
+			return ++pos;
+		}
 		return pos;
 	}
 
@@ -171,11 +148,11 @@ namespace docscript
 				<< "<span style = \"color: DarkCyan; font-size: smaller;\" id=\""
 				<< tag_
 				<< '-'
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "\">"
 				<< std::setw(4)
 				<< std::setfill(' ')
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "</span> "
 				;
 		}
@@ -183,25 +160,7 @@ namespace docscript
 
 	void ini_to_html::write_entity(std::ostream& os, std::string entity)
 	{
-		for (auto const c : entity) {
-			switch (c) {
-			case '<':
-				os << "&lt;";
-				break;
-			case '>':
-				os << "&gt;";
-				break;
-			case '&':
-				os << "&amp;";
-				break;
-			case '"':
-				os << "&quot;";
-				break;
-			default:
-				os << c;
-				break;
-			}
-		}
+		escape_html(os, entity);
 	}
 
 
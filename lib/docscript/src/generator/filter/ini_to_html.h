@@ -22,19 +22,23 @@ namespace docscript
 	class ini_to_html
 	{
 	public:
-		ini_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param offset number of lines skipped before the input
+		 */
+		ini_to_html(bool linenumbers, boost::uuids::uuid, std::size_t offset = 0);
 		void convert(std::ostream&, std::string const&);
+		void convert(std::ostream& os, char const* begin, char const* end);
 
 	private:
 
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 
 
 	private:
-		void convert(std::ostream& os, std::string::const_iterator begin, std::string::const_iterator end);
-		std::string::const_iterator comment(std::ostream& os, std::string::const_iterator begin, std::string::const_iterator end);
-		std::string::const_iterator section(std::ostream& os, std::string::const_iterator begin, std::string::const_iterator end);
+		char const* comment(std::ostream& os, char const* begin, char const* end);
+		char const* section(std::ostream& os, char const* begin, char const* end);
 
 		void print_error(cyng::logging::severity level, std::string msg);
 		void write_nl(std::size_t, std::ostream&);
@@ -6,6 +6,7 @@
  */
 
 #include "json_to_html.h"
+#include <docscript/generator/escape.h>
 
 #include <cyng/dom/tree_walker.h>
 #include <cyng/json.h>
@@ -26,10 +27,11 @@ namespace docscript
 	class json_walker : public cyng::tree_walker
 	{
 	public:
-		json_walker(std::ostream& os, bool linenumbers, boost::uuids::uuid tag)
+		json_walker(std::ostream& os, bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 			: os_(os)
 			, linenumbers_(linenumbers)
 			, tag_(tag)
+			, offset_(offset)
 			, line_(0)
 		{
 			if (linenumbers_) {
@@ -79,7 +81,9 @@ namespace docscript
 					<< indentation(depth)
 					<< "<span style = \"color: blue\">"
 					<< "&quot;"
-					<< ptr->first
+					;
+				escape_html(os_, ptr->first);
+				os_
 					<< "&quot;"
 					<< "</span>"
 					<< ':'
@@ -91,12 +95,14 @@ namespace docscript
 			case cyng::TC_STRING:
 				os_
 					<< "<span style = \"color: brown\">"
-					<< cyng::json::to_string(obj)
+					;
+				escape_html(os_, cyng::json::to_string(obj));
+				os_
 					<< "</span>"
 					;
 				break;
 			default:
-				os_ << cyng::json::to_string(obj);
+				escape_html(os_, cyng::json::to_string(obj));
 				break;
 			}
 			return true;	//	continue
@@ -168,11 +174,11 @@ namespace docscript
 					<< "<span style = \"color: DarkCyan; font-size: smaller;\" id=\""
 					<< tag_
 					<< '-'
-					<< line_
+					<< (offset_ + line_)
 					<< "\">"
 					<< std::setw(4)
 					<< std::setfill(' ')
-					<< line_
+					<< (offset_ + line_)
 					<< "</span> "
 					;
 			}
@@ -183,13 +189,15 @@ namespace docscript
 		std::ostream& os_;
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 		std::size_t line_;
 	};
 
 
-	json_to_html::json_to_html(bool linenumbers, boost::uuids::uuid tag)
+	json_to_html::json_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, offset_(offset)
 	{}
 
 
@@ -203,7 +211,7 @@ namespace docscript
 		//
 		//	walk over object tree and generate formatted JSON output
 		//
-		json_walker walker(os, linenumbers_, tag_);
+		json_walker walker(os, linenumbers_, tag_, offset_);
 		//os << "<code>";
 		traverse(obj, walker, 0);
 		os << "</code>";
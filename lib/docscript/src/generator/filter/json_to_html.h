@@ -19,12 +19,16 @@ namespace docscript
 	class json_to_html
 	{
 	public:
-		json_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param offset number of lines skipped before the input
+		 */
+		json_to_html(bool linenumbers, boost::uuids::uuid, std::size_t offset = 0);
 		void convert(std::ostream&, std::string const&);
 
 	private:
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 	};
 
 }
@@ -6,6 +6,7 @@
  */
 
 #include "sml_to_html.h"
+#include <docscript/generator/escape.h>
 #include <smf/sml/protocol/parser.h>
 #include <smf/sml/obis_db.h>
 
@@ -23,9 +24,10 @@
 
 namespace docscript	
 {
-	sml_to_html::sml_to_html(bool linenumbers, boost::uuids::uuid tag)
+	sml_to_html::sml_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t position)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, position_(position)
 	{}
 
 
@@ -60,15 +62,17 @@ namespace docscript
 					os
 						<< "<code title=\""
 						<< "["
-						<< cyng::io::to_str(vec.at(3))
+						;
+					escape_html_attribute(os, cyng::io::to_str(vec.at(3)));
+					os
 						<< "] \">";
 				}
 				else {
 					os
 						<< "<code title=\"@"
-						<< prev_pos
+						<< (position_ + prev_pos)
 						<< " => "
-						<< pos
+						<< (position_ + pos)
 						<< " = "
 						<< cyng::bytes_to_str(pos - prev_pos)
 						<< "\">";
@@ -96,11 +100,11 @@ namespace docscript
 							<< tag_
 							<< '-'
 							<< std::dec
-							<< prev_pos
+							<< (position_ + prev_pos)
 							<< "\">"
 							<< std::setw(4)
 							<< std::setfill(' ')
-							<< prev_pos
+							<< (position_ + prev_pos)
 							<< "</span> "
 							;
 					}
@@ -212,7 +216,9 @@ namespace docscript
 								os
 									<< cyng::io::to_str(vec.at(3))
 									<< " \"<span style=\"color: green\">"
-									<< cyng::io::to_ascii(octet)
+									;
+								escape_html(os, cyng::io::to_ascii(octet));
+								os
 									<< "</span>\""
 									;
 							}
@@ -20,7 +20,10 @@ namespace docscript
 	class sml_to_html
 	{
 	public:
-		sml_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param position number of bytes skipped before the input
+		 */
+		sml_to_html(bool linenumbers, boost::uuids::uuid, std::size_t position = 0);
 		void convert(std::ostream&, cyng::buffer_t const&);
 
 	private:
@@ -29,6 +32,7 @@ namespace docscript
 	private:
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const position_;
 	};
 
 }
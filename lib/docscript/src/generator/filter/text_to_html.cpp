@@ -6,53 +6,46 @@
  */
 
 #include "text_to_html.h"
+#include <docscript/generator/escape.h>
 #include <iomanip>
 #include <boost/uuid/uuid_io.hpp>
 
 namespace docscript
 {
-	text_to_html::text_to_html(bool linenumbers, boost::uuids::uuid tag)
+	text_to_html::text_to_html(bool linenumbers, boost::uuids::uuid tag, std::size_t offset)
 		: linenumbers_(linenumbers)
 		, tag_(tag)
+		, offset_(offset)
 	{}
 
 	void text_to_html::convert(std::ostream& os, std::string const& inp)
 	{
-		convert(os, inp.begin(), inp.end());
+		convert(os, inp.data(), inp.data() + inp.size());
 	}
 
-	void text_to_html::convert(std::ostream& os, std::string::const_iterator pos, std::string::const_iterator end)
+	void text_to_html::convert(std::ostream& os, char const* pos, char const* end)
 	{
+		static char_set const nl("\n");
+		static escape_table const entities({
+			{ '<', "&lt;" },
+			{ '>', "&gt;" },
+			{ '"', "&quot;" },
+			{ '&', "&amp;" },
+			{ '\r', "" } });
+
 		std::size_t linenumber{ 0 };
 		write_nl(linenumber++, os);
 		while (pos != end) {
-			switch (*pos) {
-			case '\n':
-				write_nl(++linenumber, os);
-				break;
-			case '\r':
-				break;
-			case '<':	
-				os << "&lt;";
-				break;
-			case '>':	
-				os << "&gt;";
-				break;
-			case '"':
-				os << "&quot;";
-				break;
-			case '&':
-				os << "&amp;";
-				break;
-			default:
-				os << *pos;
-				break;
-			}
 
 			//
-			//	next char
+			//	write line
 			//
-			++pos;
+			auto const next = nl.find(pos, end);
+			entities.write(os, std::string_view(pos, static_cast<std::size_t>(next - pos)));
+			if (next == end)	break;
+
+			write_nl(++linenumber, os);
+			pos = next + 1;
 		}
 	}
 
@@ -74,11 +67,11 @@ namespace docscript
 				<< "<span style = \"color: DarkCyan; font-size: smaller;\" id=\""
 				<< tag_
 				<< '-'
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "\">"
 				<< std::setw(4)
 				<< std::setfill(' ')
-				<< linenumber
+				<< (offset_ + linenumber)
 				<< "</span> "
 				;
 		}
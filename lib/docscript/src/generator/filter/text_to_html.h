@@ -19,17 +19,21 @@ namespace docscript
 	class text_to_html
 	{
 	public:
-		text_to_html(bool linenumbers, boost::uuids::uuid);
+		/**
+		 * @param offset number of lines skipped before the input
+		 */
+		text_to_html(bool linenumbers, boost::uuids::uuid, std::size_t offset = 0);
 		void convert(std::ostream&, std::string const&);
+		void convert(std::ostream& os, char const* begin, char const* end);
 
 	private:
-		void convert(std::ostream& os, std::string::const_iterator begin, std::string::const_iterator end);
 		void write_nl(std::size_t linenumber, std::ostream& os);
 
 	private:
 
 		bool const linenumbers_;
 		boost::uuids::uuid const tag_;
+		std::size_t const offset_;
 	};
 
 }	
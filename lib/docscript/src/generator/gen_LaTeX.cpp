@@ -6,6 +6,9 @@
  */ 
 
 #include <docscript/generator/gen_LaTeX.h>
+#include <docscript/generator/escape.h>
+#include <docscript/generator/source.h>
+#include <docscript/generator/table.h>
 #include "filter/binary_to_latex.h"
 
 #include <cyng/vm/generator.h>
@@ -13,19 +16,20 @@
 #include <cyng/value_cast.hpp>
 #include <cyng/numeric_cast.hpp>
 #include <cyng/dom/reader.h>
-#include <cyng/csv.h>
 #include <cyng/io/bom.h>
 #include <cyng/set_cast.h>
 
 #include <fstream>
+#include <algorithm>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <boost/uuid/nil_generator.hpp>
 
 namespace docscript
 {
-	gen_latex::gen_latex(std::vector< cyng::filesystem::path > const& inc)
-		: generator(inc)
+	gen_latex::gen_latex(std::vector< cyng::filesystem::path > const& inc, bool sync)
+		: generator(inc, sync)
 	{
 		register_this();
 	}
@@ -34,7 +38,10 @@ namespace docscript
 	{
 		generator::register_this();
 
-		vm_.register_function("demo", 0, std::bind(&gen_latex::demo, this, std::placeholders::_1));
+		register_function("demo", 0, std::bind(&gen_latex::demo, this, std::placeholders::_1));
+		register_function("lof", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_FIGURES, std::placeholders::_1));
+		register_function("lot", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_TABLES, std::placeholders::_1));
+		register_function("footnotes", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::FOOTNOTES, std::placeholders::_1));
 
 	}
 
@@ -47,7 +54,7 @@ namespace docscript
 		if (cyng::filesystem::is_directory(p)) {
 			p = p / "out.tex";
 		}
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -72,14 +79,14 @@ namespace docscript
 		}
 	}
 
-	std::ofstream& gen_latex::emit_file(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_latex::emit_file(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
 		emit_class(ofs);
 		emit_title(ofs);
 		return emit_document(ofs, pos, end);
 	}
 
-	std::ofstream& gen_latex::emit_class(std::ofstream& ofs) const
+	std::ostream& gen_latex::emit_class(std::ostream& ofs) const
 	{
 //		"og:type"
 		std::string const type = (is_report())
@@ -153,7 +160,7 @@ namespace docscript
 
 	}
 
-	std::ofstream& gen_latex::emit_title(std::ofstream& ofs) const
+	std::ostream& gen_latex::emit_title(std::ostream& ofs) const
 	{
 		auto const reader = cyng::make_reader(meta_);
 // 		std::cout << "META: " << cyng::io::to_str(meta_) << std::endl;
@@ -172,8 +179,22 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_latex::emit_document(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_latex::emit_document(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
+		//
+		//	lists of figures and tables are placed after the table
+		//	of contents if the document doesn't place them explicitly
+		//
+		auto const placed = [&](placeholder_kind kind) {
+			auto const tag = placeholders_.get(kind);
+			return std::any_of(pos, end, [&tag](cyng::object const& obj) {
+				return (obj.get_class().tag() == cyng::TC_UUID)
+					&& (cyng::value_cast(obj, boost::uuids::nil_uuid()) == tag);
+			});
+		};
+		bool const lof = placed(placeholder_kind::LIST_OF_FIGURES);
+		bool const lot = placed(placeholder_kind::LIST_OF_TABLES);
+
 		ofs
 			<< std::endl
 			<< "%\tdocument"
@@ -186,15 +207,28 @@ namespace docscript
 			<< std::endl
 			<< "\\tableofcontents"
 			<< std::endl
-			<< "\\listoffigures"
-			<< std::endl
-			<< "\\listoftables"
-			<< std::endl
-			<< std::endl
 			;
+		if (!lof) {
+			ofs
+				<< "\\listoffigures"
+				<< std::endl
+				;
+		}
+		if (!lot) {
+			ofs
+				<< "\\listoftables"
+				<< std::endl
+				;
+		}
+		ofs << std::endl;
 
 		while (pos != end) {
-			emit_document(ofs, *pos);
+			if (pos->get_class().tag() == cyng::TC_UUID) {
+				emit_intrinsic(ofs, cyng::value_cast(*pos, boost::uuids::nil_uuid()));
+			}
+			else {
+				emit_document(ofs, *pos);
+			}
 			++pos;
 		}
 
@@ -205,7 +239,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_latex::emit_document(std::ofstream& ofs, cyng::object obj) const
+	std::ostream& gen_latex::emit_document(std::ostream& ofs, cyng::object obj) const
 	{
 		ofs
 			<< cyng::io::to_str(obj)
@@ -214,6 +248,34 @@ namespace docscript
 		return ofs;
 	}
 
+	std::ostream& gen_latex::emit_intrinsic(std::ostream& ofs, boost::uuids::uuid tag) const
+	{
+		auto const* ph = placeholders_.find(tag);
+		if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_FIGURES) {
+			ofs << "\\listoffigures" << std::endl;
+		}
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_TABLES) {
+			ofs << "\\listoftables" << std::endl;
+		}
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::FOOTNOTES) {
+			//
+			//	LaTeX sets the footnotes at the bottom of each page
+			//
+		}
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::DEFERRED) {
+			emit_deferred(ofs, ph->param_);
+			ofs << std::endl;
+		}
+		else {
+			ofs
+				<< "***ERROR: unknown intrinsic: "
+				<< boost::uuids::to_string(tag)
+				<< std::endl
+				;
+		}
+		return ofs;
+	}
+
 	void gen_latex::generate_meta(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
@@ -237,7 +299,7 @@ namespace docscript
 
 		auto const str = cyng::value_cast<std::string>(frame.at(0), "");
 
-		ctx.push(cyng::make_object(replace_latex_entities(str)));
+		push_text(ctx, replace_latex_entities(str));
 	}
 
 	void gen_latex::print_symbol(cyng::context& ctx)
@@ -364,7 +426,7 @@ namespace docscript
 			<< "\\newpage"
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 
 	}
 	
@@ -396,7 +458,7 @@ namespace docscript
 			<< std::endl
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_latex::list(cyng::context& ctx)
@@ -434,7 +496,7 @@ namespace docscript
 			<< std::endl
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_latex::link(cyng::context& ctx)
@@ -455,7 +517,7 @@ namespace docscript
 			<< cyng::io::to_str(reader.get("text"))
 			<< '}'
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_latex::figure(cyng::context& ctx)
@@ -496,7 +558,7 @@ namespace docscript
 			<< build_end( "figure")
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_latex::gallery(cyng::context& ctx)
@@ -564,7 +626,7 @@ namespace docscript
 				<< build_end( "figure")
 				<< std::endl
 				;
-			ctx.push(cyng::make_object(ss.str()));
+			push_text(ctx, ss.str());
 		}
 		else {
 			std::cerr
@@ -590,60 +652,68 @@ namespace docscript
 		auto const p = resolve_path(source);
 		auto const language = cleanup_language(cyng::value_cast(reader.get("language"), get_extension(p)));
 
+		//
+		//	optional line range (1-based, inclusive) and size limit
+		//
+		excerpt const range{
+			cyng::numeric_cast<std::size_t>(reader.get("first"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("last"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("maxsize"), 0u)
+		};
+
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			std::ifstream  ifs(p.string());
-			if (is_language_supported(language)) {
+			push_deferred(ctx, [p, range, language, caption, line_numbers, tag = uuid_gen_()](std::ostream& os) {
 
-				//
-				//	use listings package
-				//
-				std::stringstream ss;
-				ss
-					<< build_cmd_alt("begin", "lstlisting", ("language=" + language + ", caption=" + caption + ", numbers=" + (line_numbers ? "left" : "none")))
-					<< std::endl
-					<< ifs.rdbuf()
-					<< std::endl
-					<< build_end( "lstlisting")
-					<< std::endl
-					;
-				ctx.push(cyng::make_object(ss.str()));
-			}
-			else {
-				
-				if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
-
-					std::stringstream ss;
-					// binary mode required
-					std::ifstream  ifs(p.string(), std::ios::binary);
-					ifs.unsetf(std::ios::skipws);
-// 					ss << "<pre class=\"docscript-pre-binary\">" << std::endl;
-					cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-					
-					binary_to_latex filter(line_numbers, uuid_gen_());
-					
-					ss << build_begin("verbatim") << std::endl;
-					filter.convert(ss, inp);
-					ss << build_end("verbatim");
-					ctx.push(cyng::make_object(ss.str()));
-				}
-				else {
+				source_file const src(p, range);
+				if (is_language_supported(language)) {
 
 					//
-					//	use verbatim
+					//	use listings package
 					//
-					std::stringstream ss;
-					ss
-						<< build_begin( "verbatim")
+					auto const first = (src.get_offset() != 0)
+						? (", firstnumber=" + std::to_string(src.get_offset() + 1))
+						: std::string()
+						;
+					os
+						<< build_cmd_alt("begin", "lstlisting", ("language=" + language + ", caption=" + caption + ", numbers=" + (line_numbers ? "left" : "none") + first))
 						<< std::endl
-						<< ifs.rdbuf()
+						;
+					os.write(src.begin(), static_cast<std::streamsize>(src.size()));
+					os
 						<< std::endl
-						<< build_end( "verbatim")
+						<< build_end( "lstlisting")
 						<< std::endl
 						;
-					ctx.push(cyng::make_object(ss.str()));
 				}
-			}
+				else {
+				
+					if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
+
+						binary_to_latex filter(line_numbers, tag);
+					
+						os << build_begin("verbatim") << std::endl;
+						filter.convert(os, src.begin(), src.end());
+						os << build_end("verbatim");
+					}
+					else {
+
+						//
+						//	use verbatim
+						//
+						os
+							<< build_begin( "verbatim")
+							<< std::endl
+							;
+						os.write(src.begin(), static_cast<std::streamsize>(src.size()));
+						os
+							<< std::endl
+							<< build_end( "verbatim")
+							<< std::endl
+							;
+					}
+				}
+			});
 		}
 		else {
 			std::cerr
@@ -684,7 +754,7 @@ namespace docscript
 			<< build_end( "description")
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_latex::annotation(cyng::context& ctx)
@@ -698,9 +768,124 @@ namespace docscript
 			<< std::endl
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Table cells are single lines.
+	 */
+	escape_table const latex_cell_entities({
+		{ '&', "\\&" },
+		{ '%', "\\%" },
+		{ '$', "\\$" },
+		{ '#', "\\#" },
+		{ '_', "\\_" },
+		{ '{', "\\{" },
+		{ '}', "\\}" },
+		{ '\\', "\\textbackslash{}" },
+		{ '~', "\\textasciitilde{}" },
+		{ '^', "\\textasciicircum{}" },
+		{ '<', "\\textless{}" },
+		{ '>', "\\textgreater{}" },
+		{ '|', "\\textbar{}" },
+		{ '\n', " " },
+		{ '\r', "" } });
+
+	/**
+	 * Only visible in this compilation unit.
+	 * longtable repeats the header on each page. A new page starts
+	 * with a page break.
+	 */
+	class latex_table_writer : public table_writer
+	{
+	public:
+		latex_table_writer(std::ostream& os, std::string const& title, std::string const& tag, std::string const& notice)
+			: os_(os)
+			, title_(title)
+			, tag_(tag)
+			, notice_(notice)
+			, columns_(0)
+		{}
+
+		virtual void begin_page(std::size_t page, csv_row_t const& header) override
+		{
+			if (page == 0) {
+				columns_ = header.size();
+				os_
+					<< build_begin("longtable")
+					<< '{'
+					<< std::string(columns_ == 0 ? 1 : columns_, 'l')
+					<< '}'
+					<< std::endl
+					<< build_cmd("caption", title_)
+					<< std::endl
+					<< build_cmd("label", tag_)
+					<< " \\\\"
+					<< std::endl
+					;
+				row(header);
+				os_
+					<< "\\endfirsthead"
+					<< std::endl
+					;
+				row(header);
+				os_
+					<< "\\endhead"
+					<< std::endl
+					;
+			}
+			else {
+				os_
+					<< "\\pagebreak"
+					<< std::endl
+					;
+			}
+		}
+
+		virtual void row(csv_row_t const& row) override
+		{
+			bool initial{ true };
+			for (auto const& cell : row) {
+				if (initial) {
+					initial = false;
+				}
+				else {
+					os_ << " & ";
+				}
+				latex_cell_entities.write(os_, cell);
+			}
+			os_
+				<< " \\\\"
+				<< std::endl
+				;
+		}
+
+		virtual void end_page(std::size_t) override
+		{}
+
+		virtual void truncated(std::size_t rows) override
+		{
+			os_
+				<< "\\multicolumn{"
+				<< (columns_ == 0 ? 1 : columns_)
+				<< "}{l}{\\emph{"
+				<< notice_
+				<< ": "
+				<< rows
+				<< "}} \\\\"
+				<< std::endl
+				;
+		}
+
+	private:
+		std::ostream& os_;
+		std::string const title_;
+		std::string const tag_;
+		std::string const notice_;
+		std::size_t columns_;
+	};
+
 	void gen_latex::table(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
@@ -713,57 +898,33 @@ namespace docscript
 		auto const source = cyng::io::to_str(reader.get("source"));
 		auto const tag = cyng::value_cast(reader.get("tag"), source);
 
+		//
+		//	optional row limit and pagination
+		//
+		table_limits const limits{
+			cyng::numeric_cast<std::size_t>(reader.get("maxrows"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("pagesize"), 0u)
+		};
+
 		auto const p = resolve_path(source);
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			//auto table = html::table(html::class_("docscript-table"));
-			//table += html::caption(html::class_("docscript-table-caption"), title);
-
-			//
-			//	parse the CSV file into a vector
-			//
-			auto const csv = cyng::csv::read_file(p.string());
-
-			std::stringstream ss;
-			ss
-				<< build_begin("longtable")
-				<< std::endl
-				<< build_cmd("caption", title)
-				<< std::endl
-				<< build_cmd("label", tag)
-// 				<< build_cmd("label", "tbl:" + tag)
-				<< std::endl
-				<< "\\endfirsthead"
-				<< std::endl
-				<< "\\endhead"
-				<< std::endl
-				;
-
-			for (auto const& row : csv) {
-				//auto tr = html::tr(html::class_("docscript-tr"));
-				cyng::tuple_t tpl;
-				tpl = cyng::value_cast(row, tpl);
+			push_deferred(ctx, [p, title, tag, limits, notice = replace_latex_entities(get_name(i18n::WID_TABLE_TRUNCATED))](std::ostream& os) {
 
-				bool initial{ true };
-				for (auto const& cell : tpl) {
-					if (initial) {
-						initial = false;
-					}
-					else {
-						ss << " & ";
-					}
-					ss << cyng::io::to_str(cell);
+				latex_table_writer writer(os, title, tag, notice);
+				if (render_csv(p, limits, writer)) {
+					os
+						<< build_end( "longtable")
+						<< std::endl;
 				}
-				ss 
-					<< " \\\\"
-					<< std::endl;
-			}
-
-			ss
-				<< build_end( "longtable")
-				<< std::endl;
-
-			ctx.push(cyng::make_object(ss.str()));
+				else {
+					std::cerr
+						<< "***error cannot read CSV file ["
+						<< p
+						<< "]"
+						<< std::endl;
+				}
+			});
 		}
 		else {
 
@@ -1049,206 +1210,38 @@ namespace docscript
 		return build_cmd(cmd, param) + "[" + attr + "]";
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Typographic replacements ("<=", "->") and LaTeX special characters
+	 */
+	escape_table const latex_entities({
+		{ '<', "\\textless\\ " },
+		{ '>', "\\textgreater\\ " },
+		{ '\\', "\\\\" },
+		{ '_', "\\_" },
+		{ '#', "\\#" },
+		{ '%', "\\%" },
+		{ '$', "\\$" },
+		{ '{', "\\{" },
+		{ '}', "\\}" } }, {
+		{ '<', '=', "\\leq" },
+		{ '<', '-', "\\leftarrow\\ " },
+		{ '<', '<', "\\ll\\ " },
+		{ '>', '=', "$\\geq$" },
+		{ '>', '>', "\\gg\\ " },
+		{ '=', '>', "\\Rightarrow\\ " },
+		{ '=', '=', "\\equiv\\ " },
+		{ '-', '>', "\\rightarrow\\ " },
+		{ '!', '=', "\\neq\\ " },
+		{ ':', ':', "\\dblcolon\\ " },	//	not supported by LaTeX - mathtools required
+		{ ':', '=', "\\coloneq\\ " } });
+
 	std::string replace_latex_entities(std::string const& str)
 	{
-		//
-		//	escape 
-		//	\&     \$     \%     \#     \_    \{     \}
-		//
-		//replace_all(str, "&", "\\&");
-		//replace_all(str, "$", "\\$");
-		//replace_all(str, "%", "\\%");
-		//replace_all(str, "#", "\\#");
-		//replace_all(str, "_", "\\_");
-		//replace_all(str, "{", "\\{");
-		//replace_all(str, "}", "\\}");
-		//replace_all(str, "<", "\\textless");
-		//replace_all(str, ">", "\\textgreater");
-
-		//	simple state engine
-		enum {
-			STATE_DEFAULT,
-			STATE_LT,
-			STATE_GT,
-			STATE_EQ,
-			STATE_MINUS,
-			STATE_EXCL,	//!<	"!"
-			STATE_COL,	//!<	":"
-		} state = STATE_DEFAULT;
-
-		std::string r;
-
-		//	small optimization
-		r.reserve(str.length());
-
-		for (auto const c : str) {
-			switch (state) {
-
-			case STATE_LT:
-				switch (c) {
-				case '=':	//	<=
-					r.append("\\leq");
-					break;
-				case '-':	//	<-
-					r.append("\\leftarrow\\ ");
-					break;
-				case '<':	//	<<
-					r.append("\\ll\\ ");
-					break;
-				default:
-					r.append("\\textless\\ ");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_GT:
-				switch (c) {
-				case '=':	//	>=
-					r.append("$\\geq$");
-					break;
-				case '>':	//	>>
-					r.append("\\gg\\ ");
-					break;
-				default:
-					r.append("\\textgreater\\ ");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EQ:
-				switch (c) {
-				case '>':	//	=>
-					r.append("\\Rightarrow\\ ");
-					break;
-				case '=':	//	==
-					r.append("\\equiv\\ ");
-					break;
-				default:
-					r += '=';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_MINUS:
-				switch (c) {
-				case '>':	//	->
-					r.append("\\rightarrow\\ ");
-					break;
-				default:
-					r += '-';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EXCL:
-				switch (c) {
-				case '=':	//	!=
-					r.append("\\neq\\ ");
-					break;
-				default:
-					r += '!';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_COL:
-				switch (c) {
-				case ':':	//"::" not supported by LaTeX - mathtools required
-					r.append("\\dblcolon\\ ");
-					break;
-				case '=':	//	:=
-					r.append("\\coloneq\\ ");
-					break;
-				default:
-					r += ':';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			default:
-				switch (c) {
-				case '<':
-					state = STATE_LT;
-					break;
-				case '>':
-					state = STATE_GT;
-					break;
-				case '=':
-					state = STATE_EQ;
-					break;
-				case '-':
-					state = STATE_MINUS;
-					break;
-				case '!':
-					state = STATE_EXCL;
-					break;
-				case ':':
-					state = STATE_COL;
-					break;
-				case '\\':
-					r.append("\\\\");
-					break;
-				case '_':
-					r.append("\\_");
-					break;
-				case '#':
-					r.append("\\#");
-					break;
-				case '%':
-					r.append("\\%");
-					break;
-				case '$':
-					r.append("\\$");
-					break;
-				case '{':
-					r.append("\\{");
-					break;
-				case '}':
-					r.append("\\}");
-					break;
-				//case '[':
-				//	r.append("\\[");
-				//	break;
-				//case ']':
-				//	r.append("\\]");
-				//	break;
-				default:
-					r += c;
-					break;
-				}
-				break;
-			}
-		}
-
-		switch (state) {
-
-		case STATE_LT:		r += "\\textless\\ ";	break;
-		case STATE_GT:		r += "\\textgreater\\ ";	break;
-		case STATE_EQ:		r += '=';	break;
-		case STATE_MINUS:	r += '-';	break;
-		case STATE_EXCL:	r += '!';	break;
-		case STATE_COL:		r += ':';	break;
-		default:
-			break;
-		}
-
+		auto const r = latex_entities(str);
 		auto start = std::begin(r);
 		auto stop = std::end(r);
 		return replace_unicode(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
-//		return r;
-
 	}
 
 	std::string replace_unicode(boost::u8_to_u32_iterator<std::string::const_iterator> pos, boost::u8_to_u32_iterator<std::string::const_iterator> end)
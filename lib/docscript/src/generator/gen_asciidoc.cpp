@@ -6,6 +6,9 @@
  */ 
 
 #include <docscript/generator/gen_asciidoc.h>
+#include <docscript/generator/escape.h>
+#include <docscript/generator/source.h>
+#include <docscript/generator/table.h>
 //#include "filter/binary_to_asciidoc.h"
 
 #include <cyng/vm/generator.h>
@@ -13,7 +16,6 @@
 #include <cyng/value_cast.hpp>
 #include <cyng/numeric_cast.hpp>
 #include <cyng/dom/reader.h>
-#include <cyng/csv.h>
 #include <cyng/io/bom.h>
 #include <cyng/set_cast.h>
 
@@ -25,8 +27,8 @@
 
 namespace docscript
 {
-	gen_asciidoc::gen_asciidoc(std::vector< cyng::filesystem::path > const& inc)
-		: generator(inc)
+	gen_asciidoc::gen_asciidoc(std::vector< cyng::filesystem::path > const& inc, bool sync)
+		: generator(inc, sync)
 	{
 		register_this();
 	}
@@ -35,7 +37,7 @@ namespace docscript
 	{
 		generator::register_this();
 
-		vm_.register_function("demo", 0, std::bind(&gen_asciidoc::demo, this, std::placeholders::_1));
+		register_function("demo", 0, std::bind(&gen_asciidoc::demo, this, std::placeholders::_1));
 
 
 	}
@@ -49,7 +51,7 @@ namespace docscript
 		if (cyng::filesystem::is_directory(p)) {
 			p = p / "out.asciidoc";
 		}
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -74,7 +76,7 @@ namespace docscript
 		}
 	}
 
-	std::ofstream& gen_asciidoc::emit_file(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_asciidoc::emit_file(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
 		ofs
 			<< ":pdf-page-size: A4"
@@ -83,13 +85,18 @@ namespace docscript
 			;
 		emit_meta(ofs);
 		while (pos != end) {
-			emit_obj(ofs, *pos);
+			if (pos->get_class().tag() == cyng::TC_UUID) {
+				emit_intrinsic(ofs, cyng::value_cast(*pos, boost::uuids::nil_uuid()));
+			}
+			else {
+				emit_obj(ofs, *pos);
+			}
 			++pos;
 		}
 		return ofs;
 	}
 
-	std::ofstream& gen_asciidoc::emit_obj(std::ofstream& ofs, cyng::object obj) const
+	std::ostream& gen_asciidoc::emit_obj(std::ostream& ofs, cyng::object obj) const
 	{
 		ofs
 			<< cyng::io::to_str(obj)
@@ -98,7 +105,24 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_asciidoc::emit_meta(std::ofstream& ofs) const
+	std::ostream& gen_asciidoc::emit_intrinsic(std::ostream& ofs, boost::uuids::uuid tag) const
+	{
+		auto const* ph = placeholders_.find(tag);
+		if (ph != nullptr && ph->kind_ == placeholder_kind::DEFERRED) {
+			emit_deferred(ofs, ph->param_);
+			ofs << std::endl;
+		}
+		else {
+			ofs
+				<< "***ERROR: unknown intrinsic: "
+				<< boost::uuids::to_string(tag)
+				<< std::endl
+				;
+		}
+		return ofs;
+	}
+
+	std::ostream& gen_asciidoc::emit_meta(std::ostream& ofs) const
 	{
 		//	meta data nor supported by github
 		for (auto const& e : meta_) {
@@ -121,7 +145,7 @@ namespace docscript
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 
 		auto const p = cyng::value_cast(frame.at(0), cyng::filesystem::path());
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -172,7 +196,7 @@ namespace docscript
 		//	. dot
 		//	! exclamation mark
 		//
-		ctx.push(cyng::make_object(replace_asciidoc_entities(str)));
+		push_text(ctx, replace_asciidoc_entities(str));
 	}
 
 	void gen_asciidoc::print_symbol(cyng::context& ctx)
@@ -300,7 +324,7 @@ namespace docscript
 			<< text
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 		
 	}
 	
@@ -346,7 +370,7 @@ namespace docscript
 				<< std::endl;
 		}
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::link(cyng::context& ctx)
@@ -368,7 +392,7 @@ namespace docscript
 			<< text
 			<< "]"
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::figure(cyng::context& ctx)
@@ -405,7 +429,7 @@ namespace docscript
 			<< "]"
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::gallery(cyng::context& ctx)
@@ -427,43 +451,50 @@ namespace docscript
 		auto const p = resolve_path(source);
 		auto const language = cyng::value_cast(reader.get("language"), get_extension(p));
 
+		//
+		//	optional line range (1-based, inclusive) and size limit
+		//
+		excerpt const range{
+			cyng::numeric_cast<std::size_t>(reader.get("first"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("last"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("maxsize"), 0u)
+		};
+
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			std::stringstream ss;
-			if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				//binary_to_asciidoc filter(line_numbers, uuid_gen_());
-				//filter.convert(ss, inp);
-			}
-			else {
-				//	.CAPTION
-				//	[source,LANGUAGE]
-				//	----
-				//	CODE
-				//	----
-				//
-				std::ifstream  ifs(p.string());
-				ss
-					<< std::endl
-					<< "."
-					<< caption
-					<< std::endl
-					<< "[source,"
-					<< language
-					<< "]"
-					<< std::endl
-					<< std::string(4, '-')
-					<< std::endl
-					<< ifs.rdbuf()
-					<< std::endl
-					<< std::string(4, '-')
-					<< std::endl
-					;
-			}
-			ctx.push(cyng::make_object(ss.str()));
+			push_deferred(ctx, [p, range, language, caption](std::ostream& os) {
+				source_file const src(p, range);
+				if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
+					//binary_to_asciidoc filter(line_numbers, uuid_gen_());
+					//filter.convert(os, inp);
+				}
+				else {
+					//	.CAPTION
+					//	[source,LANGUAGE]
+					//	----
+					//	CODE
+					//	----
+					//
+					os
+						<< std::endl
+						<< "."
+						<< caption
+						<< std::endl
+						<< "[source,"
+						<< language
+						<< "]"
+						<< std::endl
+						<< std::string(4, '-')
+						<< std::endl
+						;
+					os.write(src.begin(), static_cast<std::streamsize>(src.size()));
+					os
+						<< std::endl
+						<< std::string(4, '-')
+						<< std::endl
+						;
+				}
+			});
 
 		}
 		else {
@@ -507,7 +538,7 @@ namespace docscript
 				;
 		}
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::annotation(cyng::context& ctx)
@@ -524,9 +555,88 @@ namespace docscript
 			<< std::endl
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Each page is a separate table block in CSV format.
+	 */
+	class asciidoc_table_writer : public table_writer
+	{
+	public:
+		asciidoc_table_writer(std::ostream& os, std::string const& notice)
+			: os_(os)
+			, notice_(notice)
+		{}
+
+		virtual void begin_page(std::size_t, csv_row_t const& header) override
+		{
+			os_
+				<< std::endl
+				<< "[%header,format=csv]"
+				<< std::endl
+				<< "|==="
+				<< std::endl
+				;
+			row(header);
+		}
+
+		virtual void row(csv_row_t const& row) override
+		{
+			bool initial{ true };
+			for (auto const& cell : row) {
+				if (initial) {
+					initial = false;
+				}
+				else {
+					os_ << ',';
+				}
+
+				//
+				//	quote cells with separators, quotes and line breaks
+				//
+				if (cell.find_first_of(",\"\r\n") == std::string::npos) {
+					os_ << cell;
+				}
+				else {
+					os_ << '"';
+					for (auto const c : cell) {
+						if (c == '"')	os_ << '"';
+						os_.put(c);
+					}
+					os_ << '"';
+				}
+			}
+			os_ << std::endl;
+		}
+
+		virtual void end_page(std::size_t) override
+		{
+			os_ 
+				<< "|==="
+				<< std::endl
+				;
+		}
+
+		virtual void truncated(std::size_t rows) override
+		{
+			os_
+				<< std::endl
+				<< '_'
+				<< notice_
+				<< ": "
+				<< rows
+				<< '_'
+				<< std::endl
+				;
+		}
+
+	private:
+		std::ostream& os_;
+		std::string const notice_;
+	};
+
 	void gen_asciidoc::table(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
@@ -539,41 +649,28 @@ namespace docscript
 		auto const tag = name_gen_(cyng::value_cast(reader.get("tag"), source));
 		auto const id = boost::uuids::to_string(tag);
 
+		//
+		//	optional row limit and pagination
+		//
+		table_limits const limits{
+			cyng::numeric_cast<std::size_t>(reader.get("maxrows"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("pagesize"), 0u)
+		};
+
 		auto const p = resolve_path(source);
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			//
-			//	parse the CSV file into a vector
-			//
-			auto const csv = cyng::csv::read_file(p.string());
-			std::stringstream ss;
-			ss 
-				<< std::endl
-				<< "[%header,format=csv]"
-				<< std::endl
-				<< "|==="
-				<< std::endl
-				;
-
+			push_deferred(ctx, [p, limits, notice = get_name(i18n::WID_TABLE_TRUNCATED)](std::ostream& os) {
 
-			for (auto const& row : csv) {
-				auto const tpl = cyng::to_tuple(row);
-
-				bool initial{ true };
-				for (auto const& cell : tpl) {
-					if (initial) {
-						ss << ',';
-					}
-					else {
-						initial = true;
-					}
-					ss << cyng::io::to_str(cell);
+				asciidoc_table_writer writer(os, notice);
+				if (!render_csv(p, limits, writer)) {
+					std::cerr
+						<< "***error cannot read CSV file ["
+						<< p
+						<< "]"
+						<< std::endl;
 				}
-				ss << std::endl;
-			}
-			ss << "|===";
-
-			ctx.push(cyng::make_object(ss.str()));
+			});
 		}
 		else {
 
@@ -622,7 +719,7 @@ namespace docscript
 	{
 		auto const frame = ctx.get_frame();
 		std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		ctx.push(cyng::make_object(cyng::io::to_str(frame)));
+		push_text(ctx, cyng::io::to_str(frame));
 	}
 
 	void gen_asciidoc::make_tok(cyng::context& ctx)
@@ -642,7 +739,7 @@ namespace docscript
 			<< level 
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::format_italic(cyng::context& ctx)
@@ -737,7 +834,7 @@ namespace docscript
 			<< title
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::section(int level, cyng::context& ctx)
@@ -766,7 +863,7 @@ namespace docscript
 			<< title
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::make_footnote(cyng::context& ctx)
@@ -788,7 +885,7 @@ namespace docscript
 			<< ']'
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_asciidoc::demo(cyng::context& ctx)
@@ -803,6 +900,33 @@ namespace docscript
 		ctx.push(cyng::make_object("DEMO"));
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Typographic replacements ("<=", "->") and escaped special characters
+	 */
+	escape_table const asciidoc_entities({
+		{ '<', "\\<" },
+		{ '>', "\\>" },
+		{ '!', "\\!" },
+		{ '\\', "\\\\" },
+		{ '`', "\\`" },
+		{ '*', "\\*" },
+		{ '{', "\\{" },
+		{ '}', "\\}" },
+		{ '[', "\\[" },
+		{ ']', "\\]" } }, {
+		{ '<', '=', "&#8804;" },
+		{ '<', '-', "&#10229;" },
+		{ '<', '<', "&#8810;" },
+		{ '>', '=', "&#8805;" },
+		{ '>', '>', "&#8811;" },
+		{ '=', '>', "&#10233;" },
+		{ '=', '=', "&#8801;" },
+		{ '-', '>', "&#10230;" },
+		{ '!', '=', "&#8800;" },
+		{ ':', ':', "&#8759;" },
+		{ ':', '=', "&#8788;" } });
+
 	std::string replace_asciidoc_entities(std::string const& str)
 	{
 		//
@@ -820,181 +944,7 @@ namespace docscript
 		//	. dot
 		//	! exclamation mark
 		//
-
-		//	simple state engine
-		enum {
-			STATE_DEFAULT,
-			STATE_LT,
-			STATE_GT,
-			STATE_EQ,
-			STATE_MINUS,
-			STATE_EXCL,	//!<	"!"
-			STATE_COL,	//!<	":"
-		} state = STATE_DEFAULT;
-
-		std::string r;
-
-		//	small optimization
-		r.reserve(str.length());
-
-		for (auto const c : str) {
-			switch (state) {
-
-			case STATE_LT:
-				switch (c) {
-				case '=':	//	<=
-					r.append("&#8804;");
-					break;
-				case '-':	//	<-
-					r.append("&#10229;");
-					break;
-				case '<':	//	<<
-					r.append("&#8810;");
-					break;
-				default:
-					r += "\\>";
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_GT:
-				switch (c) {
-				case '=':	//	>=
-					r.append("&#8805;");
-					break;
-				case '>':	//	>>
-					r.append("&#8811;");
-					break;
-				default:
-					r.append("\\>");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EQ:
-				switch (c) {
-				case '>':	//	=>
-					r.append("&#10233;");
-					break;
-				case '=':	//	==
-					r.append("&#8801;");
-					break;
-				default:
-					r += '=';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_MINUS:
-				switch (c) {
-				case '>':	//	->
-					r.append("&#10230;");
-					break;
-				default:
-					r += '-';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EXCL:
-				switch (c) {
-				case '=':	//	!=
-					r.append("&#8800;");
-					break;
-				default:
-					r.append("\\!");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_COL:
-				switch (c) {
-				case ':':	//	::
-					r.append("&#8759;");
-					break;
-				case '=':	//	:=
-					r.append("&#8788;");
-					break;
-				default:
-					r += ':';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			default:
-				switch (c) {
-				case '<':
-					state = STATE_LT;
-					break;
-				case '>':
-					state = STATE_GT;
-					break;
-				case '=':
-					state = STATE_EQ;
-					break;
-				case '-':
-					state = STATE_MINUS;
-					break;
-				case '!':
-					state = STATE_EXCL;
-					break;
-				case ':':
-					state = STATE_COL;
-					break;
-				case '\\':
-					r.append("\\\\");
-					break;
-				case '`':
-					r.append("\\`");
-					break;
-				case '*':
-					r.append("\\*");
-					break;
-				case '{':
-					r.append("\\{");
-					break;
-				case '}':
-					r.append("\\}");
-					break;
-				case '[':
-					r.append("\\[");
-					break;
-				case ']':
-					r.append("\\]");
-					break;
-				default:
-					r += c;
-					break;
-				}
-				break;
-			}
-		}
-
-		switch (state) {
-
-		case STATE_LT:		r += '<';	break;
-		case STATE_GT:		r.append("\\>");	break;
-		case STATE_EQ:		r += '=';	break;
-		case STATE_MINUS:	r += '-';	break;
-		case STATE_EXCL:	r.append("\\!");	break;
-		case STATE_COL:		r += ':';	break;
-		default:
-			break;
-		}
-
-		return r;
+		return asciidoc_entities(str);
 	}
 
 }
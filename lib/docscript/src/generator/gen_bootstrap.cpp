@@ -7,6 +7,7 @@
 
 #include <docscript/generator/gen_bootstrap.h>
 #include <docscript/generator/gen_html.h>
+#include <docscript/generator/minify.h>
 #include "filter/json_to_html.h"
 #include "filter/cpp_to_html.h"
 #include "filter/docscript_to_html.h"
@@ -22,7 +23,6 @@
 #include <cyng/numeric_cast.hpp>
 #include <cyng/set_cast.h>
 #include <cyng/dom/reader.h>
-#include <cyng/csv.h>
 #include <cyng/io/bom.h>
 
 #include <crypto/hash/base64.h>
@@ -36,8 +36,8 @@
 
 namespace docscript
 {
-	gen_bootstrap::gen_bootstrap(std::vector< cyng::filesystem::path > const& inc)
-		: generator(inc)
+	gen_bootstrap::gen_bootstrap(std::vector< cyng::filesystem::path > const& inc, bool sync)
+		: generator(inc, sync)
 		, footnotes_()
 		, figures_()
 		, tables_()
@@ -45,12 +45,23 @@ namespace docscript
 		register_this();
 	}
 
+	void gen_bootstrap::reset()
+	{
+		generator::reset();
+		footnotes_.clear();
+		figures_.clear();
+		tables_.clear();
+	}
+
 	void gen_bootstrap::register_this()
 	{
 		generator::register_this();
 
-		vm_.register_function("demo", 0, std::bind(&gen_bootstrap::demo, this, std::placeholders::_1));
-		vm_.register_function("card", 0, std::bind(&gen_bootstrap::card_deck, this, std::placeholders::_1));
+		register_function("demo", 0, std::bind(&gen_bootstrap::demo, this, std::placeholders::_1));
+		register_function("card", 0, std::bind(&gen_bootstrap::card_deck, this, std::placeholders::_1));
+		register_function("lof", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_FIGURES, std::placeholders::_1));
+		register_function("lot", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_TABLES, std::placeholders::_1));
+		register_function("footnotes", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::FOOTNOTES, std::placeholders::_1));
 	}
 
 	void gen_bootstrap::generate_file(cyng::context& ctx)
@@ -62,7 +73,7 @@ namespace docscript
 		if (cyng::filesystem::is_directory(p)) {
 			p = p / "out.html";
 		}
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -73,6 +84,14 @@ namespace docscript
 		}
 		else
 		{
+			ofs.precompress(precompress_);
+
+			//
+			//	all labels are known now. The meta data are used
+			//	as attributes and in the index.
+			//
+			resolve_meta();
+
 			//
 			//	provide a slug if not defined yet.
 			//
@@ -82,16 +101,61 @@ namespace docscript
 			//
 			cyng::write(ofs, cyng::bom::UTF8);
 
+			//
+			//	all labels are known now
+			//
+			labels_.report_dangling();
+
 			//
 			//	write output file
 			//
 			auto pos = frame.begin();
 			auto end = frame.end();
-			emit_file(ofs, std::next(pos), end);
+			if (minify_) {
+				minify_stream mos(ofs);
+				emit_resolved(mos, std::next(pos), end);
+			}
+			else {
+				emit_resolved(ofs, std::next(pos), end);
+			}
 		}
 	}
 
-	std::ofstream& gen_bootstrap::emit_file(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_bootstrap::emit_resolved(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	{
+		if (!labels_.has_refs()) {
+			return emit_file(ofs, pos, end);
+		}
+
+		//
+		//	replace the reference markers in a single pass
+		//
+		label_stream los(ofs, [this](std::size_t idx) {
+			return resolve_ref(idx);
+		});
+		emit_file(los, pos, end);
+		return ofs;
+	}
+
+	std::string gen_bootstrap::resolve_ref(std::size_t idx) const
+	{
+		auto const* ref = labels_.get_ref(idx);
+		if (ref == nullptr)	return std::string();
+
+		auto const* lbl = labels_.find(ref->tag_);
+		if (lbl == nullptr) {
+			return make_reference(*ref, nullptr, std::string())(indent(0));
+		}
+
+		//
+		//	The title attribute cannot contain links. A caption
+		//	with references gets their plain text.
+		//
+		label const plain{ lbl->kind_, lbl->number_, resolve_plain(lbl->caption_) };
+		return make_reference(*ref, &plain, get_label_text(plain))(indent(0));
+	}
+
+	std::ostream& gen_bootstrap::emit_file(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
 		ofs
 			<< "\t<section class=\"container-fluid\" style=\"height:80vh\">"
@@ -106,11 +170,18 @@ namespace docscript
 	}
 
 
-	std::ofstream& gen_bootstrap::emit_body(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_bootstrap::emit_body(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
+		//
+		//	footnotes are emitted at the end of the document
+		//	if there is no placeholder
+		//
+		bool footnotes{ false };
 		while (pos != end) {
 			if (pos->get_class().tag() == cyng::TC_UUID) {
-				emit_intrinsic(ofs, cyng::value_cast(*pos, boost::uuids::nil_uuid()));
+				auto const tag = cyng::value_cast(*pos, boost::uuids::nil_uuid());
+				footnotes = footnotes || (tag == placeholders_.get(placeholder_kind::FOOTNOTES));
+				emit_intrinsic(ofs, tag);
 			}
 			else {
 				emit_body(ofs, *pos);
@@ -118,36 +189,45 @@ namespace docscript
 			++pos;
 		}
 
-		emit_footnotes(ofs);
+		if (!footnotes)	emit_footnotes(ofs);
 		return ofs;
 	}
 
-	std::ofstream& gen_bootstrap::emit_body(std::ofstream& ofs, cyng::object obj) const
+	std::ostream& gen_bootstrap::emit_body(std::ostream& ofs, cyng::object obj) const
 	{
-		ofs
-			<< cyng::io::to_str(obj)
-			<< std::endl
-			;
+		//
+		//	write strings without a copy
+		//
+		auto const* p = cyng::object_cast<std::string>(obj);
+		if (p != nullptr) {
+			ofs << *p;
+		}
+		else {
+			ofs << cyng::io::to_str(obj);
+		}
+		ofs << std::endl;
 		return ofs;
 	}
 
-	std::ofstream& gen_bootstrap::emit_intrinsic(std::ofstream& ofs, boost::uuids::uuid tag) const
+	std::ostream& gen_bootstrap::emit_intrinsic(std::ostream& ofs, boost::uuids::uuid tag) const
 	{
 
-		if (tag == name_gen_("[ToC]")) {
-			emit_toc(ofs, 5);
+		auto const* ph = placeholders_.find(tag);
+		if (ph != nullptr && ph->kind_ == placeholder_kind::TOC) {
+			emit_toc(ofs, ph->param_);
 		}
-		else if (tag == name_gen_("[ToC-1]")) {
-			emit_toc(ofs, 1);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_FIGURES) {
+			emit_list(ofs, figures_, get_name(i18n::WID_FIGURE), indent(0), std::bind(&generator::resolve_plain, this, std::placeholders::_1));
 		}
-		else if (tag == name_gen_("[ToC-2]")) {
-			emit_toc(ofs, 2);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_TABLES) {
+			emit_list(ofs, tables_, get_name(i18n::WID_TABLE), indent(0), std::bind(&generator::resolve_plain, this, std::placeholders::_1));
 		}
-		else if (tag == name_gen_("[ToC-3]")) {
-			emit_toc(ofs, 3);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::FOOTNOTES) {
+			emit_footnotes(ofs);
 		}
-		else if (tag == name_gen_("[ToC-4]")) {
-			emit_toc(ofs, 4);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::DEFERRED) {
+			emit_deferred(ofs, ph->param_);
+			ofs << std::endl;
 		}
 		else {
 			ofs
@@ -159,7 +239,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_bootstrap::emit_toc(std::ofstream& ofs, std::size_t depth) const
+	std::ostream& gen_bootstrap::emit_toc(std::ostream& ofs, std::size_t depth) const
 	{
 
 		ofs
@@ -171,7 +251,7 @@ namespace docscript
 			<< std::endl
 			;
 
-		auto const toc = serialize(content_table_);
+		auto const& toc = serialize(content_table_);
 
 		emit_toc(ofs, toc, 0, depth);
 
@@ -182,7 +262,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_bootstrap::emit_toc(std::ofstream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
+	std::ostream& gen_bootstrap::emit_toc(std::ostream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
 	{
 		ofs
 			<< std::string(level + 1, '\t')
@@ -196,7 +276,7 @@ namespace docscript
 		for (auto const& header : toc) {
 
 			auto const h = cyng::to_param_map(header);
-			auto const title = cyng::io::to_str(h.at("title"));
+			auto const title = resolve_plain(cyng::io::to_str(h.at("title")));
 			auto const number = cyng::io::to_str(h.at("number"));
 			auto const tag = cyng::value_cast(h.at("tag"), boost::uuids::nil_uuid());
 			auto const href = "#" + boost::uuids::to_string(tag);
@@ -209,7 +289,7 @@ namespace docscript
 				ofs
 					<< std::string(level + 1, '\t')
 					<< "<li>"
-					<< a(0)
+					<< a(indent(0))
 					<< std::endl
 					;
 
@@ -225,7 +305,7 @@ namespace docscript
 				ofs
 					<< std::string(level + 1, '\t')
 					<< "<li>"
-					<< a(0)
+					<< a(indent(0))
 					<< "</li>"
 					<< std::endl
 					;
@@ -242,7 +322,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_bootstrap::emit_footnotes(std::ofstream& ofs) const
+	std::ostream& gen_bootstrap::emit_footnotes(std::ostream& ofs) const
 	{
 		if (!footnotes_.empty()) {
 
@@ -250,7 +330,7 @@ namespace docscript
 			//	horizontal line
 			//
 			ofs 
-				<< dom::hr()(0)
+				<< dom::hr()(indent(0))
 				<< std::endl;
 
 			//
@@ -271,7 +351,7 @@ namespace docscript
 					;
 
 				ofs 
-					<< dom::p(dom::id_(note.get_tag()), dom::class_("docscript-footnote"), ss.str())(0)
+					<< dom::p(dom::id_(note.get_tag()), dom::class_("docscript-footnote"), ss.str())(indent(0))
 					<< std::endl;
 
 				ss.str("");
@@ -306,16 +386,22 @@ namespace docscript
 		//
 		//	escape HTML entities
 		//
-		ctx.push(cyng::make_object(replace_html_entities(str)));
+		push_text(ctx, replace_html_entities(str));
 	}
 
 	void gen_bootstrap::paragraph(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		std::string par = accumulate_plain_text(frame);
-		auto el = dom::p(par);
-		ctx.push(cyng::make_object(el(0)));
+
+		//
+		//	the segments are written directly into the output file
+		//
+		push_writer(ctx, [frame](std::ostream& os) {
+			rope r;
+			accumulate_plain_text(r, frame);
+			write_inline(os, "p", r);
+		});
 	}
 
 	void gen_bootstrap::abstract(cyng::context& ctx)
@@ -329,8 +415,7 @@ namespace docscript
 
 
 		// default state is: open
-		auto const el = dom::details(dom::open_(std::string()), dom::summary(title), dom::p(text));
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::details(dom::open_(std::string()), dom::summary(title), dom::p(text)), indent(0));
 	}
 	
 	void gen_bootstrap::quote(cyng::context& ctx)
@@ -354,8 +439,7 @@ namespace docscript
 		auto const cite = cyng::value_cast<std::string>(reader.get("url"), "");
 		auto const source = cyng::value_cast<std::string>(reader.get("source"), "");
 		auto const quote = accumulate_plain_text(reader.get("q"));
-		auto const el = dom::figure(dom::blockquote(dom::cite_(cite), dom::class_("docscript-quote"), quote), dom::figcaption(dom::cite(source)));
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::figure(dom::blockquote(dom::cite_(cite), dom::class_("docscript-quote"), quote), dom::figcaption(dom::cite(source))), indent(0));
 	}
 
 	void gen_bootstrap::list(cyng::context& ctx)
@@ -429,7 +513,7 @@ namespace docscript
 			el += dom::li(accumulate_plain_text(item));
 		}
 
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	void gen_bootstrap::link(cyng::context& ctx)
@@ -443,7 +527,7 @@ namespace docscript
 		auto const title = accumulate_plain_text(reader.get("title"));
 
 		auto const el = dom::a(dom::href_(url), dom::title_(title), text);
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	std::string gen_bootstrap::compute_fig_title(boost::uuids::uuid tag, std::string caption)
@@ -454,6 +538,7 @@ namespace docscript
 		figures_.emplace_back(tag, caption);
 
 		auto const idx = figures_.size();
+		labels_.add(tag, label_kind::FIGURE, std::to_string(idx), caption);
 
 		std::stringstream ss;
 		ss
@@ -475,6 +560,7 @@ namespace docscript
 		tables_.emplace_back(tag, caption);
 
 		auto const idx = tables_.size();
+		labels_.add(tag, label_kind::TABLE, std::to_string(idx), caption);
 
 		std::stringstream ss;
 		ss
@@ -521,15 +607,21 @@ namespace docscript
 			auto const title = compute_fig_title(tag, caption);
 
 			//
-			//	generate <figure> tag
+			//	generate <figure> tag. Caption and alt text are
+			//	used as attributes and cannot contain links.
 			//
-			auto const el = make_figure(p
-				, id
-				, width
-				, caption
-				, title
-				, alt);
-			ctx.push(cyng::make_object(el(0)));
+			push_deferred(ctx, [p, id, width, caption = resolve_plain(caption), title, alt = resolve_plain(alt), cache = cache_, assets = assets_, lazy = is_lazy_image(), d = indent(0)](std::ostream& os) {
+				auto const el = make_figure(p
+					, id
+					, width
+					, caption
+					, title
+					, alt
+					, cache
+					, assets
+					, lazy);
+				el.write(os, d);
+			});
 
 		}
 		else {
@@ -540,8 +632,8 @@ namespace docscript
 				<< "]"
 				<< std::endl;
 
-			auto const el = dom::h2(dom::id_(id), "cannot open file [" + source + "]", dom::title_(caption));
-			ctx.push(cyng::make_object(el(0)));
+			auto const el = dom::h2(dom::id_(id), "cannot open file [" + source + "]", dom::title_(resolve_plain(caption)));
+			push_text(ctx, el(indent(0)));
 		}
 	}
 
@@ -565,9 +657,6 @@ namespace docscript
 
 		auto const size = cyng::numeric_cast<std::size_t>(reader.get("size"), vec.size());
 
-		auto div = dom::div(dom::id_(id));
-		div += dom::h4(caption);
-
 		if (!vec.empty()) {
 
 			//"grid-template-columns: repeat(N, 1fr)"
@@ -582,8 +671,11 @@ namespace docscript
 			}
 			ss << ", 1fr)";
 
-			auto grid = dom::div(dom::class_("gallery"), dom::style_(ss.str()));
-
+			//
+			//	figure titles are numbered here, the images
+			//	are rendered on a worker thread
+			//
+			std::vector<std::function<dom::element()>> figures;
 			for (auto pos = 0u; pos < vec.size(); ++pos) {
 				auto const alt = accumulate_plain_text(reader["images"][pos].get("alt"));
 				auto const caption = accumulate_plain_text(reader["images"][pos].get("caption"));
@@ -597,14 +689,17 @@ namespace docscript
 				auto const p = resolve_path(source);
 				if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-					auto el = make_figure(p
-						, id
-						, width
-						, caption
-						, compute_fig_title(tag, caption)
-						, alt);
-
-					grid += std::move(el);
+					figures.push_back([p, id, width, caption = resolve_plain(caption), title = compute_fig_title(tag, caption), alt = resolve_plain(alt), cache = cache_, assets = assets_, lazy = is_lazy_image()]() {
+						return make_figure(p
+							, id
+							, width
+							, caption
+							, title
+							, alt
+							, cache
+							, assets
+							, lazy);
+					});
 				}
 				else {
 
@@ -617,12 +712,22 @@ namespace docscript
 				}
 			}
 
-			//
-			//	ToDo: improve CSS
-			//
-			div += std::move(grid);
+			push_deferred(ctx, [id, caption, style = ss.str(), figures, d = indent(0)](std::ostream& os) {
+
+				auto div = dom::div(dom::id_(id));
+				div += dom::h4(caption);
+
+				auto grid = dom::div(dom::class_("gallery"), dom::style_(style));
+				for (auto const& make : figures) {
+					grid += make();
+				}
 
-			ctx.push(cyng::make_object(div(0)));
+				//
+				//	ToDo: improve CSS
+				//
+				div += std::move(grid);
+				div.write(os, d);
+			});
 		}
 		else {
 			std::cerr
@@ -646,129 +751,36 @@ namespace docscript
 		auto const p = resolve_path(source);
 		auto const language = cyng::value_cast(reader.get("language"), get_extension(p));
 
-		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
-
-			std::stringstream ss;
-			ss 
-				<< "<figure>"
-				<< std::endl
-				<< "\t<figcaption>"
-				<< caption
-				<< "</figcaption>"
-				<< std::endl
-				;
-			if (boost::algorithm::iequals(language, "json")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-json\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				json_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</pre>" << std::endl;
-
-			}
-			else if (boost::algorithm::equals(language, "C++") || boost::algorithm::iequals(language, "cpp") || boost::algorithm::iequals(language, "h")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				cpp_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::iequals(language, "docscript")) {
+		//
+		//	optional line range (1-based, inclusive) and size limit
+		//
+		excerpt const range{
+			cyng::numeric_cast<std::size_t>(reader.get("first"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("last"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("maxsize"), 0u)
+		};
 
-				std::ifstream  ifs(p.string());
-				ss 
-					<< "<pre class=\"docscript-pre\" title=\""
-					<< caption
-					<< "\"><code contenteditable spellcheck=\"false\">"
-					;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				docscript_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << std::endl << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "txt") || boost::algorithm::iequals(language, "text") || boost::algorithm::iequals(language, "verbatim")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-txt\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				text_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
-
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				ss << "<pre class=\"docscript-pre-binary\">" << std::endl;
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				binary_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "html") || boost::algorithm::iequals(language, "htm")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-html\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				html_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "sml")) {
-
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				ss << "<pre class=\"docscript-pre-binary\">" << std::endl;
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				try {
-					sml_to_html filter(line_numbers, uuid_gen_());
-					filter.convert(ss, inp);
-				}
-				catch (std::exception const& ex) {
+		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-					ss
-						<< "***error: converting SML file "
-						<< p
-						<< " to html failed with error: "
-						<< ex.what()
-						<< std::endl;
-				}
-				ss 
-					<< "</code></pre>" 
-					<< std::endl;
-			}
-			else if (boost::algorithm::equals(language, "ini") || boost::algorithm::iequals(language, "service") || boost::algorithm::iequals(language, "cfg")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				ini_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else {
-				std::ifstream  ifs(p.string());
-				ss
-					<< "<pre><code>"
+			//
+			//	The tag is stable across runs, so unchanged code
+			//	is taken from the cache.
+			//
+			push_deferred(ctx, [p, range, language, caption, plain = resolve_plain(caption), line_numbers, tag = make_stable_tag(p.string()), cache = cache_](std::ostream& os) {
+				os 
+					<< "<figure>"
 					<< std::endl
-					<< ifs.rdbuf()
+					<< "\t<figcaption>"
+					<< caption
+					<< "</figcaption>"
 					<< std::endl
-					<< "</code></pre>"
+					;
+				render_code(os, p, range, language, plain, line_numbers, tag, cache);
+				os
+					<< "</figure>"
 					<< std::endl
 					;
-			}
-
-			ss 
-				<< "</figure>"
-				<< std::endl
-				;
-
-			ctx.push(cyng::make_object(ss.str()));
+			});
 		}
 		else {
 
@@ -778,7 +790,7 @@ namespace docscript
 				<< "] does not exist or is not a regular file"
 				<< std::endl;
 				auto const el = dom::strong(source);
-				ctx.push(cyng::make_object(el(0)));
+				push_text(ctx, el(indent(0)));
 
 		}
 	}
@@ -799,9 +811,9 @@ namespace docscript
 		defs = cyng::value_cast(frame.at(0), defs);
 		for (auto const& def : defs) {
 			ss
-				<< dom::dt(def.first)(0)
+				<< dom::dt(def.first)(indent(0))
 				<< '\t'
-				<< dom::dd(accumulate_plain_text(def.second))(0)
+				<< dom::dd(accumulate_plain_text(def.second))(indent(0))
 				<< std::endl
 				;
 		}
@@ -810,14 +822,17 @@ namespace docscript
 			<< "</dl>"
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_bootstrap::annotation(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto const el = dom::aside(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_writer(ctx, [frame](std::ostream& os) {
+			rope r;
+			accumulate_plain_text(r, frame);
+			write_inline(os, "aside", r);
+		});
 	}
 
 	void gen_bootstrap::table(cyng::context& ctx)
@@ -830,6 +845,14 @@ namespace docscript
 		auto const source = cyng::io::to_str(reader.get("source"));
 		auto const tag = name_gen_(cyng::value_cast(reader.get("tag"), source));
 
+		//
+		//	optional row limit and pagination
+		//
+		table_limits const limits{
+			cyng::numeric_cast<std::size_t>(reader.get("maxrows"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("pagesize"), 0u)
+		};
+
 		auto const p = resolve_path(source);
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
@@ -838,44 +861,14 @@ namespace docscript
 			//
 			//tables_.emplace_back(tag, title);
 			auto const caption = compute_tbl_title(tag, title);
-
 			auto const id = boost::uuids::to_string(tag);
-			auto table = dom::table(dom::id_(id), dom::class_("docscript-table"));
-			table += dom::caption(dom::class_("docscript-table-caption"), caption);
 
 			//
-			//	parse the CSV file into a vector
+			//	stream the CSV file directly into the output
 			//
-			auto const csv = cyng::csv::read_file(p.string());
-
-			bool initial{ true };
-			auto head = dom::thead(dom::class_("docscript-table-head"));
-			auto body = dom::tbody(dom::class_("docscript-table-body"));
-			for (auto const& row : csv) {
-
-				auto tr = dom::tr(dom::class_("docscript-tr"));
-				cyng::tuple_t tpl;
-				tpl = cyng::value_cast(row, tpl);
-				for (auto const& cell : tpl) {
-					auto td = (initial) 
-						? dom::th(dom::class_("docscript-th"), cyng::io::to_str(cell))
-						: dom::td(dom::class_("docscript-td"), cyng::io::to_str(cell))
-						;
-					tr += std::move(td);
-				}
-
-				if (initial) {
-					initial = false;
-					head += std::move(tr);
-				}
-				else {
-					body += std::move(tr);
-				}
-			}
-
-			table += std::move(head);
-			table += std::move(body);
-			ctx.push(cyng::make_object(table(0)));
+			push_deferred(ctx, [p, id, caption, limits, notice = get_name(i18n::WID_TABLE_TRUNCATED)](std::ostream& os) {
+				render_table(os, p, id, caption, limits, notice);
+			});
 		}
 		else {
 
@@ -907,31 +900,26 @@ namespace docscript
 
 				//std::string const svg = icon_info_;
 				//	 &#xFE0F; ℹ 
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_info_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_info_), dom::li(msg)), indent(0));
 			}
 			else if (boost::algorithm::equals(type, "CAUTION")) {
 
 				//	&#10071; ❗
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_caution_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_caution_), dom::li(msg)), indent(0));
 			}
 			else if (boost::algorithm::equals(type, "WARNING")) {
 
 				//	&#9888; ⚠️
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_warning_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_warning_), dom::li(msg)), indent(0));
 			}
 			else {
 
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(type), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(type), dom::li(msg)), indent(0));
 			}
 		}
 		else {
 
-			auto const div = dom::div(dom::p("***ERROR: alert definition"));
-			ctx.push(cyng::make_object(div(0)));
+			push_element(ctx, dom::div(dom::p("***ERROR: alert definition")), indent(0));
 
 		}
 	}
@@ -942,19 +930,14 @@ namespace docscript
 //  		std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 		
 		auto const reader = cyng::make_reader(frame.at(0));
-		auto const tag = name_gen_(cyng::value_cast<std::string>(reader.get("tag"), ""));
-		auto const id = boost::uuids::to_string(tag);
+		auto const name = cyng::value_cast<std::string>(reader.get("tag"), "");
+		auto const tag = name_gen_(name);
 		auto const text = accumulate_plain_text(reader.get("text"));
-		
-		//	<a href="#id">text</a>
-		
-		std::string ref = text.empty() 
-			? "?" 
-			: (text)
-			;
-		auto const a = dom::a(dom::href_("#" + id), ref);
-		
-		ctx.push(cyng::make_object(a(0)));
+
+		//
+		//	the target may follow - resolved when the file is written
+		//
+		push_text(ctx, labels_.add_ref(tag, name, text));
 	}
 
 	void gen_bootstrap::make_tok(cyng::context& ctx)
@@ -963,45 +946,26 @@ namespace docscript
 		auto const reader = cyng::make_reader(frame.at(0));
 		auto const level = cyng::numeric_cast<std::size_t>(reader.get("depth"), 3u);
 
-		switch (level) {
-		case 1:
-			ctx.push(cyng::make_object(name_gen_("[ToC-1]")));
-			break;
-		case 2:
-			ctx.push(cyng::make_object(name_gen_("[ToC-2]")));
-			break;
-		case 3:
-			ctx.push(cyng::make_object(name_gen_("[ToC-3]")));
-			break;
-		case 4:
-			ctx.push(cyng::make_object(name_gen_("[ToC-4]")));
-			break;
-		default:
-			ctx.push(cyng::make_object(name_gen_("[ToC]")));
-			break;
-		}
+		ctx.push(cyng::make_object(placeholders_.get_toc(level)));
 	}
 
 	void gen_bootstrap::format_italic(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto el = dom::em(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("em", frame));
 	}
 
 	void gen_bootstrap::format_bold(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto el = dom::b(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("b", frame));
 	}
 
 	void gen_bootstrap::format_tt(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto el = dom::tt(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("tt", frame));
 	}
 
 	void gen_bootstrap::format_color(cyng::context& ctx)
@@ -1016,12 +980,12 @@ namespace docscript
 			auto const color = map.begin()->first;
 			auto const str = accumulate_plain_text(map.begin()->second);
 			auto el = dom::span(dom::style_("color:" + color), str);
-			ctx.push(cyng::make_object(el(0)));
+			push_text(ctx, el(indent(0)));
 		}
 		else {
 
 			auto div = dom::div(dom::p("***ERROR: color definition"));
-			ctx.push(cyng::make_object(div(0)));
+			push_text(ctx, div(indent(0)));
 		}
 	}
 
@@ -1029,29 +993,25 @@ namespace docscript
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto const el = dom::sub(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("sub", frame));
 	}
 
 	void gen_bootstrap::format_sup(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto const el = dom::sup(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("sup", frame));
 	}
 
 	void gen_bootstrap::format_mark(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto const el = dom::mark(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("mark", frame));
 	}
 
 	void gen_bootstrap::print_hline(cyng::context& ctx)
 	{
-		auto const el = dom::hr();
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::hr(), indent(0));
 	}
 
 	void gen_bootstrap::header(cyng::context& ctx)
@@ -1067,6 +1027,7 @@ namespace docscript
 		auto const level = cyng::numeric_cast<std::size_t>(reader.get("level"), 0ul);
 
 		auto const number = content_table_.add(level, tag, title);
+		labels_.add(tag, label_kind::HEADING, number, title);
 		auto const header = create_section(level, id, number + " " + title);
 		//std::cout << header << std::endl;
 		ctx.push(cyng::make_object(header));
@@ -1079,12 +1040,12 @@ namespace docscript
 		auto a = dom::a(dom::id_(id), dom::aria_hidden_("true"), dom::href_(id), dom::class_("oction"));
 
 		switch (level) {
-		case 1:	return dom::h1(dom::id_(id), title, dom::class_("display-1"))(1);
-		case 2: return dom::h2(dom::id_(id), title, dom::class_("display-2"))(1);
-		case 3: return dom::h3(dom::id_(id), title, dom::class_("display-3"))(1);
-		case 4: return dom::h4(dom::id_(id), title, dom::class_("display-4"))(1);
-		case 5: return dom::h5(dom::id_(id), title, dom::class_("display-5"))(1);
-		case 6: return dom::h6(dom::id_(id), title, dom::class_("display-6"))(1);
+		case 1:	return dom::h1(dom::id_(id), title, dom::class_("display-1"))(indent(1));
+		case 2: return dom::h2(dom::id_(id), title, dom::class_("display-2"))(indent(1));
+		case 3: return dom::h3(dom::id_(id), title, dom::class_("display-3"))(indent(1));
+		case 4: return dom::h4(dom::id_(id), title, dom::class_("display-4"))(indent(1));
+		case 5: return dom::h5(dom::id_(id), title, dom::class_("display-5"))(indent(1));
+		case 6: return dom::h6(dom::id_(id), title, dom::class_("display-6"))(indent(1));
 		default:
 			break;
 		}
@@ -1114,6 +1075,7 @@ namespace docscript
 		auto const tag = name_gen_(note);
 		footnotes_.emplace_back(tag, note);
 		auto const idx = footnotes_.size();
+		labels_.add(tag, label_kind::FOOTNOTE, std::to_string(idx), note);
 
 		std::stringstream ss;
 		ss
@@ -1123,7 +1085,7 @@ namespace docscript
 			;
 		auto const el = dom::sup(dom::a(dom::href_("#" + boost::uuids::to_string(tag)), ss.str()));
 
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	void gen_bootstrap::print_symbol(cyng::context& ctx)
@@ -1144,7 +1106,7 @@ namespace docscript
 			}
 			else if (boost::algorithm::iequals(symbol, "latex")) {
 				auto const el = dom::span("L", dom::sup("A"), "T", dom::sub("E"), "X");
-				r += el(0);
+				r += el(indent(0));
 			}
 			else if (boost::algorithm::iequals(symbol, "celsius")) {
 				r.append("&#8451;");
@@ -1175,7 +1137,7 @@ namespace docscript
 			}
 		}
 		auto const el = dom::span(dom::style_("font-family:Georgia, Cambria, serif;"), r);
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	void gen_bootstrap::print_currency(cyng::context& ctx)
@@ -1238,7 +1200,7 @@ namespace docscript
 		std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 
 		auto section = dom::section(dom::class_("container-fluid"), dom::div(dom::class_("card-deck")));
-		ctx.push(cyng::make_object(section(0)));
+		push_text(ctx, section(0));
 	}
 
 
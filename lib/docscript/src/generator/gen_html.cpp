@@ -6,6 +6,11 @@
  */ 
 
 #include <docscript/generator/gen_html.h>
+#include <docscript/generator/base64.h>
+#include <docscript/generator/escape.h>
+#include <docscript/generator/image.h>
+#include <docscript/generator/minify.h>
+#include <docscript/generator/svg.h>
 
 #include "filter/json_to_html.h"
 #include "filter/cpp_to_html.h"
@@ -22,7 +27,6 @@
 #include <cyng/numeric_cast.hpp>
 #include <cyng/set_cast.h>
 #include <cyng/dom/reader.h>
-#include <cyng/csv.h>
 #include <cyng/io/bom.h>
 
 #include <crypto/hash/base64.h>
@@ -36,8 +40,8 @@
 
 namespace docscript
 {
-	gen_html::gen_html(std::vector< cyng::filesystem::path > const& inc, bool body_only)
-		: generator(inc)
+	gen_html::gen_html(std::vector< cyng::filesystem::path > const& inc, bool body_only, bool sync)
+		: generator(inc, sync)
 		, footnotes_()
 		, figures_()
 		, tables_()
@@ -46,11 +50,22 @@ namespace docscript
 		register_this();
 	}
 
+	void gen_html::reset()
+	{
+		generator::reset();
+		footnotes_.clear();
+		figures_.clear();
+		tables_.clear();
+	}
+
 	void gen_html::register_this()
 	{
 		generator::register_this();
 
-		vm_.register_function("demo", 0, std::bind(&gen_html::demo, this, std::placeholders::_1));
+		register_function("demo", 0, std::bind(&gen_html::demo, this, std::placeholders::_1));
+		register_function("lof", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_FIGURES, std::placeholders::_1));
+		register_function("lot", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::LIST_OF_TABLES, std::placeholders::_1));
+		register_function("footnotes", 0, std::bind(&generator::make_placeholder, this, placeholder_kind::FOOTNOTES, std::placeholders::_1));
 	}
 
 	void gen_html::generate_file(cyng::context& ctx)
@@ -62,7 +77,7 @@ namespace docscript
 		if (cyng::filesystem::is_directory(p)) {
 			p = p / "out.html";
 		}
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -73,6 +88,14 @@ namespace docscript
 		}
 		else
 		{
+			ofs.precompress(precompress_);
+
+			//
+			//	all labels are known now. The meta data are used
+			//	as attributes and in the index.
+			//
+			resolve_meta();
+
 			//
 			//	provide a slug if not defined yet.
 			//
@@ -82,16 +105,61 @@ namespace docscript
 			//
 			cyng::write(ofs, cyng::bom::UTF8);
 
+			//
+			//	all labels are known now
+			//
+			labels_.report_dangling();
+
 			//
 			//	write output file
 			//
 			auto pos = frame.begin();
 			auto end = frame.end();
-			emit_file(ofs, std::next(pos), end);
+			if (minify_) {
+				minify_stream mos(ofs);
+				emit_resolved(mos, std::next(pos), end);
+			}
+			else {
+				emit_resolved(ofs, std::next(pos), end);
+			}
+		}
+	}
+
+	std::ostream& gen_html::emit_resolved(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	{
+		if (!labels_.has_refs()) {
+			return emit_file(ofs, pos, end);
+		}
+
+		//
+		//	replace the reference markers in a single pass
+		//
+		label_stream los(ofs, [this](std::size_t idx) {
+			return resolve_ref(idx);
+		});
+		emit_file(los, pos, end);
+		return ofs;
+	}
+
+	std::string gen_html::resolve_ref(std::size_t idx) const
+	{
+		auto const* ref = labels_.get_ref(idx);
+		if (ref == nullptr)	return std::string();
+
+		auto const* lbl = labels_.find(ref->tag_);
+		if (lbl == nullptr) {
+			return make_reference(*ref, nullptr, std::string())(indent(0));
 		}
+
+		//
+		//	The title attribute cannot contain links. A caption
+		//	with references gets their plain text.
+		//
+		label const plain{ lbl->kind_, lbl->number_, resolve_plain(lbl->caption_) };
+		return make_reference(*ref, &plain, get_label_text(plain))(indent(0));
 	}
 
-	std::ofstream& gen_html::emit_file(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_html::emit_file(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
 		if (!body_only_) {
 			emit_doctype(ofs);
@@ -106,6 +174,22 @@ namespace docscript
 				<< "<div>"
 				<< std::endl
 				;
+
+			//
+			//	a body fragment can reference the shared stylesheet too
+			//
+			auto const href = (style_sheet_ != nullptr)
+				? style_sheet_->emit()
+				: std::string()
+				;
+			if (!href.empty()) {
+				ofs
+					<< "<link rel=\"stylesheet\" href=\""
+					<< href
+					<< "\" />"
+					<< std::endl
+					;
+			}
 		}
 		emit_body(ofs, pos, end);
 		if (!body_only_) {
@@ -126,7 +210,7 @@ namespace docscript
 
 	}
 
-	std::ofstream& gen_html::emit_doctype(std::ofstream& ofs) const
+	std::ostream& gen_html::emit_doctype(std::ostream& ofs) const
 	{
 		ofs
 			<< "<!doctype html>"
@@ -139,7 +223,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_head(std::ofstream& ofs) const
+	std::ostream& gen_html::emit_head(std::ostream& ofs) const
 	{
 		ofs
 			<< "<head>"
@@ -159,7 +243,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_meta(std::ofstream& ofs) const
+	std::ostream& gen_html::emit_meta(std::ostream& ofs) const
 	{
 		//	emit meta data
 		for (auto const& e : meta_) {
@@ -193,353 +277,61 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_styles(std::ofstream& ofs) const
+	std::ostream& gen_html::emit_styles(std::ostream& ofs) const
 	{
-		ofs
-			<< "\t<style>"
-			<< std::endl
-			<< "\t\tbody { "
-			<< std::endl
-			//	Georgia,Cambria,serif;
-			<< "\t\t\tfont-family:'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;"	
-			<< std::endl
-			//	https://jrl.ninja/etc/1/
-			//<< "\t\t\tmax-width: 52rem; "
-			<< "\t\t\tmax-width: 62%; "
-			<< std::endl
-			<< "\t\t\tpadding: 2rem; "
-			<< std::endl
-			<< "\t\t\tmargin: auto; "
-			<< std::endl
-			<< "\t\t\font-size: 1.1em; "
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//
-			//	styling header h1 and h2
-			//
-			<< "\t\th1, h2 {"
-			<< std::endl
-			<< "\t\t\tpadding-bottom: .3em;"
-			<< std::endl
-			<< "\t\t\tborder-bottom: 1px solid #eaecef;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tcode, kbd, pre, samp {"
-			<< std::endl
-			<< "\t\t\tfont-family: monospace;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//oction
-
-			<< "\t\ta.oction {"
-			<< std::endl
-			<< "\t\t\topacity: 0;"
-			<< std::endl
-			<< "\t\t\ttransition: opacity 0.2s;"
-			<< std::endl
-			<< "\t\t\tcursor: pointer;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\ta.oction:hover{"
-			<< std::endl
-			<< "\t\t\topacity: 1;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-
-			<< "\t\tp > a {"
-			<< std::endl
-			<< "\t\t\ttext-decoration: none;"
-			<< std::endl
-			<< "\t\t\tcolor: blue;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tblockquote > p { margin-bottom: 1px; }"
-			<< std::endl
-			<< "\t\tpre { background-color: #fafafa; }"
-			<< std::endl
-
-			<< "\t\tpre > code:hover {"
-			<< std::endl
-			<< "\t\t\tbackground-color: orange;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tblockquote {"
-			<< std::endl
-			<< "\t\t\tborder-left: 4px solid #eee;"
-			<< std::endl
-			<< "\t\t\tpadding-left: 10px;"
-			<< std::endl
-			<< "\t\t\tcolor: #777;"
-			<< std::endl
-			<< "\t\t\tmargin: 16px 20px;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//
-			//	figure
-			//
-			<< "\t\tfigure {"
-			<< std::endl
-			<< "\t\t\tmargin: 2%;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\tfigure > figcaption {"
-			<< std::endl
-			<< "\t\t\tbackground-color: #ddd;"
-			<< std::endl
-			<< "\t\t\tfont-style: italic;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\timg {"
-			<< std::endl
-			//<< "\t\t\tmax-width: 95%;"
-			//<< std::endl
-			<< "\t\t\tborder: 2px solid #777;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\timg:hover {"
-			<< std::endl
-			<< "\t\t\tbox-shadow: 0 0 10px #ccc;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//
-			//	gallery
-			//
-			<< "\t\tdiv.gallery {"
-			<< std::endl
-			<< "\t\t\tdisplay: grid;"
-			<< std::endl
-			<< "\t\t\tgrid-gap: 12px;"
-			<< std::endl
-			<< "\t\t\tbackground-color: #eee;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tdiv.smf-svg:hover {"
-			<< std::endl
-			<< "\t\t\tbox-shadow: 0 0 10px #ccc;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//
-			//	gallery
-			//
-			<< "\t\tdiv.gallery img {"
-			<< std::endl
-			<< "\t\t\twidth: 100%;"
-			<< std::endl
-			<< "\t\t\theight: auto;"
-			<< std::endl
-			<< "\t\t\tobject-fit: cover;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//
-			//	definition lists with flexbox
-			//
-			<< "\t\tdl {"
-			<< std::endl
-			<< "\t\t\tdisplay: flex;"
-			<< std::endl
-			<< "\t\t\tflex-flow: row wrap;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\tdt {"
-			<< std::endl
-			<< "\t\t\tfont-weight: bold;"
-			<< std::endl
-			<< "\t\t\tflex-basis: 20% ;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\tdt::after {"
-			<< std::endl
-			<< "\t\t\tcontent: \":\";"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\tdd {"
-			<< std::endl
-			<< "\t\t\tflex-basis: 70%;"
-			<< std::endl
-			<< "\t\t\tflex-grow: 1;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
+		if (style_sheet_ != nullptr) {
 
 			//
-			//	alertbox with flexgrid
+			//	shared stylesheet - empty if the file cannot be written
 			//
-			<< "\t\tul.alert {"
-			<< std::endl
-			<< "\t\t\tdisplay: flex;"
-			<< std::endl
-			<< "\t\t\tlist-style: none;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tul.alert > li {"
-			<< std::endl
-			<< "\t\t\tpadding: 7px;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tul.alert > li:nth-child(2) {"
-			<< std::endl
-			<< "\t\t\tbackground-color: #ddd;"
-			<< std::endl
-			<< "\t\t\tborder-radius: 5px;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//	formatting sub and supscript
-			<< "\t\tsup { top: -.5em; }"
-			<< std::endl
-			<< "\t\tsub { bottom: -.25em; }"
-			<< std::endl
-			<< "\t\tsub, sup {"
-			<< std::endl
-			<< "\t\t\tfont-size: 75%;"
-			<< std::endl
-			<< "\t\t\tline-height: 0;"
-			<< std::endl
-			<< "\t\t\tposition: relative;"
-			<< std::endl
-			<< "\t\t\tvertical-align: baseline;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			//	There is an alternative styling for aside tag that works
-			//	for bootstrap 4 too: float: right;
-			<< "\t\taside {"
-			<< std::endl
-			<< "\t\t\tposition: absolute;"
-			<< std::endl
-			<< "\t\t\tright: 2em;"
-			<< std::endl
-			<< "\t\t\twidth: 20%;"
-			<< std::endl
-			<< "\t\t\tborder: 1px #D5DBDB solid;"
-			<< std::endl
-			<< "\t\t\tcolor: #9C640C;"
-			<< std::endl
-			<< "\t\t\tpadding: 0.5em;"
-			<< std::endl
-			<< "\t\t\tz-index: -1;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\ttable {"
-			<< std::endl
-			<< "\t\t\tborder-collapse: collapse;"
-			<< std::endl
-			<< "\t\t\tborder-spacing: 0px;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-			<< "\t\ttable, th, td {"
-			<< std::endl
-			<< "\t\t\tpadding: 5px;"
-			<< std::endl
-			<< "\t\t\tborder: 1px solid black;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\ttr:nth-child(even) {"
-			<< std::endl
-			<< "\t\t\tbackground-color: #f2f2f2;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tcaption {"
-			<< std::endl
-			<< "\t\t\tfont-weight: bold;"
-			<< std::endl
-			<< "\t\t\tcolor: white;"
-			<< std::endl
-			<< "\t\t\tbackground-color: DimGray;"
-			<< std::endl
-			<< "\t\t\tpadding: 5px;"
-			<< std::endl
-			<< "\t\t\ttext-align: left;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
-
-			<< "\t\tkbd {"
-			<< std::endl
-			<< "\t\t\tpadding: 2px 4px;"
-			<< std::endl
-			<< "\t\t\tfont-size: 90%;"
-			<< std::endl
-			<< "\t\t\tcolor: #ffffff;"
-			<< std::endl
-			<< "\t\t\tbackground-color: #333333;"
-			<< std::endl
-			<< "\t\t\tborder-radius: 3px;"
-			<< std::endl
-			<< "\t\t}"
-			<< std::endl
+			auto const href = style_sheet_->emit();
+			if (!href.empty()) {
+				if (style_sheet_->is_critical()) {
+					ofs
+						<< "\t<style>"
+						<< std::endl
+						;
+					emit_critical_rules(ofs);
+					ofs
+						<< "\t</style>"
+						<< std::endl
+						;
+				}
+				ofs
+					<< "\t<link rel=\"stylesheet\" href=\""
+					<< href
+					<< "\" />"
+					<< std::endl
+					;
+				return ofs;
+			}
+		}
 
-			//
-			//	ToC
-			//
-			<< "\t\tdetails > ul * {"
-			<< std::endl
-			<< "\t\t\tlist-style-type: none;"
-			<< std::endl
-			<< "\t\t\ttext-decoration: none;"
-			<< std::endl
-			<< "\t\t\tmargin-left: 0em;"
-			<< std::endl
-			<< "\t\t\tpadding-left: 0.7em;"
-			<< std::endl
-			<< "\t\t}"
+		ofs
+			<< "\t<style>"
 			<< std::endl
-
+			;
+		emit_critical_rules(ofs);
+		emit_style_rules(ofs);
+		ofs
 			<< "\t</style>"
 			<< std::endl
-
 			;
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_body(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_html::emit_body(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
+		//
+		//	footnotes are emitted at the end of the document
+		//	if there is no placeholder
+		//
+		bool footnotes{ false };
 		while (pos != end) {
 			if (pos->get_class().tag() == cyng::TC_UUID) {
-				emit_intrinsic(ofs, cyng::value_cast(*pos, boost::uuids::nil_uuid()));
+				auto const tag = cyng::value_cast(*pos, boost::uuids::nil_uuid());
+				footnotes = footnotes || (tag == placeholders_.get(placeholder_kind::FOOTNOTES));
+				emit_intrinsic(ofs, tag);
 			}
 			else {
 				emit_body(ofs, *pos);
@@ -547,36 +339,45 @@ namespace docscript
 			++pos;
 		}
 
-		emit_footnotes(ofs);
+		if (!footnotes)	emit_footnotes(ofs);
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_body(std::ofstream& ofs, cyng::object obj) const
+	std::ostream& gen_html::emit_body(std::ostream& ofs, cyng::object obj) const
 	{
-		ofs
-			<< cyng::io::to_str(obj)
-			<< std::endl
-			;
+		//
+		//	write strings without a copy
+		//
+		auto const* p = cyng::object_cast<std::string>(obj);
+		if (p != nullptr) {
+			ofs << *p;
+		}
+		else {
+			ofs << cyng::io::to_str(obj);
+		}
+		ofs << std::endl;
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_intrinsic(std::ofstream& ofs, boost::uuids::uuid tag) const
+	std::ostream& gen_html::emit_intrinsic(std::ostream& ofs, boost::uuids::uuid tag) const
 	{
 
-		if (tag == name_gen_("[ToC]")) {
-			emit_toc(ofs, 5);
+		auto const* ph = placeholders_.find(tag);
+		if (ph != nullptr && ph->kind_ == placeholder_kind::TOC) {
+			emit_toc(ofs, ph->param_);
 		}
-		else if (tag == name_gen_("[ToC-1]")) {
-			emit_toc(ofs, 1);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_FIGURES) {
+			emit_list(ofs, figures_, get_name(i18n::WID_FIGURE), indent(0), std::bind(&generator::resolve_plain, this, std::placeholders::_1));
 		}
-		else if (tag == name_gen_("[ToC-2]")) {
-			emit_toc(ofs, 2);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::LIST_OF_TABLES) {
+			emit_list(ofs, tables_, get_name(i18n::WID_TABLE), indent(0), std::bind(&generator::resolve_plain, this, std::placeholders::_1));
 		}
-		else if (tag == name_gen_("[ToC-3]")) {
-			emit_toc(ofs, 3);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::FOOTNOTES) {
+			emit_footnotes(ofs);
 		}
-		else if (tag == name_gen_("[ToC-4]")) {
-			emit_toc(ofs, 4);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::DEFERRED) {
+			emit_deferred(ofs, ph->param_);
+			ofs << std::endl;
 		}
 		else {
 			ofs
@@ -588,7 +389,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_toc(std::ofstream& ofs, std::size_t depth) const
+	std::ostream& gen_html::emit_toc(std::ostream& ofs, std::size_t depth) const
 	{
 
 		ofs
@@ -600,7 +401,7 @@ namespace docscript
 			<< std::endl
 			;
 
-		auto const toc = serialize(content_table_);
+		auto const& toc = serialize(content_table_);
 
 		emit_toc(ofs, toc, 0, depth);
 
@@ -611,7 +412,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_toc(std::ofstream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
+	std::ostream& gen_html::emit_toc(std::ostream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
 	{
 		ofs
 			<< std::string(level + 1, '\t')
@@ -625,7 +426,7 @@ namespace docscript
 		for (auto const& header : toc) {
 
 			auto const h = cyng::to_param_map(header);
-			auto const title = cyng::io::to_str(h.at("title"));
+			auto const title = resolve_plain(cyng::io::to_str(h.at("title")));
 			auto const number = cyng::io::to_str(h.at("number"));
 			auto const tag = cyng::value_cast(h.at("tag"), boost::uuids::nil_uuid());
 			auto const href = "#" + boost::uuids::to_string(tag);
@@ -639,7 +440,7 @@ namespace docscript
 				ofs
 					<< std::string(level + 1, '\t')
 					<< "<li>"
-					<< a(0)
+					<< a(indent(0))
 					<< std::endl
 					;
 
@@ -655,7 +456,7 @@ namespace docscript
 				ofs
 					<< std::string(level + 1, '\t')
 					<< "<li>"
-					<< a(0)
+					<< a(indent(0))
 					<< "</li>"
 					<< std::endl
 					;
@@ -672,7 +473,42 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_html::emit_footnotes(std::ofstream& ofs) const
+	std::ostream& emit_list(std::ostream& ofs, std::list<element> const& elements, std::string const& name, std::size_t depth, std::function<std::string(std::string const&)> const& plain)
+	{
+		ofs
+			<< "<details>"
+			<< std::endl
+			<< "\t<summary>"
+			<< name
+			<< "</summary>"
+			<< std::endl
+			<< "\t<ul>"
+			<< std::endl
+			;
+
+		std::size_t idx{ 0 };
+		for (auto const& e : elements) {
+			++idx;
+			auto const text = plain(e.get_text());
+			auto const a = dom::a(dom::href_("#" + e.get_tag()), dom::title_(text), name + ": " + std::to_string(idx) + " - " + text);
+			ofs
+				<< "\t\t<li>"
+				<< a(depth)
+				<< "</li>"
+				<< std::endl
+				;
+		}
+
+		ofs
+			<< "\t</ul>"
+			<< std::endl
+			<< "</details>"
+			<< std::endl
+			;
+		return ofs;
+	}
+
+	std::ostream& gen_html::emit_footnotes(std::ostream& ofs) const
 	{
 		if (!footnotes_.empty()) {
 
@@ -680,7 +516,7 @@ namespace docscript
 			//	horizontal line
 			//
 			ofs 
-				<< dom::hr()(0)
+				<< dom::hr()(indent(0))
 				<< std::endl;
 
 			//
@@ -701,7 +537,7 @@ namespace docscript
 					;
 
 				ofs 
-					<< dom::p(dom::id_(note.get_tag()), dom::class_("docscript-footnote"), ss.str())(0)
+					<< dom::p(dom::id_(note.get_tag()), dom::class_("docscript-footnote"), ss.str())(indent(0))
 					<< std::endl;
 
 				ss.str("");
@@ -736,16 +572,22 @@ namespace docscript
 		//
 		//	escape HTML entities
 		//
-		ctx.push(cyng::make_object(replace_html_entities(str)));
+		push_text(ctx, replace_html_entities(str));
 	}
 
 	void gen_html::paragraph(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		std::string par = accumulate_plain_text(frame);
-		auto el = dom::p(par);
-		ctx.push(cyng::make_object(el(0)));
+
+		//
+		//	the segments are written directly into the output file
+		//
+		push_writer(ctx, [frame](std::ostream& os) {
+			rope r;
+			accumulate_plain_text(r, frame);
+			write_inline(os, "p", r);
+		});
 	}
 
 	void gen_html::abstract(cyng::context& ctx)
@@ -759,8 +601,7 @@ namespace docscript
 
 
 		// default state is: open
-		auto const el = dom::details(dom::open_(std::string()), dom::summary(title), dom::p(text));
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::details(dom::open_(std::string()), dom::summary(title), dom::p(text)), indent(0));
 	}
 	
 	void gen_html::quote(cyng::context& ctx)
@@ -784,8 +625,7 @@ namespace docscript
 		auto const cite = cyng::value_cast<std::string>(reader.get("url"), "");
 		auto const source = cyng::value_cast<std::string>(reader.get("source"), "");
 		auto const quote = accumulate_plain_text(reader.get("q"));
-		auto const el = dom::figure(dom::blockquote(dom::cite_(cite), dom::class_("docscript-quote"), quote), dom::figcaption(dom::cite(source)));
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::figure(dom::blockquote(dom::cite_(cite), dom::class_("docscript-quote"), quote), dom::figcaption(dom::cite(source))), indent(0));
 	}
 
 	void gen_html::list(cyng::context& ctx)
@@ -868,7 +708,7 @@ namespace docscript
 			el += dom::li(accumulate_plain_text(item));
 		}
 
-		ctx.push(cyng::make_object(el(depth)));
+		push_text(ctx, el(depth));
 	}
 
 	void gen_html::link(cyng::context& ctx)
@@ -884,7 +724,7 @@ namespace docscript
 		auto const title = accumulate_plain_text(reader.get("title"));
 
 		auto const a = dom::a(dom::href_(url), dom::title_(title), text);
-		ctx.push(cyng::make_object(a(depth)));
+		push_text(ctx, a(depth));
 	}
 
 	std::string gen_html::compute_fig_title(boost::uuids::uuid tag, std::string caption)
@@ -895,6 +735,7 @@ namespace docscript
 		figures_.emplace_back(tag, caption);
 
 		auto const idx = figures_.size();
+		labels_.add(tag, label_kind::FIGURE, std::to_string(idx), caption);
 
 		std::stringstream ss;
 		ss
@@ -916,6 +757,7 @@ namespace docscript
 		tables_.emplace_back(tag, caption);
 
 		auto const idx = tables_.size();
+		labels_.add(tag, label_kind::TABLE, std::to_string(idx), caption);
 
 		std::stringstream ss;
 		ss
@@ -964,15 +806,21 @@ namespace docscript
 			auto const title = compute_fig_title(tag, caption);
 
 			//
-			//	generate <figure> tag
+			//	generate <figure> tag. Caption and alt text are
+			//	used as attributes and cannot contain links.
 			//
-			auto const el = make_figure(p
-				, id
-				, width
-				, caption
-				, title
-				, alt);
-			ctx.push(cyng::make_object(el(1)));
+			push_deferred(ctx, [p, id, width, caption = resolve_plain(caption), title, alt = resolve_plain(alt), cache = cache_, assets = assets_, lazy = is_lazy_image(), d = indent(1)](std::ostream& os) {
+				auto const el = make_figure(p
+					, id
+					, width
+					, caption
+					, title
+					, alt
+					, cache
+					, assets
+					, lazy);
+				el.write(os, d);
+			});
 
 		}
 		else {
@@ -983,8 +831,8 @@ namespace docscript
 				<< "]"
 				<< std::endl;
 
-			auto const el = dom::h2(dom::id_(id), "cannot open file [" + source + "]", dom::title_(caption));
-			ctx.push(cyng::make_object(el(depth)));
+			auto const el = dom::h2(dom::id_(id), "cannot open file [" + source + "]", dom::title_(resolve_plain(caption)));
+			push_text(ctx, el(depth));
 		}
 	}
 
@@ -1008,9 +856,6 @@ namespace docscript
 
 		auto const size = cyng::numeric_cast<std::size_t>(reader.get("size"), vec.size());
 
-		auto div = dom::div(dom::id_(id));
-		div += dom::h4(caption);
-
 		if (!vec.empty()) {
 
 			//"grid-template-columns: repeat(N, 1fr)"
@@ -1025,8 +870,11 @@ namespace docscript
 			}
 			ss << ", 1fr)";
 
-			auto grid = dom::div(dom::class_("gallery"), dom::style_(ss.str()));
-
+			//
+			//	figure titles are numbered here, the images
+			//	are rendered on a worker thread
+			//
+			std::vector<std::function<dom::element()>> figures;
 			for (auto pos = 0u; pos < vec.size(); ++pos) {
 				auto const alt = accumulate_plain_text(reader["images"][pos].get("alt"));
 				auto const caption = accumulate_plain_text(reader["images"][pos].get("caption"));
@@ -1040,14 +888,17 @@ namespace docscript
 				auto const p = resolve_path(source);
 				if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-					auto el = make_figure(p
-						, id
-						, width
-						, caption
-						, compute_fig_title(tag, caption)
-						, alt);
-
-					grid += std::move(el);
+					figures.push_back([p, id, width, caption = resolve_plain(caption), title = compute_fig_title(tag, caption), alt = resolve_plain(alt), cache = cache_, assets = assets_, lazy = is_lazy_image()]() {
+						return make_figure(p
+							, id
+							, width
+							, caption
+							, title
+							, alt
+							, cache
+							, assets
+							, lazy);
+					});
 				}
 				else {
 
@@ -1060,12 +911,22 @@ namespace docscript
 				}
 			}
 
-			//
-			//	ToDo: improve CSS
-			//
-			div += std::move(grid);
+			push_deferred(ctx, [id, caption, style = ss.str(), figures, d = indent(0)](std::ostream& os) {
+
+				auto div = dom::div(dom::id_(id));
+				div += dom::h4(caption);
+
+				auto grid = dom::div(dom::class_("gallery"), dom::style_(style));
+				for (auto const& make : figures) {
+					grid += make();
+				}
 
-			ctx.push(cyng::make_object(div(0)));
+				//
+				//	ToDo: improve CSS
+				//
+				div += std::move(grid);
+				div.write(os, d);
+			});
 		}
 		else {
 			std::cerr
@@ -1089,129 +950,36 @@ namespace docscript
 		auto const p = resolve_path(source);
 		auto const language = cyng::value_cast(reader.get("language"), get_extension(p));
 
-		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
-
-			std::stringstream ss;
-			ss 
-				<< "<figure>"
-				<< std::endl
-				<< "\t<figcaption>"
-				<< caption
-				<< "</figcaption>"
-				<< std::endl
-				;
-			if (boost::algorithm::iequals(language, "json")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-json\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				json_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</pre>" << std::endl;
-
-			}
-			else if (boost::algorithm::equals(language, "C++") || boost::algorithm::iequals(language, "cpp") || boost::algorithm::iequals(language, "h")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				cpp_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::iequals(language, "docscript")) {
+		//
+		//	optional line range (1-based, inclusive) and size limit
+		//
+		excerpt const range{
+			cyng::numeric_cast<std::size_t>(reader.get("first"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("last"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("maxsize"), 0u)
+		};
 
-				std::ifstream  ifs(p.string());
-				ss 
-					<< "<pre class=\"docscript-pre\" title=\""
-					<< caption
-					<< "\"><code contenteditable spellcheck=\"false\">"
-					;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				docscript_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << std::endl << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "txt") || boost::algorithm::iequals(language, "text") || boost::algorithm::iequals(language, "verbatim")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-txt\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				text_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
-
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				ss << "<pre class=\"docscript-pre-binary\">" << std::endl;
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				binary_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "html") || boost::algorithm::iequals(language, "htm")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre-html\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				html_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else if (boost::algorithm::equals(language, "sml")) {
-
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				ss << "<pre class=\"docscript-pre-binary\">" << std::endl;
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				try {
-					sml_to_html filter(line_numbers, uuid_gen_());
-					filter.convert(ss, inp);
-				}
-				catch (std::exception const& ex) {
+		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-					ss
-						<< "***error: converting SML file "
-						<< p
-						<< " to html failed with error: "
-						<< ex.what()
-						<< std::endl;
-				}
-				ss 
-					<< "</code></pre>" 
-					<< std::endl;
-			}
-			else if (boost::algorithm::equals(language, "ini") || boost::algorithm::iequals(language, "service") || boost::algorithm::iequals(language, "cfg")) {
-
-				std::ifstream  ifs(p.string());
-				ss << "<pre class=\"docscript-pre\">" << std::endl;
-				std::string const inp(static_cast<std::stringstream const&>(std::stringstream() << ifs.rdbuf()).str());
-				ini_to_html filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-				ss << "</code></pre>" << std::endl;
-			}
-			else {
-				std::ifstream  ifs(p.string());
-				ss
-					<< "<pre><code>"
+			//
+			//	The tag is stable across runs, so unchanged code
+			//	is taken from the cache.
+			//
+			push_deferred(ctx, [p, range, language, caption, plain = resolve_plain(caption), line_numbers, tag = make_stable_tag(p.string()), cache = cache_](std::ostream& os) {
+				os 
+					<< "<figure>"
 					<< std::endl
-					<< ifs.rdbuf()
+					<< "\t<figcaption>"
+					<< caption
+					<< "</figcaption>"
 					<< std::endl
-					<< "</code></pre>"
+					;
+				render_code(os, p, range, language, plain, line_numbers, tag, cache);
+				os
+					<< "</figure>"
 					<< std::endl
 					;
-			}
-
-			ss 
-				<< "</figure>"
-				<< std::endl
-				;
-
-			ctx.push(cyng::make_object(ss.str()));
+			});
 		}
 		else {
 
@@ -1221,7 +989,7 @@ namespace docscript
 				<< "] does not exist or is not a regular file"
 				<< std::endl;
 				auto const el = dom::strong(source);
-				ctx.push(cyng::make_object(el(0)));
+				push_text(ctx, el(indent(0)));
 
 		}
 	}
@@ -1242,9 +1010,9 @@ namespace docscript
 		defs = cyng::value_cast(frame.at(0), defs);
 		for (auto const& def : defs) {
 			ss
-				<< dom::dt(def.first)(0)
+				<< dom::dt(def.first)(indent(0))
 				<< '\t'
-				<< dom::dd(accumulate_plain_text(def.second))(0)
+				<< dom::dd(accumulate_plain_text(def.second))(indent(0))
 				<< std::endl
 				;
 		}
@@ -1253,14 +1021,17 @@ namespace docscript
 			<< "</dl>"
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_html::annotation(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto const el = dom::aside(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_writer(ctx, [frame](std::ostream& os) {
+			rope r;
+			accumulate_plain_text(r, frame);
+			write_inline(os, "aside", r);
+		});
 	}
 
 	void gen_html::table(cyng::context& ctx)
@@ -1273,6 +1044,14 @@ namespace docscript
 		auto const source = cyng::io::to_str(reader.get("source"));
 		auto const tag = name_gen_(cyng::value_cast(reader.get("tag"), source));
 
+		//
+		//	optional row limit and pagination
+		//
+		table_limits const limits{
+			cyng::numeric_cast<std::size_t>(reader.get("maxrows"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("pagesize"), 0u)
+		};
+
 		auto const p = resolve_path(source);
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
@@ -1281,44 +1060,14 @@ namespace docscript
 			//
 			//tables_.emplace_back(tag, title);
 			auto const caption = compute_tbl_title(tag, title);
-
 			auto const id = boost::uuids::to_string(tag);
-			auto table = dom::table(dom::id_(id), dom::class_("docscript-table"));
-			table += dom::caption(dom::class_("docscript-table-caption"), caption);
 
 			//
-			//	parse the CSV file into a vector
+			//	stream the CSV file directly into the output
 			//
-			auto const csv = cyng::csv::read_file(p.string());
-
-			bool initial{ true };
-			auto head = dom::thead(dom::class_("docscript-table-head"));
-			auto body = dom::tbody(dom::class_("docscript-table-body"));
-			for (auto const& row : csv) {
-
-				auto tr = dom::tr(dom::class_("docscript-tr"));
-				cyng::tuple_t tpl;
-				tpl = cyng::value_cast(row, tpl);
-				for (auto const& cell : tpl) {
-					auto td = (initial) 
-						? dom::th(dom::class_("docscript-th"), cyng::io::to_str(cell))
-						: dom::td(dom::class_("docscript-td"), cyng::io::to_str(cell))
-						;
-					tr += std::move(td);
-				}
-
-				if (initial) {
-					initial = false;
-					head += std::move(tr);
-				}
-				else {
-					body += std::move(tr);
-				}
-			}
-
-			table += std::move(head);
-			table += std::move(body);
-			ctx.push(cyng::make_object(table(1)));
+			push_deferred(ctx, [p, id, caption, limits, notice = get_name(i18n::WID_TABLE_TRUNCATED)](std::ostream& os) {
+				render_table(os, p, id, caption, limits, notice);
+			});
 		}
 		else {
 
@@ -1350,31 +1099,26 @@ namespace docscript
 
 				//std::string const svg = icon_info_;
 				//	 &#xFE0F; ℹ 
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_info_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_info_), dom::li(msg)), indent(0));
 			}
 			else if (boost::algorithm::equals(type, "CAUTION")) {
 
 				//	&#10071; ❗
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_caution_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_caution_), dom::li(msg)), indent(0));
 			}
 			else if (boost::algorithm::equals(type, "WARNING")) {
 
 				//	&#9888; ⚠️
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_warning_), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(icon_warning_), dom::li(msg)), indent(0));
 			}
 			else {
 
-				auto const ul = dom::ul(dom::id_(id), dom::class_("alert"), dom::li(type), dom::li(msg));
-				ctx.push(cyng::make_object(ul(0)));
+				push_element(ctx, dom::ul(dom::id_(id), dom::class_("alert"), dom::li(type), dom::li(msg)), indent(0));
 			}
 		}
 		else {
 
-			auto const div = dom::div(dom::p("***ERROR: alert definition"));
-			ctx.push(cyng::make_object(div(0)));
+			push_element(ctx, dom::div(dom::p("***ERROR: alert definition")), indent(0));
 
 		}
 	}
@@ -1385,19 +1129,14 @@ namespace docscript
 //  		std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 		
 		auto const reader = cyng::make_reader(frame.at(0));
-		auto const tag = name_gen_(cyng::value_cast<std::string>(reader.get("tag"), ""));
-		auto const id = boost::uuids::to_string(tag);
+		auto const name = cyng::value_cast<std::string>(reader.get("tag"), "");
+		auto const tag = name_gen_(name);
 		auto const text = accumulate_plain_text(reader.get("text"));
-		
-		//	<a href="#id">text</a>
-		
-		std::string ref = text.empty() 
-			? "?" 
-			: (text)
-			;
-		auto const a = dom::a(dom::href_("#" + id), ref);
-		
-		ctx.push(cyng::make_object(a(0)));
+
+		//
+		//	the target may follow - resolved when the file is written
+		//
+		push_text(ctx, labels_.add_ref(tag, name, text));
 	}
 
 	void gen_html::make_tok(cyng::context& ctx)
@@ -1406,45 +1145,26 @@ namespace docscript
 		auto const reader = cyng::make_reader(frame.at(0));
 		auto const level = cyng::numeric_cast<std::size_t>(reader.get("depth"), 3u);
 
-		switch (level) {
-		case 1:
-			ctx.push(cyng::make_object(name_gen_("[ToC-1]")));
-			break;
-		case 2:
-			ctx.push(cyng::make_object(name_gen_("[ToC-2]")));
-			break;
-		case 3:
-			ctx.push(cyng::make_object(name_gen_("[ToC-3]")));
-			break;
-		case 4:
-			ctx.push(cyng::make_object(name_gen_("[ToC-4]")));
-			break;
-		default:
-			ctx.push(cyng::make_object(name_gen_("[ToC]")));
-			break;
-		}
+		ctx.push(cyng::make_object(placeholders_.get_toc(level)));
 	}
 
 	void gen_html::format_italic(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto el = dom::em(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("em", frame));
 	}
 
 	void gen_html::format_bold(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto el = dom::b(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("b", frame));
 	}
 
 	void gen_html::format_tt(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto el = dom::tt(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("tt", frame));
 	}
 
 	void gen_html::format_color(cyng::context& ctx)
@@ -1459,12 +1179,12 @@ namespace docscript
 			auto const color = map.begin()->first;
 			auto const str = accumulate_plain_text(map.begin()->second);
 			auto el = dom::span(dom::style_("color:" + color), str);
-			ctx.push(cyng::make_object(el(0)));
+			push_text(ctx, el(indent(0)));
 		}
 		else {
 
 			auto div = dom::div(dom::p("***ERROR: color definition"));
-			ctx.push(cyng::make_object(div(0)));
+			push_text(ctx, div(indent(0)));
 		}
 	}
 
@@ -1472,29 +1192,25 @@ namespace docscript
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto const el = dom::sub(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("sub", frame));
 	}
 
 	void gen_html::format_sup(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		auto const el = dom::sup(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("sup", frame));
 	}
 
 	void gen_html::format_mark(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
-		auto const el = dom::mark(accumulate_plain_text(frame));
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, make_inline("mark", frame));
 	}
 
 	void gen_html::print_hline(cyng::context& ctx)
 	{
-		auto const el = dom::hr();
-		ctx.push(cyng::make_object(el(0)));
+		push_element(ctx, dom::hr(), indent(0));
 	}
 
 	void gen_html::header(cyng::context& ctx)
@@ -1510,6 +1226,7 @@ namespace docscript
 		auto const level = cyng::numeric_cast<std::size_t>(reader.get("level"), 0ul);
 
 		auto const number = content_table_.add(level, tag, title);
+		labels_.add(tag, label_kind::HEADING, number, title);
 		auto const header = create_section(level, id, number + " " + title);
 		//std::cout << header << std::endl;
 		ctx.push(cyng::make_object(header));
@@ -1522,12 +1239,12 @@ namespace docscript
 		auto a = dom::a(dom::id_(id), dom::aria_hidden_("true"), dom::href_(id), dom::style_("margin-right: 6px;"), dom::class_("oction"), oction);
 
 		switch (level) {
-		case 1:	return dom::h1(a, title)(0);
-		case 2: return dom::h2(a, title)(0);
-		case 3: return dom::h3(a, title)(0);
-		case 4: return dom::h4(a, title)(0);
-		case 5: return dom::h5(dom::id_(id), title)(0);
-		case 6: return dom::h6(dom::id_(id), title)(0);
+		case 1:	return dom::h1(a, title)(indent(0));
+		case 2: return dom::h2(a, title)(indent(0));
+		case 3: return dom::h3(a, title)(indent(0));
+		case 4: return dom::h4(a, title)(indent(0));
+		case 5: return dom::h5(dom::id_(id), title)(indent(0));
+		case 6: return dom::h6(dom::id_(id), title)(indent(0));
 		default:
 			break;
 		}
@@ -1557,6 +1274,7 @@ namespace docscript
 		auto const tag = name_gen_(note);
 		footnotes_.emplace_back(tag, note);
 		auto const idx = footnotes_.size();
+		labels_.add(tag, label_kind::FOOTNOTE, std::to_string(idx), note);
 
 		std::stringstream ss;
 		ss
@@ -1566,7 +1284,7 @@ namespace docscript
 			;
 		auto const el = dom::sup(dom::a(dom::href_("#" + boost::uuids::to_string(tag)), ss.str()));
 
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	void gen_html::print_symbol(cyng::context& ctx)
@@ -1587,7 +1305,7 @@ namespace docscript
 			}
 			else if (boost::algorithm::iequals(symbol, "latex")) {
 				auto const el = dom::span(dom::abbr("L"), dom::sup("A"), dom::abbr("T"), dom::sub("E"), dom::abbr("X"));
-				r += el(0);
+				r += el(indent(0));
 			}
 			else if (boost::algorithm::iequals(symbol, "celsius")) {
 				r.append("&#8451;");
@@ -1618,7 +1336,7 @@ namespace docscript
 			}
 		}
 		auto const el = dom::span(dom::style_("font-family:Georgia, Cambria, serif;"), r);
-		ctx.push(cyng::make_object(el(0)));
+		push_text(ctx, el(indent(0)));
 	}
 
 	void gen_html::print_currency(cyng::context& ctx)
@@ -1759,170 +1477,74 @@ namespace docscript
     </g>
   </g></svg>)__";
 	
+	/**
+	 * Only visible in this compilation unit.
+	 * Typographic replacements ("<=", "->") and HTML entities
+	 */
+	escape_table const html_entities({
+		{ '&', "&amp;" },
+		{ '"', "&quot;" },
+		{ '\'', "&apos;" },
+		{ '<', "&lt;" },
+		{ '>', "&gt;" } }, {
+		{ '<', '=', "&leq;" },
+		{ '<', '-', "&xlarr;" },
+		{ '<', '<', "&Lt;" },
+		{ '>', '=', "&ge;" },
+		{ '>', '>', "&Gt;" },
+		{ '=', '>', "&xrArr;" },
+		{ '=', '=', "&equiv;" },
+		{ '-', '>', "&xrarr;" },
+		{ '!', '=', "&ne;" },
+		{ ':', ':', "&Colon;" },
+		{ ':', '=', "&Assign;" } });
+
 	std::string replace_html_entities(std::string const& str)
 	{
-		//	simple state engine
-		enum  {
-			STATE_DEFAULT,
-			STATE_LT,
-			STATE_GT,
-			STATE_EQ,
-			STATE_MINUS,
-			STATE_EXCL,	//!<	"!"
-			STATE_COL,	//!<	":"
-		} state = STATE_DEFAULT;
-
-		std::string r;
+		return html_entities(str);
+	}
 
-		//	small optimization
-		r.reserve(str.length());
-
-		for (auto const c : str) {
-			switch (state) {
-
-			case STATE_LT:
-				switch (c) {
-				case '=':
-					r.append("&leq;");
-					break;
-				case '-':
-					r.append("&xlarr;");
-					break;
-				case '<':
-					r.append("&Lt;");
-					break;
-				default:
-					r.append("&lt;");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_GT:
-				switch (c) {
-				case '=':
-					r.append("&ge;");
-					break;
-				case '>':
-					r.append("&Gt;");
-					break;
-				default:
-					r.append("&gt;");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EQ:
-				switch (c) {
-				case '>':
-					r.append("&xrArr;");
-					break;
-				case '=':
-					r.append("&equiv;");
-					break;
-				default:
-					r += '=';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_MINUS:
-				switch (c) {
-				case '>':
-					r.append("&xrarr;");
-					break;
-				default:
-					r += '-';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EXCL:
-				switch (c) {
-				case '=':
-					r.append("&ne;");
-					break;
-				default:
-					r += '!';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_COL:
-				switch (c) {
-				case ':':
-					r.append("&Colon;");
-					break;
-				case '=':	//	:=
-					r.append("&Assign;");
-					break;
-				default:
-					r += ':';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			default:
-				switch (c) {
-				case '<':
-					state = STATE_LT;
-					break;
-				case '>':
-					state = STATE_GT;
-					break;
-				case '=':
-					state = STATE_EQ;
-					break;
-				case '-':
-					state = STATE_MINUS;
-					break;
-				case '!':
-					state = STATE_EXCL;
-					break;
-				case ':':
-					state = STATE_COL;
-					break;
-				case '&':
-					r.append("&amp;");
-					break;
-				case '"':
-					r.append("&quot;");
-					break;
-				case '\'':
-					r.append("&apos;");
-					break;
-				default:
-					r += c;
-					break;
-				}
-				break;
-			}
+	std::string make_inline(std::string_view tag, cyng::vector_t const& frame)
+	{
+		rope r;
+		accumulate_plain_text(r, frame);
+
+		std::string s;
+		s.reserve(r.size() + 2 * tag.size() + 5);
+		s.append(1, '<').append(tag);
+		if (r.empty()) {
+			s.append(" />");
 		}
+		else {
+			s.append(1, '>');
+			r.append_to(s);
+			s.append("</").append(tag).append(1, '>');
+		}
+		return s;
+	}
 
-		switch (state) {
-
-		case STATE_LT:		r += '<';	break;
-		case STATE_GT:		r += '>';	break;
-		case STATE_EQ:		r += '=';	break;
-		case STATE_MINUS:	r += '-';	break;
-		case STATE_EXCL:	r += '!';	break;
-		case STATE_COL:		r += ':';	break;
-		default:
-			break;
+	dom::element make_reference(reference const& ref, label const* lbl, std::string const& text)
+	{
+		auto const href = "#" + boost::uuids::to_string(ref.tag_);
+		if (lbl == nullptr) {
+			return dom::a(dom::href_(href), ref.text_.empty() ? std::string("?") : ref.text_);
 		}
+		return dom::a(dom::href_(href)
+			, dom::title_(html_attribute_escape()(lbl->caption_))
+			, ref.text_.empty() ? text : ref.text_);
+	}
 
-		return r;
+	void write_inline(std::ostream& os, std::string_view tag, rope const& r)
+	{
+		os << '<' << tag;
+		if (r.empty()) {
+			os << " />";
+		}
+		else {
+			os << '>';
+			r.write(os);
+			os << "</" << tag << '>';
+		}
 	}
 
 	dom::element make_figure(cyng::filesystem::path p
@@ -1930,12 +1552,37 @@ namespace docscript
 		, double width
 		, std::string caption
 		, std::string title
-		, std::string alt)
+		, std::string alt
+		, content_cache* cache
+		, asset_store* assets
+		, bool lazy)
 	{
 		auto const max_width = std::to_string(width * 100.0) + "%";
 		auto const ext = get_extension(p);
+
+		//
+		//	content hash of the image file
+		//
+		auto const hash = (cache != nullptr)
+			? cache->get_hash(p)
+			: std::string()
+			;
+
 		if (boost::algorithm::iequals(ext, "svg")) {
 
+			//
+			//	The patched SVG depends on id, width, caption and precision.
+			//	Change the kind if the generated SVG changes.
+			//	The number of decimal places depends on the size of the 
+			//	drawing: significant digits relative to the viewBox.
+			//
+			std::size_t const digits = 5;
+			auto const key = make_key(hash, "svg.4", id + '\n' + max_width + '\n' + caption + '\n' + std::to_string(digits));
+			std::string src;
+			if (!hash.empty() && cache->get(key, src)) {
+				return dom::figure(dom::id_(id), dom::div(dom::class_("smf-svg"), src), dom::figcaption(title));
+			}
+
 			//
 			//	embedding SVG 
 			//	<figure>
@@ -1973,6 +1620,20 @@ namespace docscript
 						id_attr.set_value(id.c_str());
 					}
 
+					//
+					//	Keep the aspect ratio of the intrinsic size
+					//	if width and height are replaced.
+					//
+					if (!svg.attribute("viewBox")) {
+						auto const w = get_svg_length(svg.attribute("width").value());
+						auto const h = get_svg_length(svg.attribute("height").value());
+						if (w > 0.0 && h > 0.0) {
+							svg.append_attribute("viewBox") = ("0 0 " + std::to_string(w) + " " + std::to_string(h)).c_str();
+						}
+					}
+
+					auto const precision = get_svg_precision(svg, digits);
+
 					//
 					//	fix with and height attribute
 					//
@@ -1994,15 +1655,19 @@ namespace docscript
 					}
 
 					//
-					//	remove private data
+					//	remove private data and editor metadata, 
+					//	reduce precision
 					//
-					svg.remove_attribute("inkscape:export-filename");
+					minify_svg(svg, precision);
 				}
 
 				std::stringstream ss;
 				ss << std::endl;
-				doc.save(ss, "\t", pugi::format_default | pugi::format_no_declaration);
-                auto const src = ss.str();
+				doc.save(ss, "", pugi::format_raw | pugi::format_no_declaration);
+				src = ss.str();
+				if (!hash.empty()) {
+					cache->put(key, src);
+				}
 				return dom::figure(dom::id_(id), dom::div(dom::class_("smf-svg"), src), dom::figcaption(title));
 				//return html::figure(html::id_(id), html::div(html::class_("smf-svg"), src), html::figcaption(title));
 			}
@@ -2015,9 +1680,34 @@ namespace docscript
 			}
 		}
 
+		//
+		//	intrinsic size from image header
+		//
+		auto const dims = get_image_size(p, hash, cache);
+
+		//
+		//	external asset with a relative URL
+		//
+		if (assets != nullptr) {
+			cyng::error_code ec;
+			auto const size = cyng::filesystem::file_size(p, ec);
+			if (!ec && !assets->is_inline(size)) {
+				auto url = assets->emit(p, hash);
+				if (!url.empty()) {
+					return dom::figure(dom::id_(id), make_img(alt, caption, max_width, dims, lazy, dom::attribute("src", std::move(url))), dom::figcaption(title));
+				}
+			}
+		}
+
 		//
 		//	base64 encoded images
 		//
+		auto const key = make_key(hash, "data-uri", ext);
+		std::string uri;
+		if (!hash.empty() && cache->get(key, uri)) {
+			return dom::figure(dom::id_(id), make_img(alt, caption, max_width, dims, lazy, dom::attribute("src", std::move(uri))), dom::figcaption(title));
+		}
+
 		std::ifstream ifs(p.string(), std::ios::binary | std::ios::ate);
 		//
 		//	do not skip 
@@ -2033,8 +1723,8 @@ namespace docscript
 		//
 		//	read into buffer
 		//
-		cyng::buffer_t buffer(size);
-		ifs.read(buffer.data(), size);
+		auto buffer = std::make_shared<cyng::buffer_t>(size);
+		ifs.read(buffer->data(), size);
 		BOOST_ASSERT(ifs.gcount() == size);
 
 		//<figure>
@@ -2056,8 +1746,350 @@ namespace docscript
 
         
 		//return html::figure(html::id_(id), html::img(html::alt_(alt), html::title_(caption), html::class_("docscript-img"), html::style_("max-width: " + max_width), html::src_("data:image/" + ext + ";base64," + cyng::crypto::base64_encode(buffer.data(), buffer.size()))), html::figcaption(title));
-		return dom::figure(dom::id_(id), dom::img(dom::alt_(alt), dom::title_(caption), dom::class_("docscript-img"), dom::style_("max-width: " + max_width), dom::src_("data:image/" + ext + ";base64," + cyng::crypto::base64_encode(buffer.data(), buffer.size()))), dom::figcaption(title));
+		if (!hash.empty()) {
+			uri = "data:image/" + ext + ";base64,";
+			uri.reserve(uri.size() + base64_encoded_size(buffer->size()));
+			base64_encode(uri, buffer->data(), buffer->size());
+			cache->put(key, uri);
+			return dom::figure(dom::id_(id), make_img(alt, caption, max_width, dims, lazy, dom::attribute("src", std::move(uri))), dom::figcaption(title));
+		}
+
+		//
+		//	Without a cache the image is encoded directly into the 
+		//	output stream when the element is serialized.
+		//
+		return dom::figure(dom::id_(id), make_img(alt, caption, max_width, dims, lazy, dom::attribute("src", dom::attribute::writer_t([ext, buffer](std::ostream& os) {
+			os << "data:image/" << ext << ";base64,";
+			base64_encode(os, buffer->data(), buffer->size());
+		}))), dom::figcaption(title));
+
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Apply the filter of the specified language. All filters read
+	 * directly from the memory mapped file.
+	 */
+	void convert_code(std::ostream& os
+		, source_file const& src
+		, cyng::filesystem::path const& p
+		, std::string const& language
+		, std::string const& caption
+		, bool line_numbers
+		, boost::uuids::uuid tag)
+	{
+		if (boost::algorithm::iequals(language, "json")) {
+
+			//
+			//	the JSON parser requires a string
+			//
+			os << "<pre class=\"docscript-pre-json\">" << std::endl;
+			json_to_html filter(line_numbers, tag, src.get_offset());
+			filter.convert(os, std::string(src.begin(), src.end()));
+			os << "</pre>" << std::endl;
+
+		}
+		else if (boost::algorithm::equals(language, "C++") || boost::algorithm::iequals(language, "cpp") || boost::algorithm::iequals(language, "h")) {
+
+			os << "<pre class=\"docscript-pre\">" << std::endl;
+			cpp_to_html filter(line_numbers, tag, src.get_offset());
+			filter.convert(os, src.begin(), src.end());
+			os << "</code></pre>" << std::endl;
+		}
+		else if (boost::algorithm::iequals(language, "docscript")) {
+
+			os 
+				<< "<pre class=\"docscript-pre\" title=\""
+				<< caption
+				<< "\"><code contenteditable spellcheck=\"false\">"
+				;
+			docscript_to_html filter(line_numbers, tag, src.get_offset());
+			filter.convert(os, src.begin(), src.end());
+			os << std::endl << "</code></pre>" << std::endl;
+		}
+		else if (boost::algorithm::equals(language, "txt") || boost::algorithm::iequals(language, "text") || boost::algorithm::iequals(language, "verbatim")) {
+
+			os << "<pre class=\"docscript-pre-txt\">" << std::endl;
+			text_to_html filter(line_numbers, tag, src.get_offset());
+			filter.convert(os, src.begin(), src.end());
+			os << "</code></pre>" << std::endl;
+		}
+		else if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
+
+			os << "<pre class=\"docscript-pre-binary\">" << std::endl;
+			binary_to_html filter(line_numbers, tag);
+			filter.convert(os, src.begin(), src.end());
+			os << "</code></pre>" << std::endl;
+		}
+		else if (boost::algorithm::equals(language, "html") || boost::algorithm::iequals(language, "htm")) {
+
+			os << "<pre class=\"docscript-pre-html\">" << std::endl;
+			html_to_html filter(line_numbers, tag);
+			filter.convert(os, std::string(src.begin(), src.end()));
+			os << "</code></pre>" << std::endl;
+		}
+		else if (boost::algorithm::equals(language, "sml")) {
+
+			os << "<pre class=\"docscript-pre-binary\">" << std::endl;
+			try {
+				cyng::buffer_t const inp(src.begin(), src.end());
+				sml_to_html filter(line_numbers, tag, src.get_position());
+				filter.convert(os, inp);
+			}
+			catch (std::exception const& ex) {
+
+				os
+					<< "***error: converting SML file "
+					<< p
+					<< " to html failed with error: "
+					<< ex.what()
+					<< std::endl;
+			}
+			os 
+				<< "</code></pre>" 
+				<< std::endl;
+		}
+		else if (boost::algorithm::equals(language, "ini") || boost::algorithm::iequals(language, "service") || boost::algorithm::iequals(language, "cfg")) {
+
+			os << "<pre class=\"docscript-pre\">" << std::endl;
+			ini_to_html filter(line_numbers, tag, src.get_offset());
+			filter.convert(os, src.begin(), src.end());
+			os << "</code></pre>" << std::endl;
+		}
+		else {
+			os
+				<< "<pre><code>"
+				<< std::endl
+				;
+			os.write(src.begin(), static_cast<std::streamsize>(src.size()));
+			os
+				<< std::endl
+				<< "</code></pre>"
+				<< std::endl
+				;
+		}
+	}
+
+	void render_code(std::ostream& os
+		, cyng::filesystem::path const& p
+		, excerpt const& range
+		, std::string const& language
+		, std::string const& caption
+		, bool line_numbers
+		, boost::uuids::uuid tag
+		, content_cache* cache)
+	{
+		auto const hash = (cache != nullptr)
+			? cache->get_hash(p)
+			: std::string()
+			;
+		auto const key = make_key(hash, "code", language 
+			+ '\n' + (line_numbers ? "1" : "0") 
+			+ '\n' + boost::uuids::to_string(tag) 
+			+ '\n' + std::to_string(range.first_) + '-' + std::to_string(range.last_) + '/' + std::to_string(range.max_size_)
+			+ '\n' + caption);
+		std::string fragment;
+		if (!hash.empty() && cache->get(key, fragment)) {
+			os << fragment;
+			return;
+		}
+
+		source_file const src(p, range);
+		if (!src.is_open()) {
+			std::cerr
+				<< "***error cannot read ["
+				<< p
+				<< "]"
+				<< std::endl;
+			return;
+		}
+		if (src.is_truncated()) {
+			std::cerr
+				<< "***warning: ["
+				<< p
+				<< "] is truncated to "
+				<< src.size()
+				<< " bytes"
+				<< std::endl;
+		}
+
+		if (hash.empty()) {
+
+			//
+			//	stream into the output
+			//
+			convert_code(os, src, p, language, caption, line_numbers, tag);
+		}
+		else {
+			std::ostringstream ss;
+			convert_code(ss, src, p, language, caption, line_numbers, tag);
+			fragment = ss.str();
+			cache->put(key, fragment);
+			os << fragment;
+		}
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Each page is a separate <tbody> element.
+	 */
+	class html_table_writer : public table_writer
+	{
+	public:
+		html_table_writer(std::ostream& os, bool paged, std::string const& notice)
+			: os_(os)
+			, paged_(paged)
+			, notice_(notice)
+			, columns_(0)
+		{}
+
+		virtual void begin_page(std::size_t page, csv_row_t const& header) override
+		{
+			if (page == 0) {
+				columns_ = header.size();
+				os_ << "<thead class=\"docscript-table-head\"><tr class=\"docscript-tr\">";
+				for (auto const& cell : header) {
+					os_ << "<th class=\"docscript-th\">";
+					escape_html(os_, cell);
+					os_ << "</th>";
+				}
+				os_ 
+					<< "</tr></thead>"
+					<< std::endl
+					;
+			}
+			os_ << "<tbody class=\"docscript-table-body\"";
+			if (paged_) {
+				os_ << " data-page=\"" << page << "\"";
+			}
+			os_ 
+				<< ">"
+				<< std::endl
+				;
+		}
+
+		virtual void row(csv_row_t const& row) override
+		{
+			os_ << "<tr class=\"docscript-tr\">";
+			for (auto const& cell : row) {
+				os_ << "<td class=\"docscript-td\">";
+				escape_html(os_, cell);
+				os_ << "</td>";
+			}
+			os_ 
+				<< "</tr>"
+				<< std::endl
+				;
+		}
+
+		virtual void end_page(std::size_t) override
+		{
+			os_ 
+				<< "</tbody>"
+				<< std::endl
+				;
+		}
+
+		virtual void truncated(std::size_t rows) override
+		{
+			os_
+				<< "<tfoot class=\"docscript-table-foot\"><tr class=\"docscript-tr\"><td class=\"docscript-table-truncated\" colspan=\""
+				<< (columns_ == 0 ? 1 : columns_)
+				<< "\">"
+				;
+			escape_html(os_, notice_);
+			os_
+				<< ": "
+				<< rows
+				<< "</td></tr></tfoot>"
+				<< std::endl
+				;
+		}
+
+	private:
+		std::ostream& os_;
+		bool const paged_;
+		std::string const notice_;
+		std::size_t columns_;
+	};
+
+	void render_table(std::ostream& os
+		, cyng::filesystem::path const& p
+		, std::string const& id
+		, std::string const& caption
+		, table_limits const& limits
+		, std::string const& notice)
+	{
+		os
+			<< "<table id=\""
+			<< id
+			<< "\" class=\"docscript-table\">"
+			<< std::endl
+			<< "<caption class=\"docscript-table-caption\">"
+			<< caption
+			<< "</caption>"
+			<< std::endl
+			;
+
+		html_table_writer writer(os, limits.page_size_ != 0, notice);
+		if (!render_csv(p, limits, writer)) {
+			std::cerr
+				<< "***error cannot read CSV file ["
+				<< p
+				<< "]"
+				<< std::endl;
+		}
+
+		os
+			<< "</table>"
+			<< std::endl
+			;
+	}
+
+	dom::element make_img(std::string const& alt
+		, std::string const& caption
+		, std::string const& max_width
+		, image_size_t const& dims
+		, bool lazy
+		, dom::attribute&& src)
+	{
+		auto img = dom::img(dom::alt_(alt), dom::title_(caption), dom::class_("docscript-img"));
+		if (dims.first != 0 && dims.second != 0) {
+
+			//
+			//	The browser reserves the space before the image is loaded.
+			//	"height: auto" keeps the aspect ratio if max-width applies.
+			//
+			img += dom::width_(dims.first);
+			img += dom::height_(dims.second);
+			img += dom::style_("max-width: " + max_width + "; height: auto");
+		}
+		else {
+			img += dom::style_("max-width: " + max_width);
+		}
+		if (lazy) {
+			img += dom::loading_("lazy");
+			img += dom::decoding_("async");
+		}
+		img += std::move(src);
+		return img;
+	}
+
+	image_size_t get_image_size(cyng::filesystem::path const& p, std::string const& hash, content_cache* cache)
+	{
+		if (hash.empty())	return get_image_size(p);
+
+		auto const key = make_key(hash, "size", "");
+		std::string value;
+		if (cache->get(key, value)) {
+			std::istringstream iss(value);
+			image_size_t dims{ 0, 0 };
+			if (iss >> dims.first >> dims.second)	return dims;
+		}
 
+		auto const dims = get_image_size(p);
+		cache->put(key, std::to_string(dims.first) + " " + std::to_string(dims.second));
+		return dims;
 	}
 
 
@@ -6,6 +6,9 @@
  */ 
 
 #include <docscript/generator/gen_md.h>
+#include <docscript/generator/escape.h>
+#include <docscript/generator/source.h>
+#include <docscript/generator/table.h>
 #include "filter/binary_to_md.h"
 
 #include <cyng/vm/generator.h>
@@ -13,10 +16,10 @@
 #include <cyng/value_cast.hpp>
 #include <cyng/numeric_cast.hpp>
 #include <cyng/dom/reader.h>
-#include <cyng/csv.h>
 #include <cyng/io/bom.h>
 #include <cyng/set_cast.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include <boost/algorithm/string.hpp>
@@ -25,17 +28,23 @@
 
 namespace docscript
 {
-	gen_md::gen_md(std::vector< cyng::filesystem::path > const& inc)
-		: generator(inc)
+	gen_md::gen_md(std::vector< cyng::filesystem::path > const& inc, bool sync)
+		: generator(inc, sync)
 	{
 		register_this();
 	}
 
+	void gen_md::reset()
+	{
+		generator::reset();
+		footnotes_.clear();
+	}
+
 	void gen_md::register_this()
 	{
 		generator::register_this();
 
-		vm_.register_function("demo", 0, std::bind(&gen_md::demo, this, std::placeholders::_1));
+		register_function("demo", 0, std::bind(&gen_md::demo, this, std::placeholders::_1));
 
 
 	}
@@ -49,7 +58,7 @@ namespace docscript
 		if (cyng::filesystem::is_directory(p)) {
 			p = p / "out.md";
 		}
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -74,7 +83,7 @@ namespace docscript
 		}
 	}
 
-	std::ofstream& gen_md::emit_file(std::ofstream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
+	std::ostream& gen_md::emit_file(std::ostream& ofs, cyng::vector_t::const_iterator pos, cyng::vector_t::const_iterator end) const
 	{
 		emit_meta(ofs);
 		while (pos != end) {
@@ -90,23 +99,16 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_intrinsic(std::ofstream& ofs, boost::uuids::uuid tag) const
+	std::ostream& gen_md::emit_intrinsic(std::ostream& ofs, boost::uuids::uuid tag) const
 	{
 
-		if (tag == name_gen_("[ToC]")) {
-			emit_toc(ofs, 5);
-		}
-		else if (tag == name_gen_("[ToC-1]")) {
-			emit_toc(ofs, 1);
+		auto const* ph = placeholders_.find(tag);
+		if (ph != nullptr && ph->kind_ == placeholder_kind::TOC) {
+			emit_toc(ofs, ph->param_);
 		}
-		else if (tag == name_gen_("[ToC-2]")) {
-			emit_toc(ofs, 2);
-		}
-		else if (tag == name_gen_("[ToC-3]")) {
-			emit_toc(ofs, 3);
-		}
-		else if (tag == name_gen_("[ToC-4]")) {
-			emit_toc(ofs, 4);
+		else if (ph != nullptr && ph->kind_ == placeholder_kind::DEFERRED) {
+			emit_deferred(ofs, ph->param_);
+			ofs << std::endl;
 		}
 		else {
 			ofs
@@ -118,7 +120,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_toc(std::ofstream& ofs, std::size_t depth) const
+	std::ostream& gen_md::emit_toc(std::ostream& ofs, std::size_t depth) const
 	{
 
 		ofs
@@ -127,7 +129,7 @@ namespace docscript
 			<< std::endl
 			;
 
-		auto const toc = serialize(content_table_);
+		auto const& toc = serialize(content_table_);
 		emit_toc(ofs, toc, 0, depth);
 
 		ofs
@@ -137,7 +139,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_toc(std::ofstream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
+	std::ostream& gen_md::emit_toc(std::ostream& ofs, cyng::vector_t const& toc, std::size_t level, std::size_t depth) const
 	{
 		bool const descend = level + 1 < depth;
 		for (auto const& header : toc) {
@@ -174,7 +176,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_obj(std::ofstream& ofs, cyng::object obj) const
+	std::ostream& gen_md::emit_obj(std::ostream& ofs, cyng::object obj) const
 	{
 		ofs
 			<< cyng::io::to_str(obj)
@@ -183,7 +185,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_meta(std::ofstream& ofs) const
+	std::ostream& gen_md::emit_meta(std::ostream& ofs) const
 	{
 		//	meta data nor supported by github
 		for (auto const& e : meta_) {
@@ -201,7 +203,7 @@ namespace docscript
 		return ofs;
 	}
 
-	std::ofstream& gen_md::emit_footnotes(std::ofstream& ofs) const
+	std::ostream& gen_md::emit_footnotes(std::ostream& ofs) const
 	{
 		if (!footnotes_.empty()) {
 
@@ -242,7 +244,7 @@ namespace docscript
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 
 		auto const p = cyng::value_cast(frame.at(0), cyng::filesystem::path());
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -295,7 +297,7 @@ namespace docscript
 		//	. dot
 		//	! exclamation mark
 		//
-		ctx.push(cyng::make_object(replace_md_entities(str)));
+		push_text(ctx, replace_md_entities(str));
 	}
 
 	void gen_md::print_symbol(cyng::context& ctx)
@@ -423,7 +425,7 @@ namespace docscript
 			<< text
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 		
 	}
 	
@@ -472,7 +474,7 @@ namespace docscript
 				<< std::endl;
 		}
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::link(cyng::context& ctx)
@@ -497,7 +499,7 @@ namespace docscript
 			<< '"'
 			<< ')'
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::figure(cyng::context& ctx)
@@ -523,7 +525,7 @@ namespace docscript
 			<< ")"
 			<< std::endl
 			;
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::gallery(cyng::context& ctx)
@@ -545,30 +547,37 @@ namespace docscript
 		auto const p = resolve_path(source);
 		auto const language = cyng::value_cast(reader.get("language"), get_extension(p));
 
+		//
+		//	optional line range (1-based, inclusive) and size limit
+		//
+		excerpt const range{
+			cyng::numeric_cast<std::size_t>(reader.get("first"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("last"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("maxsize"), 0u)
+		};
+
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			std::stringstream ss;
-			if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
-				// binary mode required
-				std::ifstream  ifs(p.string(), std::ios::binary);
-				ifs.unsetf(std::ios::skipws);
-				cyng::buffer_t const inp((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-				binary_to_md filter(line_numbers, uuid_gen_());
-				filter.convert(ss, inp);
-			}
-			else {
-				std::ifstream  ifs(p.string());
-				ss
-					<< std::string(3, '`')
-					<< language
-					<< std::endl
-					<< ifs.rdbuf()
-					<< std::endl
-					<< std::string(3, '`')
-					<< std::endl
-					;
-			}
-			ctx.push(cyng::make_object(ss.str()));
+			push_deferred(ctx, [p, range, language, line_numbers, tag = uuid_gen_()](std::ostream& os) {
+				source_file const src(p, range);
+				if (boost::algorithm::equals(language, "bin") || boost::algorithm::iequals(language, "binary")) {
+					binary_to_md filter(line_numbers, tag);
+					filter.convert(os, src.begin(), src.end());
+				}
+				else {
+					os
+						<< std::string(3, '`')
+						<< language
+						<< std::endl
+						;
+					os.write(src.begin(), static_cast<std::streamsize>(src.size()));
+					os
+						<< std::endl
+						<< std::string(3, '`')
+						<< std::endl
+						;
+				}
+			});
 
 		}
 		else {
@@ -612,7 +621,7 @@ namespace docscript
 				;
 		}
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::annotation(cyng::context& ctx)
@@ -629,9 +638,75 @@ namespace docscript
 			<< std::endl
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Table cells are single lines with escaped pipes.
+	 */
+	escape_table const md_cell_entities({
+		{ '|', "\\|" },
+		{ '<', "&lt;" },
+		{ '&', "&amp;" },
+		{ '\n', "<br>" },
+		{ '\r', "" } });
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Markdown has no paging. Each page is a separate table 
+	 * with the same header.
+	 */
+	class md_table_writer : public table_writer
+	{
+	public:
+		md_table_writer(std::ostream& os, std::string const& notice)
+			: os_(os)
+			, notice_(notice)
+		{}
+
+		virtual void begin_page(std::size_t, csv_row_t const& header) override
+		{
+			os_ << std::endl;
+			row(header);
+			for (auto const& cell : header) {
+				//	at least three dashes
+				os_ << "| " << std::string(std::max<std::size_t>(cell.size(), 3), '-') << ' ';
+			}
+			os_ << '|' << std::endl;
+		}
+
+		virtual void row(csv_row_t const& row) override
+		{
+			for (auto const& cell : row) {
+				os_ << "| ";
+				md_cell_entities.write(os_, cell);
+				os_ << ' ';
+			}
+			os_ << '|' << std::endl;
+		}
+
+		virtual void end_page(std::size_t) override
+		{}
+
+		virtual void truncated(std::size_t rows) override
+		{
+			os_
+				<< std::endl
+				<< '*'
+				<< notice_
+				<< ": "
+				<< rows
+				<< '*'
+				<< std::endl
+				;
+		}
+
+	private:
+		std::ostream& os_;
+		std::string const notice_;
+	};
+
 	void gen_md::table(cyng::context& ctx)
 	{
 		auto const frame = ctx.get_frame();
@@ -645,35 +720,28 @@ namespace docscript
 		auto const tag = name_gen_(cyng::value_cast(reader.get("tag"), source));
 		auto const id = boost::uuids::to_string(tag);
 
+		//
+		//	optional row limit and pagination
+		//
+		table_limits const limits{
+			cyng::numeric_cast<std::size_t>(reader.get("maxrows"), 0u),
+			cyng::numeric_cast<std::size_t>(reader.get("pagesize"), 0u)
+		};
+
 		auto const p = resolve_path(source);
 		if (cyng::filesystem::exists(p) && cyng::filesystem::is_regular(p)) {
 
-			//
-			//	parse the CSV file into a vector
-			//
-			auto const csv = cyng::csv::read_file(p.string());
-			std::stringstream ss;
-			ss << std::endl;
-
-			bool initial{ true };
-			for (auto const& row : csv) {
-				cyng::tuple_t tpl;
-				tpl = cyng::value_cast(row, tpl);
-				for (auto const& cell : tpl) {
-					ss << "| " << cyng::io::to_str(cell);
-				}
-				ss << " |" << std::endl;
-				if (initial) {
-					//| ------------ - | ------------ - |
-					for (auto const& cell : tpl) {
-						ss << "| " << std::string(cyng::io::to_str(cell).size(), '-');
-					}
-					ss << " |" << std::endl;
-					initial = false;
-				}
-			}
+			push_deferred(ctx, [p, limits, notice = get_name(i18n::WID_TABLE_TRUNCATED)](std::ostream& os) {
 
-			ctx.push(cyng::make_object(ss.str()));
+				md_table_writer writer(os, notice);
+				if (!render_csv(p, limits, writer)) {
+					std::cerr
+						<< "***error cannot read CSV file ["
+						<< p
+						<< "]"
+						<< std::endl;
+				}
+			});
 		}
 		else {
 
@@ -742,7 +810,7 @@ namespace docscript
 	{
 		auto const frame = ctx.get_frame();
 		std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
-		ctx.push(cyng::make_object(cyng::io::to_str(frame)));
+		push_text(ctx, cyng::io::to_str(frame));
 	}
 
 	void gen_md::make_tok(cyng::context& ctx)
@@ -751,23 +819,7 @@ namespace docscript
 		auto const reader = cyng::make_reader(frame.at(0));
 		auto const level = cyng::numeric_cast<std::size_t>(reader.get("depth"), 3u);
 
-		switch (level) {
-		case 1:
-			ctx.push(cyng::make_object(name_gen_("[ToC-1]")));
-			break;
-		case 2:
-			ctx.push(cyng::make_object(name_gen_("[ToC-2]")));
-			break;
-		case 3:
-			ctx.push(cyng::make_object(name_gen_("[ToC-3]")));
-			break;
-		case 4:
-			ctx.push(cyng::make_object(name_gen_("[ToC-4]")));
-			break;
-		default:
-			ctx.push(cyng::make_object(name_gen_("[ToC]")));
-			break;
-		}
+		ctx.push(cyng::make_object(placeholders_.get_toc(level)));
 
 	}
 
@@ -862,7 +914,7 @@ namespace docscript
 			<< title
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::section(int level, cyng::context& ctx)
@@ -890,7 +942,7 @@ namespace docscript
 			<< title
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::make_footnote(cyng::context& ctx)
@@ -912,7 +964,7 @@ namespace docscript
 			<< ']'
 			;
 
-		ctx.push(cyng::make_object(ss.str()));
+		push_text(ctx, ss.str());
 	}
 
 	void gen_md::demo(cyng::context& ctx)
@@ -927,6 +979,33 @@ namespace docscript
 		ctx.push(cyng::make_object("DEMO"));
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Typographic replacements ("<=", "->") and escaped special characters
+	 */
+	escape_table const md_entities({
+		{ '<', "\\<" },
+		{ '>', "\\>" },
+		{ '!', "\\!" },
+		{ '\\', "\\\\" },
+		{ '`', "\\`" },
+		{ '*', "\\*" },
+		{ '{', "\\{" },
+		{ '}', "\\}" },
+		{ '[', "\\[" },
+		{ ']', "\\]" } }, {
+		{ '<', '=', "&#8804;" },
+		{ '<', '-', "&#10229;" },
+		{ '<', '<', "&#8810;" },
+		{ '>', '=', "&#8805;" },
+		{ '>', '>', "&#8811;" },
+		{ '=', '>', "&#10233;" },
+		{ '=', '=', "&#8801;" },
+		{ '-', '>', "&#10230;" },
+		{ '!', '=', "&#8800;" },
+		{ ':', ':', "&#8759;" },
+		{ ':', '=', "&#8788;" } });
+
 	std::string replace_md_entities(std::string const& str)
 	{
 		//
@@ -944,181 +1023,7 @@ namespace docscript
 		//	. dot
 		//	! exclamation mark
 		//
-
-		//	simple state engine
-		enum {
-			STATE_DEFAULT,
-			STATE_LT,
-			STATE_GT,
-			STATE_EQ,
-			STATE_MINUS,
-			STATE_EXCL,	//!<	"!"
-			STATE_COL,	//!<	":"
-		} state = STATE_DEFAULT;
-
-		std::string r;
-
-		//	small optimization
-		r.reserve(str.length());
-
-		for (auto const c : str) {
-			switch (state) {
-
-			case STATE_LT:
-				switch (c) {
-				case '=':	//	<=
-					r.append("&#8804;");
-					break;
-				case '-':	//	<-
-					r.append("&#10229;");
-					break;
-				case '<':	//	<<
-					r.append("&#8810;");
-					break;
-				default:
-					r += "\\>";
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_GT:
-				switch (c) {
-				case '=':	//	>=
-					r.append("&#8805;");
-					break;
-				case '>':	//	>>
-					r.append("&#8811;");
-					break;
-				default:
-					r.append("\\>");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EQ:
-				switch (c) {
-				case '>':	//	=>
-					r.append("&#10233;");
-					break;
-				case '=':	//	==
-					r.append("&#8801;");
-					break;
-				default:
-					r += '=';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_MINUS:
-				switch (c) {
-				case '>':	//	->
-					r.append("&#10230;");
-					break;
-				default:
-					r += '-';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_EXCL:
-				switch (c) {
-				case '=':	//	!=
-					r.append("&#8800;");
-					break;
-				default:
-					r.append("\\!");
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			case STATE_COL:
-				switch (c) {
-				case ':':	//	::
-					r.append("&#8759;");
-					break;
-				case '=':	//	:=
-					r.append("&#8788;");
-					break;
-				default:
-					r += ':';
-					r += c;
-					break;
-				}
-				state = STATE_DEFAULT;
-				break;
-
-			default:
-				switch (c) {
-				case '<':
-					state = STATE_LT;
-					break;
-				case '>':
-					state = STATE_GT;
-					break;
-				case '=':
-					state = STATE_EQ;
-					break;
-				case '-':
-					state = STATE_MINUS;
-					break;
-				case '!':
-					state = STATE_EXCL;
-					break;
-				case ':':
-					state = STATE_COL;
-					break;
-				case '\\':
-					r.append("\\\\");
-					break;
-				case '`':
-					r.append("\\`");
-					break;
-				case '*':
-					r.append("\\*");
-					break;
-				case '{':
-					r.append("\\{");
-					break;
-				case '}':
-					r.append("\\}");
-					break;
-				case '[':
-					r.append("\\[");
-					break;
-				case ']':
-					r.append("\\]");
-					break;
-				default:
-					r += c;
-					break;
-				}
-				break;
-			}
-		}
-
-		switch (state) {
-
-		case STATE_LT:		r += '<';	break;
-		case STATE_GT:		r.append("\\>");	break;
-		case STATE_EQ:		r += '=';	break;
-		case STATE_MINUS:	r += '-';	break;
-		case STATE_EXCL:	r.append("\\!");	break;
-		case STATE_COL:		r += ':';	break;
-		default:
-			break;
-		}
-
-		return r;
+		return md_entities(str);
 	}
 
 }
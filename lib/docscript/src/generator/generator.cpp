@@ -7,6 +7,7 @@
 
 #include <docscript/generator/generator.h>
 #include "DOCC_project_info.h"
+#include <html/dom.hpp>
 
 #include <cyng/vm/generator.h>
 #include <cyng/io/serializer.h>
@@ -17,32 +18,135 @@
 #include <cyng/intrinsics/version.h>
 
 #include <fstream>
+#include <sstream>
+#include <streambuf>
 #include <boost/algorithm/string.hpp>
+#include <boost/assert.hpp>
 
 namespace docscript
 {
-	generator::generator(std::vector< cyng::filesystem::path > const& inc)
+	/**
+	 * Only visible in this compilation unit.
+	 * Forwards all output and counts the written characters.
+	 */
+	class counting_buffer : public std::streambuf
+	{
+	public:
+		explicit counting_buffer(std::streambuf* target)
+			: target_(target)
+			, size_(0)
+		{}
+
+		std::size_t size() const
+		{
+			return size_;
+		}
+
+	protected:
+		virtual std::streamsize xsputn(char const* s, std::streamsize n) override
+		{
+			auto const r = target_->sputn(s, n);
+			size_ += static_cast<std::size_t>(r);
+			return r;
+		}
+
+		virtual int_type overflow(int_type c) override
+		{
+			if (traits_type::eq_int_type(c, traits_type::eof()))	return traits_type::not_eof(c);
+			++size_;
+			return target_->sputc(traits_type::to_char_type(c));
+		}
+
+		virtual int sync() override
+		{
+			return target_->pubsync();
+		}
+
+	private:
+		std::streambuf* const target_;
+		std::size_t size_;
+	};
+
+	generator::generator(std::vector< cyng::filesystem::path > const& inc, bool sync)
 		: uuid_gen_()
 		, name_gen_(uuid_gen_())
-		, scheduler_()
-		, vm_(scheduler_.get_io_service(), uuid_gen_(), std::cout, std::cerr)
+		, placeholders_(name_gen_)
+		, stable_gen_(boost::uuids::ns::url())
+		, stable_tags_()
+		, sync_(sync)
+		, io_()
+		, scheduler_(sync ? nullptr : std::make_unique<cyng::async::scheduler>())
+		, vm_(sync ? io_ : scheduler_->get_io_service(), uuid_gen_(), std::cout, std::cerr)
 		, vars_()
 		, const_()
 		, includes_(inc)
 		, content_table_()
+		, labels_()
 		, meta_()
+		, profiler_()
+		, produced_(0)
+		, current_()
+		, images_(0)
+		, tracer_(nullptr)
+		, cache_(nullptr)
+		, assets_(nullptr)
+		, workers_(nullptr)
+		, style_sheet_(nullptr)
+		, minify_(false)
+		, precompress_(PRECOMPRESS_NONE)
+		, deferred_()
 	{
 		register_this();
 	}
 
 	generator::~generator()
-	{}
+	{
+		//
+		//	jobs of an aborted document may still be running
+		//
+		for (auto const& d : deferred_) {
+			if (d.result_.valid())	d.result_.wait();
+		}
+	}
 
 	void generator::run(cyng::vector_t&& prg)
 	{
-		vm_.async_run(std::move(prg));
-		vm_.halt();
-		scheduler_.stop();
+		if (sync_) {
+
+			//
+			//	execute all pending operations on the calling thread.
+			//	run() returns when the program is complete.
+			//
+			vm_.async_run(std::move(prg));
+			io_.run();
+
+			//
+			//	ready for next run
+			//
+			io_.restart();
+		}
+		else {
+			vm_.async_run(std::move(prg));
+			vm_.halt();
+			scheduler_->stop();
+		}
+	}
+
+	void generator::reset()
+	{
+		BOOST_ASSERT_MSG(sync_, "reset() requires synchronous mode");
+		vars_.clear();
+		meta_.clear();
+		content_table_.clear();
+		labels_.clear();
+		placeholders_.clear();
+		images_ = 0;
+		stable_tags_.clear();
+		for (auto const& d : deferred_) {
+			if (d.result_.valid())	d.result_.wait();
+		}
+		deferred_.clear();
+		if (profiler_)	profiler_->clear();
 	}
 
 	cyng::param_map_t const& generator::get_meta() const
@@ -50,9 +154,101 @@ namespace docscript
 		return meta_;
 	}
 
+	void generator::set_profiling(bool b)
+	{
+		if (!b)	profiler_.reset();
+		else if (!profiler_)	profiler_ = std::make_unique<profiler>();
+	}
+
+	profiler const* generator::get_profiler() const
+	{
+		return profiler_.get();
+	}
+
+	void generator::set_tracer(tracer* tp)
+	{
+		tracer_ = tp;
+	}
+
+	void generator::set_cache(content_cache* cp)
+	{
+		cache_ = cp;
+	}
+
+	void generator::set_assets(asset_store* ap)
+	{
+		assets_ = ap;
+	}
+
+	void generator::set_workers(worker_pool* wp)
+	{
+		workers_ = wp;
+	}
+
+	void generator::set_style_sheet(style_sheet* sp)
+	{
+		style_sheet_ = sp;
+	}
+
+	void generator::set_minify(bool b)
+	{
+		minify_ = b;
+	}
+
+	void generator::set_precompress(unsigned formats)
+	{
+		precompress_ = formats;
+	}
+
+	void generator::register_function(std::string const& name, std::size_t arity, std::function<void(cyng::context&)> proc)
+	{
+		//
+		//	"generate.file", "generate.meta" and "generate.index" 
+		//	write the output files
+		//
+		bool const writer = boost::algorithm::starts_with(name, "generate.");
+
+		vm_.register_function(name, arity, [this, name, proc, writer](cyng::context& ctx) {
+
+			trace_scope ts(writer ? tracer_ : nullptr, name, "write");
+
+			if (!profiler_) {
+				current_ = origin{ name, std::string(), 0u };
+				proc(ctx);
+				return;
+			}
+
+			//
+			//	The IML contains no source locations. Use the 
+			//	"source" parameter if available.
+			//
+			std::string file;
+			auto const frame = ctx.get_frame();
+			if (!frame.empty() && frame.at(0).get_class().tag() == cyng::TC_PARAM_MAP) {
+				auto const params = cyng::to_param_map(frame.at(0));
+				auto const pos = params.find("source");
+				if (pos != params.end()) {
+					file = cyng::value_cast<std::string>(pos->second, "");
+				}
+			}
+
+			produced_ = 0;
+			current_ = origin{ name, file, profiler_->next_seq() };
+			auto const start = profiler::clock_t::now();
+			proc(ctx);
+			profiler_->record(name, profiler::clock_t::now() - start, produced_, file, 0u);
+		});
+	}
+
+	void generator::push_text(cyng::context& ctx, std::string&& s)
+	{
+		produced_ += s.size();
+		ctx.push(cyng::make_object(std::move(s)));
+	}
+
 	void generator::register_this()
 	{
-		vm_.register_function("now", 0, [](cyng::context& ctx) {
+		register_function("now", 0, [](cyng::context& ctx) {
 
 			//
 			//	produce result value
@@ -61,58 +257,58 @@ namespace docscript
 		});
 
 		//vm_.register_function("generate.meta", 1, std::bind(&gen_md::generate_meta, this, std::placeholders::_1));
-		vm_.register_function("generate.index", 1, std::bind(&generator::generate_index, this, std::placeholders::_1));
-		vm_.register_function("init.meta.data", 1, std::bind(&generator::init_meta_data, this, std::placeholders::_1));
-
-		vm_.register_function("meta", 1, std::bind(&generator::meta, this, std::placeholders::_1));
-		vm_.register_function("set", 1, std::bind(&generator::var_set, this, std::placeholders::_1));
-		vm_.register_function("get", 1, std::bind(&generator::var_get, this, std::placeholders::_1));
-		vm_.register_function("symbol", 1, std::bind(&generator::print_symbol, this, std::placeholders::_1));
-		vm_.register_function("currency", 1, std::bind(&generator::print_currency, this, std::placeholders::_1));
-		vm_.register_function("tag", 1, std::bind(&generator::create_uuid, this, std::placeholders::_1));
-		vm_.register_function("map", 1, std::bind(&generator::make_map, this, std::placeholders::_1));
-		vm_.register_function("version", 0, std::bind(&generator::get_version, this, std::placeholders::_1));
-
-		vm_.register_function("generate.file", 1, std::bind(&generator::generate_file, this, std::placeholders::_1));
-		vm_.register_function("generate.meta", 1, std::bind(&generator::generate_meta, this, std::placeholders::_1));
-
-		vm_.register_function("hline", 0, std::bind(&generator::print_hline, this, std::placeholders::_1));
-
-		vm_.register_function("convert.numeric", 1, std::bind(&generator::convert_numeric, this, std::placeholders::_1));
-		vm_.register_function("convert.alpha", 1, std::bind(&generator::convert_alpha, this, std::placeholders::_1));
-
-		vm_.register_function("paragraph", 1, std::bind(&generator::paragraph, this, std::placeholders::_1));
-		vm_.register_function("abstract", 1, std::bind(&generator::abstract, this, std::placeholders::_1));
-		vm_.register_function("quote", 1, std::bind(&generator::quote, this, std::placeholders::_1));
-		vm_.register_function("list", 1, std::bind(&generator::list, this, std::placeholders::_1));
-		vm_.register_function("link", 1, std::bind(&generator::link, this, std::placeholders::_1));
-		vm_.register_function("figure", 1, std::bind(&generator::figure, this, std::placeholders::_1));
-		vm_.register_function("gallery", 1, std::bind(&generator::gallery, this, std::placeholders::_1));
-		vm_.register_function("code", 1, std::bind(&generator::code, this, std::placeholders::_1));
-		vm_.register_function("def", 1, std::bind(&generator::def, this, std::placeholders::_1));
-		vm_.register_function("note", 1, std::bind(&generator::annotation, this, std::placeholders::_1));
-		vm_.register_function("table", 1, std::bind(&generator::table, this, std::placeholders::_1));
-		vm_.register_function("alert", 1, std::bind(&generator::alert, this, std::placeholders::_1));
-
-		vm_.register_function("i", 1, std::bind(&generator::format_italic, this, std::placeholders::_1));
-		vm_.register_function("b", 1, std::bind(&generator::format_bold, this, std::placeholders::_1));
-		vm_.register_function("bold", 1, std::bind(&generator::format_bold, this, std::placeholders::_1));
-		vm_.register_function("tt", 1, std::bind(&generator::format_tt, this, std::placeholders::_1));
-		vm_.register_function("color", 1, std::bind(&generator::format_color, this, std::placeholders::_1));
-		vm_.register_function("sub", 1, std::bind(&generator::format_sub, this, std::placeholders::_1));
-		vm_.register_function("sup", 1, std::bind(&generator::format_sup, this, std::placeholders::_1));
-		vm_.register_function("mark", 1, std::bind(&generator::format_mark, this, std::placeholders::_1));
-
-		vm_.register_function("header", 1, std::bind(&generator::header, this, std::placeholders::_1));
-		vm_.register_function("h1", 1, std::bind(&generator::section, this, 1, std::placeholders::_1));
-		vm_.register_function("h2", 1, std::bind(&generator::section, this, 2, std::placeholders::_1));
-		vm_.register_function("h3", 1, std::bind(&generator::section, this, 3, std::placeholders::_1));
-		vm_.register_function("h4", 1, std::bind(&generator::section, this, 4, std::placeholders::_1));
-		vm_.register_function("h5", 1, std::bind(&generator::section, this, 5, std::placeholders::_1));
-		vm_.register_function("h6", 1, std::bind(&generator::section, this, 6, std::placeholders::_1));
-		vm_.register_function("footnote", 1, std::bind(&generator::make_footnote, this, std::placeholders::_1));
-		vm_.register_function("ref", 1, std::bind(&generator::make_ref, this, std::placeholders::_1));
-		vm_.register_function("toc", 1, std::bind(&generator::make_tok, this, std::placeholders::_1));
+		register_function("generate.index", 1, std::bind(&generator::generate_index, this, std::placeholders::_1));
+		register_function("init.meta.data", 1, std::bind(&generator::init_meta_data, this, std::placeholders::_1));
+
+		register_function("meta", 1, std::bind(&generator::meta, this, std::placeholders::_1));
+		register_function("set", 1, std::bind(&generator::var_set, this, std::placeholders::_1));
+		register_function("get", 1, std::bind(&generator::var_get, this, std::placeholders::_1));
+		register_function("symbol", 1, std::bind(&generator::print_symbol, this, std::placeholders::_1));
+		register_function("currency", 1, std::bind(&generator::print_currency, this, std::placeholders::_1));
+		register_function("tag", 1, std::bind(&generator::create_uuid, this, std::placeholders::_1));
+		register_function("map", 1, std::bind(&generator::make_map, this, std::placeholders::_1));
+		register_function("version", 0, std::bind(&generator::get_version, this, std::placeholders::_1));
+
+		register_function("generate.file", 1, std::bind(&generator::generate_file, this, std::placeholders::_1));
+		register_function("generate.meta", 1, std::bind(&generator::generate_meta, this, std::placeholders::_1));
+
+		register_function("hline", 0, std::bind(&generator::print_hline, this, std::placeholders::_1));
+
+		register_function("convert.numeric", 1, std::bind(&generator::convert_numeric, this, std::placeholders::_1));
+		register_function("convert.alpha", 1, std::bind(&generator::convert_alpha, this, std::placeholders::_1));
+
+		register_function("paragraph", 1, std::bind(&generator::paragraph, this, std::placeholders::_1));
+		register_function("abstract", 1, std::bind(&generator::abstract, this, std::placeholders::_1));
+		register_function("quote", 1, std::bind(&generator::quote, this, std::placeholders::_1));
+		register_function("list", 1, std::bind(&generator::list, this, std::placeholders::_1));
+		register_function("link", 1, std::bind(&generator::link, this, std::placeholders::_1));
+		register_function("figure", 1, std::bind(&generator::figure, this, std::placeholders::_1));
+		register_function("gallery", 1, std::bind(&generator::gallery, this, std::placeholders::_1));
+		register_function("code", 1, std::bind(&generator::code, this, std::placeholders::_1));
+		register_function("def", 1, std::bind(&generator::def, this, std::placeholders::_1));
+		register_function("note", 1, std::bind(&generator::annotation, this, std::placeholders::_1));
+		register_function("table", 1, std::bind(&generator::table, this, std::placeholders::_1));
+		register_function("alert", 1, std::bind(&generator::alert, this, std::placeholders::_1));
+
+		register_function("i", 1, std::bind(&generator::format_italic, this, std::placeholders::_1));
+		register_function("b", 1, std::bind(&generator::format_bold, this, std::placeholders::_1));
+		register_function("bold", 1, std::bind(&generator::format_bold, this, std::placeholders::_1));
+		register_function("tt", 1, std::bind(&generator::format_tt, this, std::placeholders::_1));
+		register_function("color", 1, std::bind(&generator::format_color, this, std::placeholders::_1));
+		register_function("sub", 1, std::bind(&generator::format_sub, this, std::placeholders::_1));
+		register_function("sup", 1, std::bind(&generator::format_sup, this, std::placeholders::_1));
+		register_function("mark", 1, std::bind(&generator::format_mark, this, std::placeholders::_1));
+
+		register_function("header", 1, std::bind(&generator::header, this, std::placeholders::_1));
+		register_function("h1", 1, std::bind(&generator::section, this, 1, std::placeholders::_1));
+		register_function("h2", 1, std::bind(&generator::section, this, 2, std::placeholders::_1));
+		register_function("h3", 1, std::bind(&generator::section, this, 3, std::placeholders::_1));
+		register_function("h4", 1, std::bind(&generator::section, this, 4, std::placeholders::_1));
+		register_function("h5", 1, std::bind(&generator::section, this, 5, std::placeholders::_1));
+		register_function("h6", 1, std::bind(&generator::section, this, 6, std::placeholders::_1));
+		register_function("footnote", 1, std::bind(&generator::make_footnote, this, std::placeholders::_1));
+		register_function("ref", 1, std::bind(&generator::make_ref, this, std::placeholders::_1));
+		register_function("toc", 1, std::bind(&generator::make_tok, this, std::placeholders::_1));
 
 	}
 
@@ -194,7 +390,7 @@ namespace docscript
 		//std::cout << ctx.get_name() << " - " << cyng::io::to_str(frame) << std::endl;
 
 		auto const p = cyng::value_cast(frame.at(0), cyng::filesystem::path()) / "index.json";
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -205,7 +401,8 @@ namespace docscript
 		}
 		else
 		{
-			auto const index = serialize(content_table_);
+			ofs.precompress(precompress_);
+			auto const& index = serialize(content_table_);
 			//std::cout << cyng::io::to_str(index) << std::endl;
 			std::string const json = cyng::json::to_string(index);
 			//std::cout << json << std::endl;
@@ -287,6 +484,110 @@ namespace docscript
 		ctx.push(cyng::make_object(cyng::revision(DOCC_VERSION_MAJOR, DOCC_VERSION_MINOR, DOCC_VERSION_PATCH, DOCC_VERSION_TWEAK)));
 	}
 
+	void generator::make_placeholder(placeholder_kind kind, cyng::context& ctx)
+	{
+		ctx.push(cyng::make_object(placeholders_.get(kind)));
+	}
+
+	boost::uuids::uuid generator::make_stable_tag(std::string const& name)
+	{
+		auto const n = ++stable_tags_[name];
+		return stable_gen_(name + '#' + std::to_string(n));
+	}
+
+	void generator::push_deferred(cyng::context& ctx, writer_f writer)
+	{
+		auto const tag = uuid_gen_();
+		placeholders_.add(tag, placeholder_kind::DEFERRED, deferred_.size());
+		if (workers_ == nullptr) {
+			deferred_.push_back(deferred{ std::move(writer), std::shared_future<std::string>(), current_ });
+		}
+		else {
+			//
+			//	profiled and traced on the worker thread
+			//
+			deferred_.push_back(deferred{ writer_f(), workers_->submit([writer, o = current_, tracer = tracer_, prof = profiler_.get()]() {
+				trace_scope ts(tracer, o.name_, "render");
+				if (!o.file_.empty())	ts.arg("file", o.file_);
+				std::ostringstream ss;
+				auto const start = profiler::clock_t::now();
+				writer(ss);
+				auto s = ss.str();
+				if (prof != nullptr)	prof->add(o.name_, profiler::clock_t::now() - start, s.size(), o.file_, o.seq_);
+				return s;
+			}), current_ });
+		}
+		ctx.push(cyng::make_object(tag));
+	}
+
+	void generator::emit_deferred(std::ostream& os, std::size_t idx) const
+	{
+		if (idx >= deferred_.size())	return;
+
+		auto const& d = deferred_.at(idx);
+		try {
+			if (d.writer_) {
+				//
+				//	the time and output of the writer belong to the
+				//	build-in function that pushed it
+				//
+				trace_scope ts(d.origin_.name_.empty() ? nullptr : tracer_, d.origin_.name_, "render");
+				if (!profiler_ || d.origin_.name_.empty()) {
+					d.writer_(os);
+					return;
+				}
+				counting_buffer cb(os.rdbuf());
+				std::ostream cos(&cb);
+				auto const start = profiler::clock_t::now();
+				d.writer_(cos);
+				profiler_->add(d.origin_.name_, profiler::clock_t::now() - start, cb.size(), d.origin_.file_, d.origin_.seq_);
+			}
+			else {
+				os << d.result_.get();
+			}
+		}
+		catch (std::exception const& ex) {
+			std::cerr
+				<< "***error: deferred build-in function #"
+				<< idx
+				<< " failed: "
+				<< ex.what()
+				<< std::endl;
+		}
+	}
+
+	void generator::push_element(cyng::context& ctx, dom::element&& el, std::size_t depth)
+	{
+		//
+		//	serializing is cheap - never on a worker thread
+		//
+		push_writer(ctx, [el = std::move(el), depth](std::ostream& os) {
+			el.write(os, depth);
+		});
+	}
+
+	void generator::push_writer(cyng::context& ctx, writer_f f)
+	{
+		auto const tag = uuid_gen_();
+		placeholders_.add(tag, placeholder_kind::DEFERRED, deferred_.size());
+		deferred_.push_back(deferred{ std::move(f), std::shared_future<std::string>(), current_ });
+		ctx.push(cyng::make_object(tag));
+	}
+
+	std::size_t generator::indent(std::size_t d) const
+	{
+		return minify_ ? dom::minified : d;
+	}
+
+	bool generator::is_lazy_image()
+	{
+		//
+		//	the first two images are probably visible 
+		//	without scrolling
+		//
+		return ++images_ > 2;
+	}
+
 	cyng::filesystem::path generator::resolve_path(std::string const& s) const
 	{
 		cyng::filesystem::path p(s);
@@ -457,12 +758,81 @@ namespace docscript
 				break;
 			}
 			return "Table of Contents";
+		case i18n::WID_TABLE_TRUNCATED:
+			switch (get_language_code()) {
+			case cyng::io::LC_ES: return "Tabla truncada, filas mostradas";
+			case cyng::io::LC_SV: return "Tabellen förkortad, visade rader";
+			case cyng::io::LC_PT: return "Tabela truncada, linhas exibidas";
+			case cyng::io::LC_DE: return "Tabelle gekürzt, angezeigte Zeilen";
+			case cyng::io::LC_FI: return "Taulukko katkaistu, näytetyt rivit";
+			case cyng::io::LC_FR: return "Tableau tronqué, lignes affichées";
+			case cyng::io::LC_IT: return "Tabella troncata, righe visualizzate";
+			case cyng::io::LC_NN: return "Tabellen forkortet, viste rader";
+			case cyng::io::LC_NL: return "Tabel ingekort, getoonde rijen";
+			default:
+				break;
+			}
+			return "Table truncated, rows shown";
 		default:
 			break;
 		}
 		return "";
 	}
 
+	std::string generator::get_label_text(label const& lbl) const
+	{
+		switch (lbl.kind_) {
+		case label_kind::FIGURE:
+			return get_name(i18n::WID_FIGURE) + " " + lbl.number_;
+		case label_kind::TABLE:
+			return get_name(i18n::WID_TABLE) + " " + lbl.number_;
+		case label_kind::FOOTNOTE:
+			return "[" + lbl.number_ + "]";
+		default:
+			break;
+		}
+		return lbl.number_;
+	}
+
+	std::string generator::get_ref_text(std::size_t idx) const
+	{
+		auto const* ref = labels_.get_ref(idx);
+		if (ref == nullptr)	return std::string();
+		if (!ref->text_.empty())	return ref->text_;
+
+		auto const* lbl = labels_.find(ref->tag_);
+		return (lbl != nullptr)
+			? get_label_text(*lbl)
+			: ref->name_
+			;
+	}
+
+	std::string generator::resolve_plain(std::string const& str) const
+	{
+		return resolve_markers(str, std::bind(&generator::get_ref_text, this, std::placeholders::_1));
+	}
+
+	void generator::resolve_meta()
+	{
+		if (!labels_.has_refs())	return;
+		for (auto& e : meta_) {
+			switch (e.second.get_class().tag()) {
+			case cyng::TC_STRING:
+			case cyng::TC_VECTOR:
+			case cyng::TC_TUPLE:
+			{
+				auto const s = accumulate_plain_text(e.second);
+				if (s.find(label_table::marker) != std::string::npos) {
+					e.second = cyng::make_object(resolve_plain(s));
+				}
+			}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
 	std::string get_extension(cyng::filesystem::path const& p)
 	{
 		if (p.empty())
@@ -473,51 +843,89 @@ namespace docscript
 		return s.substr(1);
 	}
 
-	std::string accumulate_plain_text(cyng::object obj)
+	std::string accumulate_plain_text(cyng::object const& obj)
+	{
+		rope r;
+		accumulate_plain_text(r, obj);
+		return r.str();
+	}
+
+	std::string accumulate_plain_text(cyng::tuple_t const& tpl)
+	{
+		rope r;
+		accumulate_plain_text(r, tpl);
+		return r.str();
+	}
+
+	std::string accumulate_plain_text(cyng::vector_t const& vec)
+	{
+		rope r;
+		accumulate_plain_text(r, vec);
+		return r.str();
+	}
+
+	void accumulate_plain_text(rope& r, cyng::object const& obj)
 	{
 		switch (obj.get_class().tag()) {
 		case cyng::TC_TUPLE:
-			return accumulate_plain_text(cyng::value_cast(obj, cyng::tuple_t()));
+			accumulate_plain_text(r, *cyng::object_cast<cyng::tuple_t>(obj));
+			return;
 		case cyng::TC_VECTOR:
-			return accumulate_plain_text(cyng::value_cast(obj, cyng::vector_t()));
+			accumulate_plain_text(r, *cyng::object_cast<cyng::vector_t>(obj));
+			return;
 		case cyng::TC_NULL:
-			return "";
+			return;
+		case cyng::TC_STRING:
+			r.append(std::string_view(*cyng::object_cast<std::string>(obj)));
+			return;
 		case cyng::TC_TIME_POINT:
-			return cyng::to_str(cyng::value_cast(obj, std::chrono::system_clock::now()));
+			r.append(cyng::to_str(cyng::value_cast(obj, std::chrono::system_clock::now())));
+			return;
 		default:
 			break;
 		}
-		return cyng::io::to_str(obj);
+		r.append(cyng::io::to_str(obj));
 	}
 
-	std::string accumulate_plain_text(cyng::tuple_t tpl)
+	/**
+	 * Only visible in this compilation unit.
+	 * The parts are separated by a blank. There is no blank in front
+	 * of closing punctuation and after an opening bracket.
+	 */
+	template <typename C>
+	void accumulate_parts(rope& r, C const& parts)
 	{
-		std::string text;
-		for (auto const& obj : tpl) {
-			std::string const s = accumulate_plain_text(obj);
-			if (!text.empty() 
-				&& !(s == "." || s == "," || s == ":" || s == "?" || s == "!" || s == ")" || s == "]" || s == "}")
-				&& !(text.back() == '(' || text.back() == '[' || text.back() == '{')) {
-				text.append(1, ' ');
+		auto const start = r.size();
+		for (auto const& obj : parts) {
+			auto const pos = r.size();
+			if (pos == start) {
+				accumulate_plain_text(r, obj);
+				continue;
+			}
+
+			//
+			//	the blank depends on the next part
+			//
+			auto const prev = r.back();
+			auto const slot = r.mark();
+			accumulate_plain_text(r, obj);
+
+			auto const c = (r.size() == pos + 1) ? r.back() : '\0';
+			if (!(c == '.' || c == ',' || c == ':' || c == '?' || c == '!' || c == ')' || c == ']' || c == '}')
+				&& !(prev == '(' || prev == '[' || prev == '{')) {
+				r.fill(slot, " ");
 			}
-			text.append(s);
 		}
-		return text;
 	}
 
-	std::string accumulate_plain_text(cyng::vector_t vec)
+	void accumulate_plain_text(rope& r, cyng::tuple_t const& tpl)
 	{
-		std::string text;
-		for (auto const& obj : vec) {
-			std::string const s = accumulate_plain_text(obj);
-			if (!text.empty() 
-				&& !(s == "." || s == "," || s == ":" || s == "?" || s == "!" || s == ")" || s == "]" || s == "}")
-				&& !(text.back() == '(' || text.back() == '[' || text.back() == '{')) {
-				text.append(1, ' ');
-			}
-			text.append(s);
-		}
-		return text;
+		accumulate_parts(r, tpl);
+	}
+
+	void accumulate_plain_text(rope& r, cyng::vector_t const& vec)
+	{
+		accumulate_parts(r, vec);
 	}
 
 	std::string generate_slug(std::string title)
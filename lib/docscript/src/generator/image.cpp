@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/image.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	std::uint32_t get_be16(unsigned char const* p)
+	{
+		return (std::uint32_t(p[0]) << 8) | p[1];
+	}
+	std::uint32_t get_be32(unsigned char const* p)
+	{
+		return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | p[3];
+	}
+	std::uint32_t get_le16(unsigned char const* p)
+	{
+		return (std::uint32_t(p[1]) << 8) | p[0];
+	}
+	std::uint32_t get_le24(unsigned char const* p)
+	{
+		return (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[1]) << 8) | p[0];
+	}
+
+	/**
+	 * Parse image header. The reader is a callable with the signature
+	 * bool(std::size_t offset, unsigned char* dst, std::size_t n).
+	 */
+	template <typename R>
+	image_size_t parse_image_header(R read)
+	{
+		//
+		//	small GIF files are shorter than the header buffer
+		//
+		std::array<unsigned char, 32> h{};
+		if (!read(0, h.data(), h.size()) && !read(0, h.data(), 10))	return { 0, 0 };
+
+		//
+		//	PNG: signature + IHDR chunk
+		//
+		if (std::memcmp(h.data(), "\x89PNG\r\n\x1a\n", 8) == 0 && std::memcmp(h.data() + 12, "IHDR", 4) == 0) {
+			return { get_be32(h.data() + 16), get_be32(h.data() + 20) };
+		}
+
+		//
+		//	GIF: logical screen descriptor
+		//
+		if (std::memcmp(h.data(), "GIF87a", 6) == 0 || std::memcmp(h.data(), "GIF89a", 6) == 0) {
+			return { get_le16(h.data() + 6), get_le16(h.data() + 8) };
+		}
+
+		//
+		//	WebP: lossy, lossless or extended format
+		//
+		if (std::memcmp(h.data(), "RIFF", 4) == 0 && std::memcmp(h.data() + 8, "WEBP", 4) == 0) {
+			if (std::memcmp(h.data() + 12, "VP8 ", 4) == 0) {
+				return { get_le16(h.data() + 26) & 0x3fff, get_le16(h.data() + 28) & 0x3fff };
+			}
+			if (std::memcmp(h.data() + 12, "VP8L", 4) == 0 && h[20] == 0x2f) {
+				std::uint32_t const bits = get_le16(h.data() + 21) | (get_le16(h.data() + 23) << 16);
+				return { (bits & 0x3fff) + 1, ((bits >> 14) & 0x3fff) + 1 };
+			}
+			if (std::memcmp(h.data() + 12, "VP8X", 4) == 0) {
+				return { get_le24(h.data() + 24) + 1, get_le24(h.data() + 27) + 1 };
+			}
+			return { 0, 0 };
+		}
+
+		//
+		//	JPEG: walk through all segments until a SOFn marker
+		//	is found
+		//
+		if (h[0] == 0xff && h[1] == 0xd8) {
+			std::size_t pos = 2;
+			std::array<unsigned char, 9> seg;
+			while (read(pos, seg.data(), 4)) {
+				if (seg[0] != 0xff)	break;
+				auto const marker = seg[1];
+				if (marker == 0xff) {
+					//	fill byte
+					++pos;
+					continue;
+				}
+				if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7)) {
+					//	standalone marker
+					pos += 2;
+					continue;
+				}
+				if (marker == 0xd9 || marker == 0xda) {
+					//	end of image, start of scan
+					break;
+				}
+				if (marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc) {
+					if (!read(pos, seg.data(), seg.size()))	break;
+					return { get_be16(seg.data() + 7), get_be16(seg.data() + 5) };
+				}
+				pos += 2 + get_be16(seg.data() + 2);
+			}
+		}
+
+		return { 0, 0 };
+	}
+
+	image_size_t get_image_size(cyng::filesystem::path const& p)
+	{
+		std::ifstream ifs(p.string(), std::ios::binary);
+		if (!ifs.is_open())	return { 0, 0 };
+
+		return parse_image_header([&ifs](std::size_t offset, unsigned char* dst, std::size_t n) -> bool {
+			ifs.clear();
+			ifs.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+			ifs.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n));
+			return ifs.gcount() == static_cast<std::streamsize>(n);
+		});
+	}
+
+	image_size_t get_image_size(char const* p, std::size_t size)
+	{
+		return parse_image_header([p, size](std::size_t offset, unsigned char* dst, std::size_t n) -> bool {
+			if (offset + n > size)	return false;
+			std::memcpy(dst, p + offset, n);
+			return true;
+		});
+	}
+}
@@ -0,0 +1,222 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/labels.h>
+#include <docscript/generator/escape.h>
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	char_set const markers(std::string_view(&label_table::marker, 1));
+
+	label_table::label_table()
+		: labels_()
+		, refs_()
+	{}
+
+	bool label_table::add(boost::uuids::uuid const& tag, label_kind kind, std::string number, std::string caption)
+	{
+		return labels_.emplace(tag, label{ kind, std::move(number), std::move(caption) }).second;
+	}
+
+	label const* label_table::find(boost::uuids::uuid const& tag) const
+	{
+		auto const pos = labels_.find(tag);
+		return (pos != labels_.end())
+			? &pos->second
+			: nullptr
+			;
+	}
+
+	std::string label_table::add_ref(boost::uuids::uuid const& tag, std::string name, std::string text)
+	{
+		std::string m(1, marker);
+		m.append(std::to_string(refs_.size())).append(1, marker);
+		refs_.push_back(reference{ tag, std::move(name), std::move(text) });
+		return m;
+	}
+
+	reference const* label_table::get_ref(std::size_t idx) const
+	{
+		return (idx < refs_.size())
+			? &refs_.at(idx)
+			: nullptr
+			;
+	}
+
+	bool label_table::has_refs() const
+	{
+		return !refs_.empty();
+	}
+
+	std::size_t label_table::report_dangling() const
+	{
+		std::size_t count{ 0 };
+		for (auto const& ref : refs_) {
+			if (find(ref.tag_) == nullptr) {
+				++count;
+				std::cerr
+					<< "***warning: reference to undefined label ["
+					<< ref.name_
+					<< ']'
+					<< std::endl;
+			}
+		}
+		return count;
+	}
+
+	void label_table::clear()
+	{
+		labels_.clear();
+		refs_.clear();
+	}
+
+	label_buffer::label_buffer(std::streambuf* target, resolver_f resolver)
+		: target_(target)
+		, resolver_(resolver)
+		, buffer_(0x1000)
+		, open_(false)
+		, index_()
+	{
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	label_buffer::~label_buffer()
+	{
+		close();
+	}
+
+	void label_buffer::close()
+	{
+		process_buffer();
+		if (open_)	write_pending();
+	}
+
+	label_buffer::int_type label_buffer::overflow(int_type c)
+	{
+		process_buffer();
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize label_buffer::xsputn(char const* s, std::streamsize n)
+	{
+		auto const avail = static_cast<std::streamsize>(epptr() - pptr());
+		if (n <= avail) {
+			std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+			pbump(static_cast<int>(n));
+		}
+		else {
+			process_buffer();
+			process(s, static_cast<std::size_t>(n));
+		}
+		return n;
+	}
+
+	int label_buffer::sync()
+	{
+		//
+		//	like the sink: std::endl doesn't write anything
+		//
+		return 0;
+	}
+
+	void label_buffer::process_buffer()
+	{
+		process(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	void label_buffer::process(char const* s, std::size_t n)
+	{
+		auto const* end = s + n;
+		while (s != end) {
+			if (!open_) {
+
+				//
+				//	copy text up to the next marker
+				//
+				auto const* pos = markers.find(s, end);
+				if (pos != s)	target_->sputn(s, pos - s);
+				if (pos == end)	break;
+
+				open_ = true;
+				index_.clear();
+				s = pos + 1;
+			}
+			else if (*s == label_table::marker) {
+				if (index_.empty()) {
+
+					//
+					//	two marker characters - the first is text
+					//
+					target_->sputc(label_table::marker);
+				}
+				else {
+					auto const r = resolver_(std::stoul(index_));
+					target_->sputn(r.data(), static_cast<std::streamsize>(r.size()));
+					open_ = false;
+				}
+				++s;
+			}
+			else if (*s >= '0' && *s <= '9' && index_.size() < 9) {
+				index_.push_back(*s);
+				++s;
+			}
+			else {
+
+				//
+				//	not a marker
+				//
+				write_pending();
+			}
+		}
+	}
+
+	void label_buffer::write_pending()
+	{
+		target_->sputc(label_table::marker);
+		target_->sputn(index_.data(), static_cast<std::streamsize>(index_.size()));
+		index_.clear();
+		open_ = false;
+	}
+
+	label_stream::label_stream(std::ostream& os, label_buffer::resolver_f resolver)
+		: std::ostream(nullptr)
+		, buffer_(os.rdbuf(), resolver)
+	{
+		rdbuf(&buffer_);
+	}
+
+	label_stream::~label_stream()
+	{
+		buffer_.close();
+	}
+
+	std::string resolve_markers(std::string const& str, label_buffer::resolver_f const& resolver)
+	{
+		auto const* end = str.data() + str.size();
+		if (markers.find(str.data(), end) == end)	return str;
+
+		std::stringbuf sb;
+		{
+			label_buffer lb(&sb, resolver);
+			lb.sputn(str.data(), static_cast<std::streamsize>(str.size()));
+		}
+		return sb.str();
+	}
+}
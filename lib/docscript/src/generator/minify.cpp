@@ -0,0 +1,445 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/minify.h>
+
+#include <cctype>
+#include <cstring>
+#include <initializer_list>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	bool is_one_of(std::string const& name, std::initializer_list<char const*> names)
+	{
+		for (auto const n : names) {
+			if (name == n)	return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Whitespace next to these tags is not rendered.
+	 */
+	bool is_block_tag(std::string const& name)
+	{
+		return is_one_of(name, {
+			"html", "head", "body", "meta", "link", "title", "style",
+			"div", "p", "ul", "ol", "li", "dl", "dt", "dd",
+			"table", "caption", "thead", "tbody", "tfoot", "tr", "td", "th",
+			"figure", "figcaption", "section", "nav", "header", "footer", "main", "article", "aside",
+			"h1", "h2", "h3", "h4", "h5", "h6", "hr", "br", "pre",
+			"details", "summary", "blockquote", "form", "fieldset", "address", "option" });
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * End tags that are implied by the next sibling or the end of the parent.
+	 */
+	bool is_optional_end_tag(std::string const& name)
+	{
+		return is_one_of(name, { "li", "dt", "dd", "tr", "td", "th", "option" });
+	}
+
+	/**
+	 * Only visible in this compilation unit
+	 */
+	bool is_space(char c)
+	{
+		return std::isspace(static_cast<unsigned char>(c)) != 0;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Attribute values without whitespace and special characters
+	 * need no quotes.
+	 */
+	bool is_unquotable(std::string const& value)
+	{
+		if (value.empty())	return false;
+		for (auto const c : value) {
+			if (is_space(c) || std::strchr("\"'=<>`", c) != nullptr)	return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * No whitespace required before and after these characters in CSS.
+	 */
+	bool is_css_delimiter(char c)
+	{
+		return c != '\0' && std::strchr("{};,>", c) != nullptr;
+	}
+
+	minify_buffer::minify_buffer(std::streambuf* target)
+		: target_(target)
+		, buffer_(0x1000)
+		, out_()
+		, state_(state::TEXT)
+		, tag_()
+		, quote_(0)
+		, space_(false)
+		, block_(true)
+		, last_(0)
+		, end_()
+		, match_(0)
+	{
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	minify_buffer::~minify_buffer()
+	{
+		close();
+	}
+
+	void minify_buffer::close()
+	{
+		process_buffer();
+
+		//
+		//	incomplete markup
+		//
+		out_.clear();
+		if (state_ == state::TAG) {
+			out_.append(tag_);
+		}
+		else if (state_ == state::RAW || state_ == state::STYLE) {
+			out_.append(end_, 0, match_);
+		}
+		if (!out_.empty())	target_->sputn(out_.data(), static_cast<std::streamsize>(out_.size()));
+
+		out_.clear();
+		tag_.clear();
+		match_ = 0;
+		state_ = state::TEXT;
+	}
+
+	minify_buffer::int_type minify_buffer::overflow(int_type c)
+	{
+		process_buffer();
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize minify_buffer::xsputn(char const* s, std::streamsize n)
+	{
+		auto const avail = static_cast<std::streamsize>(epptr() - pptr());
+		if (n <= avail) {
+			std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+			pbump(static_cast<int>(n));
+		}
+		else {
+			process_buffer();
+			process(s, static_cast<std::size_t>(n));
+		}
+		return n;
+	}
+
+	int minify_buffer::sync()
+	{
+		//
+		//	like the sink: std::endl doesn't write anything
+		//
+		return 0;
+	}
+
+	void minify_buffer::process_buffer()
+	{
+		process(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	void minify_buffer::process(char const* s, std::size_t n)
+	{
+		out_.clear();
+		for (auto const* end = s + n; s != end; ++s) {
+			switch (state_) {
+			case state::TEXT:		text(*s);		break;
+			case state::TAG:		tag(*s);		break;
+			case state::COMMENT:	comment(*s);	break;
+			case state::RAW:		raw(*s);		break;
+			case state::STYLE:		style(*s);		break;
+			default:
+				break;
+			}
+		}
+		if (!out_.empty())	target_->sputn(out_.data(), static_cast<std::streamsize>(out_.size()));
+	}
+
+	void minify_buffer::text(char c)
+	{
+		if (c == '<') {
+			tag_.assign(1, c);
+			quote_ = 0;
+			state_ = state::TAG;
+		}
+		else if (is_space(c)) {
+			space_ = true;
+		}
+		else {
+			emit_space();
+			out_.push_back(c);
+			block_ = false;
+		}
+	}
+
+	void minify_buffer::tag(char c)
+	{
+		if (quote_ != 0) {
+			tag_.push_back(c);
+			if (c == quote_)	quote_ = 0;
+			return;
+		}
+
+		if (tag_.size() == 1 && !(std::isalpha(static_cast<unsigned char>(c)) || c == '/' || c == '!' || c == '?')) {
+
+			//
+			//	not a tag
+			//
+			tag_.clear();
+			state_ = state::TEXT;
+			emit_space();
+			out_.push_back('<');
+			block_ = false;
+			text(c);
+			return;
+		}
+
+		tag_.push_back(c);
+		if (tag_ == "<!--") {
+			tag_.clear();
+			match_ = 0;
+			state_ = state::COMMENT;
+		}
+		else if (c == '"' || c == '\'') {
+			quote_ = c;
+		}
+		else if (c == '>') {
+			emit_tag();
+			tag_.clear();
+		}
+	}
+
+	void minify_buffer::comment(char c)
+	{
+		if (c == '-') {
+			++match_;
+		}
+		else if (c == '>' && match_ > 1) {
+			match_ = 0;
+			state_ = state::TEXT;
+		}
+		else {
+			match_ = 0;
+		}
+	}
+
+	void minify_buffer::raw(char c)
+	{
+		if (!match_end(c))	out_.push_back(c);
+	}
+
+	void minify_buffer::style(char c)
+	{
+		if (quote_ != 0) {
+			out_.push_back(c);
+			if (c == quote_)	quote_ = 0;
+			return;
+		}
+		if (match_end(c))	return;
+
+		if (is_space(c)) {
+			space_ = true;
+			return;
+		}
+
+		if (space_ && !is_css_delimiter(last_) && !is_css_delimiter(c)) {
+			out_.push_back(' ');
+		}
+		space_ = false;
+
+		if (c == '"' || c == '\'')	quote_ = c;
+		out_.push_back(c);
+		last_ = c;
+	}
+
+	bool minify_buffer::match_end(char c)
+	{
+		if (match_ < end_.size() && std::tolower(static_cast<unsigned char>(c)) == end_.at(match_)) {
+			if (++match_ == end_.size()) {
+
+				//
+				//	continue with the end tag
+				//
+				tag_ = end_;
+				quote_ = 0;
+				match_ = 0;
+				space_ = false;
+				state_ = state::TAG;
+			}
+			return true;
+		}
+
+		//
+		//	false alarm
+		//
+		out_.append(end_, 0, match_);
+		match_ = (c == '<') ? 1 : 0;
+		return match_ != 0;
+	}
+
+	void minify_buffer::emit_space()
+	{
+		if (space_ && !block_)	out_.push_back(' ');
+		space_ = false;
+	}
+
+	void minify_buffer::emit_tag()
+	{
+		state_ = state::TEXT;
+
+		//
+		//	doctype and processing instructions
+		//
+		if (tag_.at(1) == '!' || tag_.at(1) == '?') {
+			out_.append(tag_);
+			space_ = false;
+			block_ = true;
+			return;
+		}
+
+		bool const closing = tag_.at(1) == '/';
+		std::size_t pos = closing ? 2 : 1;
+		auto const last = tag_.size() - 1;	//	'>'
+
+		std::string name;
+		while (pos < last && (std::isalnum(static_cast<unsigned char>(tag_.at(pos))) || tag_.at(pos) == '-' || tag_.at(pos) == ':')) {
+			name.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(tag_.at(pos)))));
+			++pos;
+		}
+
+		bool const block = is_block_tag(name);
+		if (closing && is_optional_end_tag(name)) {
+			space_ = false;
+			block_ = true;
+			return;
+		}
+
+		if (block) {
+			space_ = false;
+		}
+		else {
+			emit_space();
+		}
+		block_ = block;
+
+		out_.append(tag_, 0, pos);
+
+		//
+		//	attributes
+		//
+		bool self_closing{ false };
+		for (;;) {
+			while (pos < last && is_space(tag_.at(pos)))	++pos;
+			if (pos >= last)	break;
+
+			if (tag_.at(pos) == '/') {
+				out_.push_back('/');
+				self_closing = true;
+				++pos;
+				continue;
+			}
+
+			auto const start = pos;
+			while (pos < last && !is_space(tag_.at(pos)) && std::strchr("=/", tag_.at(pos)) == nullptr)	++pos;
+			if (pos == start) {
+				//	stray character
+				out_.push_back(tag_.at(pos++));
+				continue;
+			}
+			out_.push_back(' ');
+			out_.append(tag_, start, pos - start);
+			self_closing = false;
+
+			auto next = pos;
+			while (next < last && is_space(tag_.at(next)))	++next;
+			if (next >= last || tag_.at(next) != '=')	continue;
+
+			//
+			//	value
+			//
+			pos = next + 1;
+			while (pos < last && is_space(tag_.at(pos)))	++pos;
+			out_.push_back('=');
+			if (pos < last && (tag_.at(pos) == '"' || tag_.at(pos) == '\'')) {
+				auto const q = tag_.at(pos);
+				auto close = tag_.find(q, pos + 1);
+				if (close == std::string::npos || close > last)	close = last;
+				auto const value = tag_.substr(pos + 1, close - pos - 1);
+				pos = (close < last) ? close + 1 : last;
+
+				//
+				//	"<br class=x/>" would be part of the value
+				//
+				next = pos;
+				while (next < last && is_space(tag_.at(next)))	++next;
+				if (is_unquotable(value) && (next >= last || tag_.at(next) != '/')) {
+					out_.append(value);
+				}
+				else {
+					out_.push_back(q);
+					out_.append(value);
+					out_.push_back(q);
+				}
+			}
+			else {
+				auto const value = pos;
+				while (pos < last && !is_space(tag_.at(pos)))	++pos;
+				out_.append(tag_, value, pos - value);
+			}
+		}
+		out_.push_back('>');
+
+		if (closing || self_closing)	return;
+
+		//
+		//	content that is not minified
+		//
+		if (is_one_of(name, { "pre", "textarea", "script" })) {
+			end_ = "</" + name;
+			match_ = 0;
+			state_ = state::RAW;
+		}
+		else if (name == "style") {
+			end_ = "</style";
+			match_ = 0;
+			quote_ = 0;
+			space_ = false;
+			last_ = '{';
+			state_ = state::STYLE;
+		}
+	}
+
+	minify_stream::minify_stream(std::ostream& os)
+		: std::ostream(nullptr)
+		, buffer_(os.rdbuf())
+	{
+		rdbuf(&buffer_);
+	}
+
+	minify_stream::~minify_stream()
+	{
+		buffer_.close();
+	}
+}
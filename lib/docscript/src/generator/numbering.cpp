@@ -15,99 +15,111 @@
 namespace docscript
 {
 	numbering::numbering()
-		: tag_(boost::uuids::nil_uuid())
-		, title_()
-		, next_()
-		, sub_()
-	{}
-
-	numbering::numbering(boost::uuids::uuid tag, std::string title)
-		: tag_(tag)
-		, title_(title)
-		, next_()
-		, sub_()
-	{}
-
-	numbering::~numbering()
-	{}
-
-	std::string numbering::add(std::size_t level, boost::uuids::uuid tag, std::string title)
+		: entries_()
+		, path_()
+		, outline_()
+		, valid_(false)
 	{
-		std::vector<std::size_t> vec;
-		vec.push_back(0u);
-		add(vec, level, new numbering(tag, title));
-		return get_numbering(vec);
+		clear();
 	}
 
-	void numbering::add(std::vector<std::size_t>& vec, std::size_t level, numbering* cp)
+	std::string numbering::add(std::size_t level, boost::uuids::uuid tag, std::string title)
 	{
 		//
-		//	root flag - fix the first (empty entry)
-		//
-		bool const root = vec.at(0) == 0u;
-
-		//
-		//	current numbering index
-		//
-		auto const idx = vec.size() - 1;
-
-		//
-		//	walk down vertically to current/last entry
+		//	walk down the current path as long as the last entry
+		//	has children
 		//
-		numbering* ptr = this;
-		while (ptr->next_) {
-			ptr = ptr->next_.get();
-			++vec.at(idx);
+		std::size_t depth = 1;
+		while (depth < level && path_.size() > depth) {
+			++depth;
 		}
 
-		if (vec.size() < level) {
-
+		std::size_t idx = 0;
+		if (depth < level) {
 
-			if (!ptr->sub_) {
+			//
+			//	first child of the last entry
+			//
+			if (depth + 1 < level) {
 				//
-				//	increase depth
+				//	cannot skip indentation level
 				//
-				vec.push_back(1u);
-				if (vec.size() < level) {
-					//
-					//	cannot skip indentation level
-					//
-					std::cerr
-						<< "***error cannot skip indentation level ["
-						<< cp->title_
-						<< ']'
-						<< std::endl;
-				}
-				ptr->add_sub(cp);
-			}
-			else {
-				//
-				//	walk down horizontally to current/last entry
-				//
-				if (level - vec.size() > 1) {
-					vec.push_back(1u);
-				}
-				else {
-					vec.push_back(2u);
-				}
-				ptr->sub_->add(vec, level, cp);
+				std::cerr
+					<< "***error cannot skip indentation level ["
+					<< title
+					<< ']'
+					<< std::endl;
 			}
+			idx = append(path_.at(depth - 1), depth + 1, 1u, tag, title);
+			path_.push_back(idx);
 		}
 		else {
-			if (root) {
-				++vec.at(idx);
-			}
-			ptr->add_next(cp);
+
+			//
+			//	next sibling of the last entry on this level
+			//
+			auto const& prev = entries_.at(path_.at(depth - 1));
+			idx = append((depth > 1) ? path_.at(depth - 2) : entries_.size(), depth, prev.index_ + 1, tag, title);
+			path_.resize(depth);
+			path_.back() = idx;
 		}
+
+		valid_ = false;
+		return entries_.at(idx).number_;
+	}
+
+	std::size_t numbering::append(std::size_t parent, std::size_t depth, std::size_t index, boost::uuids::uuid tag, std::string const& title)
+	{
+		auto number = (parent < entries_.size())
+			? entries_.at(parent).number_ + '.'
+			: std::string()
+			;
+		number.append(std::to_string(index));
+
+		entries_.push_back(entry{ tag, title, number, depth, index });
+		return entries_.size() - 1;
+	}
+
+	void numbering::clear()
+	{
+		entries_.clear();
+		path_.clear();
+		outline_.clear();
+		valid_ = false;
+
+		entries_.push_back(entry{ boost::uuids::nil_uuid(), std::string(), "0", 1u, 0u });
+		path_.push_back(0u);
 	}
 
-	void numbering::add_next(numbering* c)
+	std::vector<numbering::entry> const& numbering::get_entries() const
 	{
-		next_.reset(c);
+		return entries_;
 	}
-	void numbering::add_sub(numbering* c)
+
+	cyng::vector_t numbering::serialize(std::size_t& pos, std::size_t depth) const
 	{
-		sub_.reset(c);
+		cyng::vector_t vec;
+		while (pos < entries_.size() && entries_.at(pos).depth_ == depth) {
+
+			auto const& e = entries_.at(pos++);
+			if (pos < entries_.size() && entries_.at(pos).depth_ > depth) {
+				//	has child(ren)
+				auto params = cyng::param_map_factory("tag", e.tag_)
+					("title", e.title_)
+					("number", e.number_)
+					("depth", depth)
+					("sub", serialize(pos, depth + 1))();
+				vec.push_back(params);
+			}
+			else {
+				auto params = cyng::param_map_factory("tag", e.tag_)
+					("title", e.title_)
+					("number", e.number_)
+					("depth", depth)();
+				vec.push_back(params);
+			}
+		}
+		return vec;
 	}
 
 	std::string get_numbering(std::vector<std::size_t> const& vec)
@@ -122,74 +134,21 @@ namespace docscript
 		return r;
 	}
 
-	cyng::vector_t serialize(numbering const& n)
-	{
-		//
-		//	skip first entry
-		//
-		if (n.next_) {
-
-			std::vector<std::size_t> number;
-			number.push_back(1u);
-			return serialize(1, n.next_.get(), number);
-
-		}
-
-		return cyng::vector_t();
-	}
-
-	cyng::vector_t serialize(std::size_t depth, numbering const* p, std::vector<std::size_t> number)
+	cyng::vector_t const& serialize(numbering const& n)
 	{
-		cyng::vector_t vec;
-
-		//std::cout 
-		//	<< "serialize " 
-		//	<< std::string(depth, '.' ) 
-		//	<< ": " 
-		//	<< p->title_ 
-		//	<< std::endl;
-
-		if (p->sub_) {
-			//	has child(ren)
-
-			//std::cout
-			//	<< get_numbering(number)
-			//	<< ' '
-			//	<< p->title_
-			//	<< std::endl;
-
-			auto tmp = number;
-			tmp.push_back(1);
-			auto params = cyng::param_map_factory("tag", p->tag_)
-				("title", p->title_)
-				("number", get_numbering(number))
-				("depth", depth)
-				("sub", serialize(depth + 1, p->sub_.get(), tmp))();
-			vec.push_back(params);
-		}
-		else {
-			//std::cout
-			//	<< get_numbering(number)
-			//	<< ' '
-			//	<< p->title_
-			//	<< std::endl;
-
-			auto params = cyng::param_map_factory("tag", p->tag_)
-				("title", p->title_)
-				("number", get_numbering(number))
-				("depth", depth)();
-			vec.push_back(params);
-		}
-
-		if (p->next_) {
-			//	has sibling(s)
-
-			++number.back();
-			auto const v = serialize(depth, p->next_.get(), number);
-			vec.insert(vec.end(), v.begin(), v.end());
+		if (!n.valid_) {
+
+			//
+			//	skip the root entry and all entries below
+			//
+			std::size_t pos = 1;
+			while (pos < n.entries_.size() && n.entries_.at(pos).depth_ > 1) {
+				++pos;
+			}
+			n.outline_ = n.serialize(pos, 1);
+			n.valid_ = true;
 		}
-
-		return vec;
+		return n.outline_;
 	}
 
 	element::element(boost::uuids::uuid tag, std::string note)
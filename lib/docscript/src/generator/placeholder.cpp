@@ -0,0 +1,70 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/generator/placeholder.h>
+
+namespace docscript
+{
+	placeholders::placeholders(boost::uuids::name_generator_sha1 const& gen)
+		: toc_{ { gen("[ToC-1]"), gen("[ToC-2]"), gen("[ToC-3]"), gen("[ToC-4]"), gen("[ToC]") } }
+		, lof_(gen("[LoF]"))
+		, lot_(gen("[LoT]"))
+		, footnotes_(gen("[Footnotes]"))
+		, map_()
+	{
+		clear();
+	}
+
+	boost::uuids::uuid placeholders::get_toc(std::size_t depth) const
+	{
+		return (depth > 0 && depth < max_toc_depth)
+			? toc_.at(depth - 1)
+			: toc_.back()
+			;
+	}
+
+	boost::uuids::uuid placeholders::get(placeholder_kind kind) const
+	{
+		switch (kind) {
+		case placeholder_kind::LIST_OF_FIGURES:	return lof_;
+		case placeholder_kind::LIST_OF_TABLES:	return lot_;
+		case placeholder_kind::FOOTNOTES:	return footnotes_;
+		default:
+			break;
+		}
+		return toc_.back();
+	}
+
+	placeholder const* placeholders::find(boost::uuids::uuid const& tag) const
+	{
+		auto const pos = map_.find(tag);
+		return (pos != map_.end())
+			? &pos->second
+			: nullptr
+			;
+	}
+
+	void placeholders::add(boost::uuids::uuid const& tag, placeholder_kind kind, std::size_t param)
+	{
+		map_.emplace(tag, placeholder{ kind, param });
+	}
+
+	void placeholders::clear()
+	{
+		map_.clear();
+
+		//
+		//	intrinsic markers
+		//
+		for (std::size_t depth = 1; depth <= max_toc_depth; ++depth) {
+			map_.emplace(toc_.at(depth - 1), placeholder{ placeholder_kind::TOC, depth });
+		}
+		map_.emplace(lof_, placeholder{ placeholder_kind::LIST_OF_FIGURES, 0 });
+		map_.emplace(lot_, placeholder{ placeholder_kind::LIST_OF_TABLES, 0 });
+		map_.emplace(footnotes_, placeholder{ placeholder_kind::FOOTNOTES, 0 });
+	}
+}
@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/generator/pool.h>
+#include <docscript/generator/gen_html.h>
+#include <docscript/generator/gen_md.h>
+#include <docscript/generator/gen_asciidoc.h>
+#include <docscript/generator/gen_LaTeX.h>
+#include <docscript/generator/gen_bootstrap.h>
+
+#include <boost/algorithm/string.hpp>
+
+namespace docscript
+{
+	generator_pool::generator_pool(std::vector< cyng::filesystem::path > const& inc)
+		: includes_(inc)
+		, mutex_()
+		, idle_()
+	{}
+
+	std::shared_ptr<generator> generator_pool::acquire(std::string const& format)
+	{
+		std::unique_ptr<generator> gp;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto pos = idle_.find(format);
+			if (pos != idle_.end() && !pos->second.empty()) {
+				gp = std::move(pos->second.back());
+				pos->second.pop_back();
+			}
+		}
+
+		if (!gp) {
+
+			//
+			//	no idle generator available
+			//
+			gp = make_generator(format, includes_);
+			if (!gp)	return std::shared_ptr<generator>();
+		}
+
+		return std::shared_ptr<generator>(gp.release(), [this, format](generator* p) {
+			release(format, p);
+		});
+	}
+
+	void generator_pool::release(std::string const& format, generator* p)
+	{
+		std::unique_ptr<generator> gp(p);
+
+		//
+		//	prepare for next document
+		//
+		gp->reset();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		idle_[format].push_back(std::move(gp));
+	}
+
+	std::size_t generator_pool::size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::size_t count{ 0 };
+		for (auto const& e : idle_) {
+			count += e.second.size();
+		}
+		return count;
+	}
+
+	std::unique_ptr<generator> make_generator(std::string const& format, std::vector< cyng::filesystem::path > const& inc)
+	{
+		if (boost::algorithm::equals(format, "html")) {
+			return std::make_unique<gen_html>(inc, false, true);
+		}
+		else if (boost::algorithm::equals(format, "html-body")) {
+			return std::make_unique<gen_html>(inc, true, true);
+		}
+		else if (boost::algorithm::equals(format, "md")) {
+			return std::make_unique<gen_md>(inc, true);
+		}
+		else if (boost::algorithm::equals(format, "asciidoc")) {
+			return std::make_unique<gen_asciidoc>(inc, true);
+		}
+		else if (boost::algorithm::equals(format, "tex")) {
+			return std::make_unique<gen_latex>(inc, true);
+		}
+		else if (boost::algorithm::equals(format, "bootstrap")) {
+			return std::make_unique<gen_bootstrap>(inc, true);
+		}
+		return std::unique_ptr<generator>();
+	}
+
+	std::string get_format(std::string const& extension, bool body_only)
+	{
+		if (boost::algorithm::iequals(extension, ".html")) {
+			return (body_only)
+				? "html-body"
+				: "html"
+				;
+		}
+		else if (boost::algorithm::iequals(extension, ".md")) {
+			return "md";
+		}
+		else if (boost::algorithm::iequals(extension, ".asciidoc")
+			|| boost::algorithm::iequals(extension, ".adoc")
+			|| boost::algorithm::iequals(extension, ".asc")) {
+			return "asciidoc";
+		}
+		else if (boost::algorithm::iequals(extension, ".tex")) {
+			return "tex";
+		}
+		return "";
+	}
+
+}
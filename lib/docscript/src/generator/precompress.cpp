@@ -0,0 +1,370 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/precompress.h>
+#include <docscript/generator/cache.h>
+#include <docscript/generator/source.h>
+
+#include <openssl/evp.h>
+
+#ifdef DOCSCRIPT_ZLIB_INSTALLED
+#include <zlib.h>
+#endif
+#ifdef DOCSCRIPT_ZSTD_INSTALLED
+#include <zstd.h>
+#endif
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit.
+	 * Length of a SHA-256 hex string.
+	 */
+	constexpr std::size_t hash_size = 64;
+
+	/**
+	 * Only visible in this compilation unit.
+	 *
+	 * @return the hash stored at the specified offset of an existing
+	 * sidecar or an empty string
+	 */
+	std::string read_stored_hash(cyng::filesystem::path const& p, std::size_t offset)
+	{
+		std::FILE* f = std::fopen(p.string().c_str(), "rb");
+		if (f == nullptr)	return std::string();
+
+		std::array<char, hash_size> buffer;
+		auto const b = std::fseek(f, static_cast<long>(offset), SEEK_SET) == 0
+			&& std::fread(buffer.data(), 1, buffer.size(), f) == buffer.size();
+		std::fclose(f);
+
+		return b
+			? std::string(buffer.data(), buffer.size())
+			: std::string()
+			;
+	}
+
+	unsigned precompress_formats()
+	{
+		unsigned formats = PRECOMPRESS_NONE;
+#ifdef DOCSCRIPT_ZLIB_INSTALLED
+		formats |= PRECOMPRESS_GZIP;
+#endif
+#ifdef DOCSCRIPT_ZSTD_INSTALLED
+		formats |= PRECOMPRESS_ZSTD;
+#endif
+		return formats;
+	}
+
+	/**
+	 * Compressed copy in a temporary file. The hash is written
+	 * as placeholder and patched when the content is complete.
+	 */
+	struct precompressor::sidecar
+	{
+		sidecar(cyng::filesystem::path const& p, char const* ext, std::size_t offset)
+			: target_(p.string() + ext)
+			, tmp_(p.string() + ext + ".tmp")
+			, offset_(offset)
+			, file_(std::fopen(tmp_.string().c_str(), "wb"))
+			, good_(file_ != nullptr)
+		{
+			if (!good_) {
+				std::cerr
+					<< "***error cannot open output file ["
+					<< tmp_
+					<< ']'
+					<< std::endl;
+			}
+		}
+
+		virtual ~sidecar()
+		{
+			if (file_ != nullptr) {
+				std::fclose(file_);
+				std::remove(tmp_.string().c_str());
+			}
+		}
+
+		virtual void write(char const* s, std::size_t n) = 0;
+
+		/**
+		 * flush the compressor
+		 */
+		virtual void finish() = 0;
+
+		void append(void const* p, std::size_t n)
+		{
+			if (good_ && n != 0) {
+				good_ = std::fwrite(p, 1, n, file_) == n;
+			}
+		}
+
+		/**
+		 * Write the hash and replace the existing sidecar
+		 */
+		bool commit(std::string const& hash)
+		{
+			if (file_ == nullptr)	return false;
+
+			good_ = good_
+				&& std::fseek(file_, static_cast<long>(offset_), SEEK_SET) == 0
+				&& std::fwrite(hash.data(), 1, hash.size(), file_) == hash.size();
+			good_ = (std::fclose(file_) == 0) && good_;
+			file_ = nullptr;
+
+			cyng::error_code ec;
+			if (good_) {
+				cyng::filesystem::rename(tmp_, target_, ec);
+			}
+			if (!good_ || ec) {
+				std::cerr
+					<< "***error cannot write ["
+					<< target_
+					<< ']'
+					<< std::endl;
+				cyng::filesystem::remove(tmp_, ec);
+				return false;
+			}
+			return true;
+		}
+
+		cyng::filesystem::path const target_;
+		cyng::filesystem::path const tmp_;
+
+		/**
+		 * position of the hash in the file
+		 */
+		std::size_t const offset_;
+
+		std::FILE* file_;
+		bool good_;
+		std::array<unsigned char, 0x4000> out_;
+	};
+
+#ifdef DOCSCRIPT_ZLIB_INSTALLED
+	/**
+	 * The hash is the file comment of the gzip header. It follows
+	 * the fixed part of 10 bytes since there is no extra field and
+	 * no file name.
+	 */
+	struct precompressor::gzip_sidecar : precompressor::sidecar
+	{
+		static constexpr char const* extension = ".gz";
+		static constexpr std::size_t hash_offset = 10;
+
+		explicit gzip_sidecar(cyng::filesystem::path const& p)
+			: sidecar(p, extension, hash_offset)
+			, comment_(hash_size, '0')
+			, header_()
+			, zs_()
+		{
+			//
+			//	windowBits + 16 writes a gzip header
+			//
+			good_ = good_ && deflateInit2(&zs_, Z_BEST_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 9, Z_DEFAULT_STRATEGY) == Z_OK;
+
+			//
+			//	no timestamp - the output is reproducible
+			//
+			header_.os = 255;
+			header_.comment = reinterpret_cast<Bytef*>(&comment_[0]);
+			if (good_)	deflateSetHeader(&zs_, &header_);
+		}
+
+		virtual ~gzip_sidecar()
+		{
+			deflateEnd(&zs_);
+		}
+
+		virtual void write(char const* s, std::size_t n) override
+		{
+			zs_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(s));
+			zs_.avail_in = static_cast<uInt>(n);
+			deflate(Z_NO_FLUSH);
+		}
+
+		virtual void finish() override
+		{
+			zs_.next_in = nullptr;
+			zs_.avail_in = 0;
+			deflate(Z_FINISH);
+		}
+
+	private:
+		void deflate(int flush)
+		{
+			while (good_) {
+				zs_.next_out = out_.data();
+				zs_.avail_out = static_cast<uInt>(out_.size());
+				auto const rc = ::deflate(&zs_, flush);
+				if (rc == Z_STREAM_ERROR) {
+					good_ = false;
+					break;
+				}
+				append(out_.data(), out_.size() - zs_.avail_out);
+
+				if (flush == Z_FINISH ? rc == Z_STREAM_END : zs_.avail_out != 0)	break;
+			}
+		}
+
+	private:
+		std::string comment_;
+		gz_header header_;
+		z_stream zs_;
+	};
+#endif
+
+#ifdef DOCSCRIPT_ZSTD_INSTALLED
+	/**
+	 * The hash is stored in a skippable frame in front of the
+	 * compressed data. Decoders ignore this frame.
+	 */
+	struct precompressor::zstd_sidecar : precompressor::sidecar
+	{
+		static constexpr char const* extension = ".zst";
+		static constexpr std::size_t hash_offset = 8;
+
+		explicit zstd_sidecar(cyng::filesystem::path const& p)
+			: sidecar(p, extension, hash_offset)
+			, cctx_(ZSTD_createCCtx())
+		{
+			good_ = good_ && cctx_ != nullptr;
+			if (good_) {
+				ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, ZSTD_maxCLevel());
+				ZSTD_CCtx_setParameter(cctx_, ZSTD_c_checksumFlag, 1);
+
+				//
+				//	With an unknown content size the ultra levels allocate
+				//	their full window (more than 100 MB). A 2 MB window is
+				//	sufficient for all documents.
+				//
+				ZSTD_CCtx_setParameter(cctx_, ZSTD_c_windowLog, 21);
+				ZSTD_CCtx_setParameter(cctx_, ZSTD_c_hashLog, 21);
+				ZSTD_CCtx_setParameter(cctx_, ZSTD_c_chainLog, 21);
+			}
+
+			//
+			//	magic number 0x184D2A5E and frame size (little endian)
+			//
+			unsigned char const frame[] = { 0x5E, 0x2A, 0x4D, 0x18, static_cast<unsigned char>(hash_size), 0, 0, 0 };
+			append(frame, sizeof(frame));
+			append(std::string(hash_size, '0').data(), hash_size);
+		}
+
+		virtual ~zstd_sidecar()
+		{
+			ZSTD_freeCCtx(cctx_);
+		}
+
+		virtual void write(char const* s, std::size_t n) override
+		{
+			ZSTD_inBuffer in{ s, n, 0 };
+			while (good_ && in.pos < in.size) {
+				ZSTD_outBuffer out{ out_.data(), out_.size(), 0 };
+				good_ = !ZSTD_isError(ZSTD_compressStream2(cctx_, &out, &in, ZSTD_e_continue));
+				append(out_.data(), out.pos);
+			}
+		}
+
+		virtual void finish() override
+		{
+			ZSTD_inBuffer in{ nullptr, 0, 0 };
+			while (good_) {
+				ZSTD_outBuffer out{ out_.data(), out_.size(), 0 };
+				auto const remaining = ZSTD_compressStream2(cctx_, &out, &in, ZSTD_e_end);
+				good_ = !ZSTD_isError(remaining);
+				append(out_.data(), out.pos);
+				if (remaining == 0)	break;
+			}
+		}
+
+	private:
+		ZSTD_CCtx* cctx_;
+	};
+#endif
+
+	struct precompressor::digest
+	{
+		digest()
+			: ctx_(EVP_MD_CTX_new(), &EVP_MD_CTX_free)
+		{
+			EVP_DigestInit_ex(ctx_.get(), EVP_sha256(), nullptr);
+		}
+
+		std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx_;
+	};
+
+	precompressor::precompressor(cyng::filesystem::path const& p, unsigned formats)
+		: path_(p)
+		, formats_(formats)
+		, digest_(std::make_unique<digest>())
+	{}
+
+	precompressor::~precompressor()
+	{}
+
+	void precompressor::write(char const* s, std::size_t n)
+	{
+		EVP_DigestUpdate(digest_->ctx_.get(), s, n);
+	}
+
+	bool precompressor::close()
+	{
+		std::array<unsigned char, EVP_MAX_MD_SIZE> md;
+		unsigned int len{ 0 };
+		EVP_DigestFinal_ex(digest_->ctx_.get(), md.data(), &len);
+		auto const hash = to_hex(md.data(), len);
+
+		//
+		//	sidecars with a different hash or without a sidecar
+		//
+		std::vector<std::unique_ptr<sidecar>> sidecars;
+#ifdef DOCSCRIPT_ZLIB_INSTALLED
+		if ((formats_ & PRECOMPRESS_GZIP) != 0 
+			&& read_stored_hash(path_.string() + gzip_sidecar::extension, gzip_sidecar::hash_offset) != hash) {
+			sidecars.push_back(std::make_unique<gzip_sidecar>(path_));
+		}
+#endif
+#ifdef DOCSCRIPT_ZSTD_INSTALLED
+		if ((formats_ & PRECOMPRESS_ZSTD) != 0 
+			&& read_stored_hash(path_.string() + zstd_sidecar::extension, zstd_sidecar::hash_offset) != hash) {
+			sidecars.push_back(std::make_unique<zstd_sidecar>(path_));
+		}
+#endif
+		if (sidecars.empty())	return true;
+
+		//
+		//	compress the complete file
+		//
+		source_file const src(path_);
+		if (!src.is_open())	return false;
+
+		bool r{ true };
+		for (auto& sc : sidecars) {
+			sc->write(src.begin(), src.size());
+			sc->finish();
+			r = sc->commit(hash) && r;
+		}
+		return r;
+	}
+
+	bool precompress_file(cyng::filesystem::path const& p, unsigned formats)
+	{
+		source_file const src(p);
+		if (!src.is_open())	return false;
+
+		precompressor pc(p, formats);
+		pc.write(src.begin(), static_cast<std::size_t>(src.end() - src.begin()));
+		return pc.close();
+	}
+}
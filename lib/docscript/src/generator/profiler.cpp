@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/generator/profiler.h>
+
+#include <cyng/factory.h>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	std::uint64_t to_microseconds(profiler::clock_t::duration d)
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+	}
+
+	profiler::profiler(std::size_t top_n)
+		: top_n_(top_n)
+		, mutex_()
+		, seq_(0)
+		, entries_()
+		, slowest_()
+	{
+		slowest_.reserve(top_n_ + 1);
+	}
+
+	void profiler::record(std::string const& name
+		, clock_t::duration d
+		, std::size_t bytes
+		, std::string const& file
+		, std::size_t line)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++seq_;
+
+		auto& e = get_entry(name);
+		++e.calls_;
+		e.total_ += d;
+		e.bytes_ += bytes;
+		e.max_ = std::max(e.max_, merge(call{ name, seq_, d, bytes, file, line }));
+	}
+
+	std::size_t profiler::next_seq() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return seq_ + 1;
+	}
+
+	void profiler::add(std::string const& name
+		, clock_t::duration d
+		, std::size_t bytes
+		, std::string const& file
+		, std::size_t seq)
+	{
+		//
+		//	A worker can finish before the call itself is recorded.
+		//
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto& e = get_entry(name);
+		e.total_ += d;
+		e.bytes_ += bytes;
+		e.max_ = std::max(e.max_, merge(call{ name, seq, d, bytes, file, 0u }));
+	}
+
+	profiler::entry& profiler::get_entry(std::string const& name)
+	{
+		return entries_.emplace(name, entry{ 0u, clock_t::duration::zero(), clock_t::duration::zero(), 0u }).first->second;
+	}
+
+	profiler::clock_t::duration profiler::merge(call&& c)
+	{
+		auto const pos = std::find_if(slowest_.begin(), slowest_.end(), [&c](call const& other) {
+			return other.seq_ == c.seq_;
+		});
+		if (pos != slowest_.end()) {
+			c.duration_ += pos->duration_;
+			c.bytes_ += pos->bytes_;
+			if (c.file_.empty())	c.file_ = pos->file_;
+			if (c.line_ == 0)	c.line_ = pos->line_;
+			slowest_.erase(pos);
+		}
+		auto const d = c.duration_;
+
+		//
+		//	keep the top-N slowest calls
+		//
+		if (slowest_.size() < top_n_ || d > slowest_.back().duration_) {
+			auto const idx = std::upper_bound(slowest_.begin(), slowest_.end(), d, [](clock_t::duration d, call const& c) {
+				return d > c.duration_;
+			});
+			slowest_.insert(idx, std::move(c));
+			if (slowest_.size() > top_n_)	slowest_.pop_back();
+		}
+		return d;
+	}
+
+	void profiler::clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		seq_ = 0;
+		entries_.clear();
+		slowest_.clear();
+	}
+
+	bool profiler::empty() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.empty();
+	}
+
+	cyng::object profiler::to_object() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		cyng::vector_t builtins;
+		for (auto const& e : entries_) {
+			builtins.push_back(cyng::param_map_factory("name", e.first)
+				("calls", e.second.calls_)
+				("total", to_microseconds(e.second.total_))
+				("max", to_microseconds(e.second.max_))
+				("bytes", e.second.bytes_)());
+		}
+
+		cyng::vector_t slowest;
+		for (auto const& c : slowest_) {
+			slowest.push_back(cyng::param_map_factory("name", c.name_)
+				("seq", c.seq_)
+				("duration", to_microseconds(c.duration_))
+				("bytes", c.bytes_)
+				("file", c.file_)
+				("line", c.line_)());
+		}
+
+		return cyng::param_map_factory("unit", "us")
+			("calls", seq_)
+			("builtins", builtins)
+			("slowest", slowest)();
+	}
+
+	void profiler::print(std::ostream& os) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		//
+		//	order by cumulative time
+		//
+		std::vector<std::map<std::string, entry>::const_iterator> idx;
+		idx.reserve(entries_.size());
+		for (auto pos = entries_.begin(); pos != entries_.end(); ++pos) {
+			idx.push_back(pos);
+		}
+		std::sort(idx.begin(), idx.end(), [](auto const& lhs, auto const& rhs) {
+			return lhs->second.total_ > rhs->second.total_;
+		});
+
+		os
+			<< std::left << std::setw(20) << "builtin"
+			<< std::right << std::setw(10) << "calls"
+			<< std::setw(14) << "total [us]"
+			<< std::setw(12) << "max [us]"
+			<< std::setw(14) << "bytes"
+			<< std::endl
+			;
+
+		for (auto const& pos : idx) {
+			os
+				<< std::left << std::setw(20) << pos->first
+				<< std::right << std::setw(10) << pos->second.calls_
+				<< std::setw(14) << to_microseconds(pos->second.total_)
+				<< std::setw(12) << to_microseconds(pos->second.max_)
+				<< std::setw(14) << pos->second.bytes_
+				<< std::endl
+				;
+		}
+
+		if (!slowest_.empty()) {
+			os
+				<< std::endl
+				<< "slowest calls:"
+				<< std::endl
+				;
+			for (auto const& c : slowest_) {
+				os
+					<< std::left << std::setw(20) << c.name_
+					<< std::right << std::setw(10) << ('#' + std::to_string(c.seq_))
+					<< std::setw(14) << to_microseconds(c.duration_)
+					<< std::setw(12) << ""
+					<< std::setw(14) << c.bytes_
+					;
+				if (!c.file_.empty()) {
+					os << "  " << c.file_;
+					if (c.line_ != 0)	os << ':' << c.line_;
+				}
+				os << std::endl;
+			}
+		}
+	}
+
+}
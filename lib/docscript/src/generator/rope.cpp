@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/rope.h>
+
+namespace docscript
+{
+	rope::rope()
+		: segments_()
+		, owned_()
+		, size_(0)
+	{}
+
+	rope& rope::append(std::string_view s)
+	{
+		if (!s.empty()) {
+			segments_.push_back(s);
+			size_ += s.size();
+		}
+		return *this;
+	}
+
+	rope& rope::append(std::string&& s)
+	{
+		if (!s.empty()) {
+			owned_.push_back(std::move(s));
+			return append(std::string_view(owned_.back()));
+		}
+		return *this;
+	}
+
+	std::size_t rope::mark()
+	{
+		segments_.emplace_back();
+		return segments_.size() - 1;
+	}
+
+	void rope::fill(std::size_t idx, std::string_view s)
+	{
+		auto& seg = segments_.at(idx);
+		size_ -= seg.size();
+		seg = s;
+		size_ += s.size();
+	}
+
+	std::size_t rope::size() const
+	{
+		return size_;
+	}
+
+	bool rope::empty() const
+	{
+		return size_ == 0;
+	}
+
+	char rope::back() const
+	{
+		for (auto pos = segments_.rbegin(); pos != segments_.rend(); ++pos) {
+			if (!pos->empty())	return pos->back();
+		}
+		return '\0';
+	}
+
+	std::string rope::str() const
+	{
+		std::string s;
+		append_to(s);
+		return s;
+	}
+
+	void rope::append_to(std::string& s) const
+	{
+		s.reserve(s.size() + size_);
+		for (auto const& seg : segments_) {
+			s.append(seg);
+		}
+	}
+
+	void rope::write(std::ostream& os) const
+	{
+		for (auto const& seg : segments_) {
+			os.write(seg.data(), static_cast<std::streamsize>(seg.size()));
+		}
+	}
+
+	void rope::clear()
+	{
+		segments_.clear();
+		owned_.clear();
+		size_ = 0;
+	}
+}
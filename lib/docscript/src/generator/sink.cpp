@@ -0,0 +1,207 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/generator/sink.h>
+#include <docscript/generator/precompress.h>
+
+#include <cstring>
+
+namespace docscript
+{
+	sink_buffer::sink_buffer(std::FILE* f, bool close_file, std::size_t size)
+		: file_(f)
+		, close_file_(close_file)
+		, str_(nullptr)
+		, buffer_(size)
+		, good_(f != nullptr)
+		, precompressor_()
+	{
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	sink_buffer::sink_buffer(std::string& str, std::size_t size)
+		: file_(nullptr)
+		, close_file_(false)
+		, str_(&str)
+		, buffer_(size)
+		, good_(true)
+		, precompressor_()
+	{
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+	}
+
+	sink_buffer::~sink_buffer()
+	{
+		close();
+	}
+
+	bool sink_buffer::close()
+	{
+		auto const b = write_buffer();
+		if (file_ != nullptr) {
+			if (close_file_) {
+				good_ = (std::fclose(file_) == 0) && good_;
+			}
+			else {
+				good_ = (std::fflush(file_) == 0) && good_;
+			}
+			file_ = nullptr;
+		}
+		str_ = nullptr;
+
+		//
+		//	sidecars of incomplete files are discarded
+		//
+		if (precompressor_) {
+			if (b && good_)	good_ = precompressor_->close();
+			precompressor_.reset();
+		}
+		return b && good_;
+	}
+
+	bool sink_buffer::is_open() const
+	{
+		return (file_ != nullptr) || (str_ != nullptr);
+	}
+
+	void sink_buffer::set_precompressor(std::unique_ptr<precompressor> pc)
+	{
+		precompressor_ = std::move(pc);
+	}
+
+	sink_buffer::int_type sink_buffer::overflow(int_type c)
+	{
+		if (!write_buffer())	return traits_type::eof();
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize sink_buffer::xsputn(char const* s, std::streamsize n)
+	{
+		auto const avail = static_cast<std::streamsize>(epptr() - pptr());
+		if (n <= avail) {
+			std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+			pbump(static_cast<int>(n));
+			return n;
+		}
+
+		//
+		//	large chunks bypass the buffer
+		//
+		if (!write_buffer())	return 0;
+		if (n >= static_cast<std::streamsize>(buffer_.size())) {
+			return write(s, static_cast<std::size_t>(n))
+				? n
+				: 0
+				;
+		}
+		std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+		pbump(static_cast<int>(n));
+		return n;
+	}
+
+	int sink_buffer::sync()
+	{
+		//
+		//	no flush per line
+		//
+		return good_ ? 0 : -1;
+	}
+
+	bool sink_buffer::write_buffer()
+	{
+		auto const n = static_cast<std::size_t>(pptr() - pbase());
+		setp(buffer_.data(), buffer_.data() + buffer_.size());
+		return (n == 0) || write(buffer_.data(), n);
+	}
+
+	bool sink_buffer::write(char const* s, std::size_t n)
+	{
+		if (file_ != nullptr) {
+			good_ = (std::fwrite(s, 1, n, file_) == n) && good_;
+		}
+		else if (str_ != nullptr) {
+			str_->append(s, n);
+		}
+		else {
+			good_ = false;
+		}
+		if (good_ && precompressor_)	precompressor_->write(s, n);
+		return good_;
+	}
+
+	/**
+	 * Only visible in this compilation unit
+	 */
+	std::FILE* open_sink_file(cyng::filesystem::path const& p)
+	{
+		if (p == "-")	return stdout;
+		std::FILE* f = std::fopen(p.string().c_str(), "wb");
+		if (f != nullptr) {
+
+			//
+			//	buffering is done by the sink
+			//
+			std::setvbuf(f, nullptr, _IONBF, 0);
+		}
+		return f;
+	}
+
+	sink::sink(cyng::filesystem::path const& p, std::size_t size)
+		: std::ostream(nullptr)
+		, path_(p)
+		, buffer_(open_sink_file(p), p != "-", size)
+	{
+		rdbuf(&buffer_);
+		if (!buffer_.is_open())	setstate(std::ios::badbit);
+	}
+
+	sink::sink(std::FILE* f, std::size_t size)
+		: std::ostream(nullptr)
+		, path_()
+		, buffer_(f, false, size)
+	{
+		rdbuf(&buffer_);
+		if (!buffer_.is_open())	setstate(std::ios::badbit);
+	}
+
+	sink::sink(std::string& str, std::size_t size)
+		: std::ostream(nullptr)
+		, path_()
+		, buffer_(str, size)
+	{
+		rdbuf(&buffer_);
+	}
+
+	sink::~sink()
+	{
+		close();
+	}
+
+	bool sink::is_open() const
+	{
+		return buffer_.is_open();
+	}
+
+	void sink::precompress(unsigned formats)
+	{
+		if (formats != PRECOMPRESS_NONE && !path_.empty() && path_ != "-" && buffer_.is_open()) {
+			buffer_.set_precompressor(std::make_unique<precompressor>(path_, formats));
+		}
+	}
+
+	void sink::close()
+	{
+		if (buffer_.is_open() && !buffer_.close()) {
+			setstate(std::ios::badbit);
+		}
+	}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/source.h>
+
+#include <cstring>
+#include <iostream>
+
+namespace docscript
+{
+	source_file::source_file(cyng::filesystem::path const& p, excerpt const& range)
+		: file_()
+		, region_()
+		, open_(false)
+		, begin_(nullptr)
+		, end_(nullptr)
+		, offset_(0)
+		, truncated_(false)
+	{
+		cyng::error_code ec;
+		auto const size = cyng::filesystem::file_size(p, ec);
+		if (ec)	return;
+
+		if (size != 0) {
+
+			//
+			//	an empty file cannot be mapped
+			//
+			try {
+				file_ = boost::interprocess::file_mapping(p.string().c_str(), boost::interprocess::read_only);
+				region_ = boost::interprocess::mapped_region(file_, boost::interprocess::read_only);
+				begin_ = static_cast<char const*>(region_.get_address());
+				end_ = begin_ + region_.get_size();
+			}
+			catch (boost::interprocess::interprocess_exception const& ex) {
+				std::cerr
+					<< "***error cannot map file ["
+					<< p
+					<< "]: "
+					<< ex.what()
+					<< std::endl;
+				return;
+			}
+		}
+
+		open_ = true;
+		select(range.first_, range.last_, range.max_size_);
+	}
+
+	void source_file::select(std::size_t first, std::size_t last, std::size_t max_size)
+	{
+		//
+		//	skip all lines before the first line
+		//
+		while (offset_ + 1 < first && begin_ != end_) {
+			auto const* nl = static_cast<char const*>(std::memchr(begin_, '\n', end_ - begin_));
+			begin_ = (nl == nullptr) ? end_ : nl + 1;
+			++offset_;
+		}
+
+		//
+		//	cut after the last line
+		//
+		if (last != 0 && last >= first) {
+			auto pos = begin_;
+			for (auto line = (first == 0) ? 1u : first; line <= last && pos != end_; ++line) {
+				auto const* nl = static_cast<char const*>(std::memchr(pos, '\n', end_ - pos));
+				pos = (nl == nullptr) ? end_ : nl + 1;
+			}
+			end_ = pos;
+		}
+
+		//
+		//	cut at a line break to keep the excerpt readable
+		//
+		if (max_size != 0 && static_cast<std::size_t>(end_ - begin_) > max_size) {
+			auto pos = begin_ + max_size;
+			while (pos != begin_ && *(pos - 1) != '\n')	--pos;
+			if (pos == begin_) {
+
+				//
+				//	a single long line: don't cut inside an UTF-8 sequence
+				//	(continuation bytes are 10xxxxxx)
+				//
+				pos = begin_ + max_size;
+				while (pos != begin_ && (static_cast<unsigned char>(*pos) & 0xC0) == 0x80)	--pos;
+			}
+			end_ = pos;
+			truncated_ = true;
+		}
+	}
+
+	bool source_file::is_open() const
+	{
+		return open_;
+	}
+
+	char const* source_file::begin() const
+	{
+		return begin_;
+	}
+
+	char const* source_file::end() const
+	{
+		return end_;
+	}
+
+	std::size_t source_file::size() const
+	{
+		return static_cast<std::size_t>(end_ - begin_);
+	}
+
+	std::size_t source_file::get_offset() const
+	{
+		return offset_;
+	}
+
+	std::size_t source_file::get_position() const
+	{
+		return (begin_ == nullptr)
+			? 0u
+			: static_cast<std::size_t>(begin_ - static_cast<char const*>(region_.get_address()))
+			;
+	}
+
+	bool source_file::is_truncated() const
+	{
+		return truncated_;
+	}
+}
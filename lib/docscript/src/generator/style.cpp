@@ -0,0 +1,413 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/style.h>
+#include <docscript/generator/cache.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace docscript
+{
+	std::ostream& emit_critical_rules(std::ostream& ofs)
+	{
+		ofs
+			<< "\t\tbody { "
+			<< std::endl
+			//	Georgia,Cambria,serif;
+			<< "\t\t\tfont-family:'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;"	
+			<< std::endl
+			//	https://jrl.ninja/etc/1/
+			//<< "\t\t\tmax-width: 52rem; "
+			<< "\t\t\tmax-width: 62%; "
+			<< std::endl
+			<< "\t\t\tpadding: 2rem; "
+			<< std::endl
+			<< "\t\t\tmargin: auto; "
+			<< std::endl
+			<< "\t\t\font-size: 1.1em; "
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	styling header h1 and h2
+			//
+			<< "\t\th1, h2 {"
+			<< std::endl
+			<< "\t\t\tpadding-bottom: .3em;"
+			<< std::endl
+			<< "\t\t\tborder-bottom: 1px solid #eaecef;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			;
+		return ofs;
+	}
+
+	std::ostream& emit_style_rules(std::ostream& ofs)
+	{
+		ofs
+			<< "\t\tcode, kbd, pre, samp {"
+			<< std::endl
+			<< "\t\t\tfont-family: monospace;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//oction
+
+			<< "\t\ta.oction {"
+			<< std::endl
+			<< "\t\t\topacity: 0;"
+			<< std::endl
+			<< "\t\t\ttransition: opacity 0.2s;"
+			<< std::endl
+			<< "\t\t\tcursor: pointer;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\ta.oction:hover{"
+			<< std::endl
+			<< "\t\t\topacity: 1;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+
+			<< "\t\tp > a {"
+			<< std::endl
+			<< "\t\t\ttext-decoration: none;"
+			<< std::endl
+			<< "\t\t\tcolor: blue;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tblockquote > p { margin-bottom: 1px; }"
+			<< std::endl
+			<< "\t\tpre { background-color: #fafafa; }"
+			<< std::endl
+
+			<< "\t\tpre > code:hover {"
+			<< std::endl
+			<< "\t\t\tbackground-color: orange;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tblockquote {"
+			<< std::endl
+			<< "\t\t\tborder-left: 4px solid #eee;"
+			<< std::endl
+			<< "\t\t\tpadding-left: 10px;"
+			<< std::endl
+			<< "\t\t\tcolor: #777;"
+			<< std::endl
+			<< "\t\t\tmargin: 16px 20px;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	figure
+			//
+			<< "\t\tfigure {"
+			<< std::endl
+			<< "\t\t\tmargin: 2%;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\tfigure > figcaption {"
+			<< std::endl
+			<< "\t\t\tbackground-color: #ddd;"
+			<< std::endl
+			<< "\t\t\tfont-style: italic;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\timg {"
+			<< std::endl
+			//<< "\t\t\tmax-width: 95%;"
+			//<< std::endl
+			<< "\t\t\tborder: 2px solid #777;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\timg:hover {"
+			<< std::endl
+			<< "\t\t\tbox-shadow: 0 0 10px #ccc;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	gallery
+			//
+			<< "\t\tdiv.gallery {"
+			<< std::endl
+			<< "\t\t\tdisplay: grid;"
+			<< std::endl
+			<< "\t\t\tgrid-gap: 12px;"
+			<< std::endl
+			<< "\t\t\tbackground-color: #eee;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tdiv.smf-svg:hover {"
+			<< std::endl
+			<< "\t\t\tbox-shadow: 0 0 10px #ccc;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	gallery
+			//
+			<< "\t\tdiv.gallery img {"
+			<< std::endl
+			<< "\t\t\twidth: 100%;"
+			<< std::endl
+			<< "\t\t\theight: auto;"
+			<< std::endl
+			<< "\t\t\tobject-fit: cover;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	definition lists with flexbox
+			//
+			<< "\t\tdl {"
+			<< std::endl
+			<< "\t\t\tdisplay: flex;"
+			<< std::endl
+			<< "\t\t\tflex-flow: row wrap;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\tdt {"
+			<< std::endl
+			<< "\t\t\tfont-weight: bold;"
+			<< std::endl
+			<< "\t\t\tflex-basis: 20% ;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\tdt::after {"
+			<< std::endl
+			<< "\t\t\tcontent: \":\";"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\tdd {"
+			<< std::endl
+			<< "\t\t\tflex-basis: 70%;"
+			<< std::endl
+			<< "\t\t\tflex-grow: 1;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	alertbox with flexgrid
+			//
+			<< "\t\tul.alert {"
+			<< std::endl
+			<< "\t\t\tdisplay: flex;"
+			<< std::endl
+			<< "\t\t\tlist-style: none;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tul.alert > li {"
+			<< std::endl
+			<< "\t\t\tpadding: 7px;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tul.alert > li:nth-child(2) {"
+			<< std::endl
+			<< "\t\t\tbackground-color: #ddd;"
+			<< std::endl
+			<< "\t\t\tborder-radius: 5px;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//	formatting sub and supscript
+			<< "\t\tsup { top: -.5em; }"
+			<< std::endl
+			<< "\t\tsub { bottom: -.25em; }"
+			<< std::endl
+			<< "\t\tsub, sup {"
+			<< std::endl
+			<< "\t\t\tfont-size: 75%;"
+			<< std::endl
+			<< "\t\t\tline-height: 0;"
+			<< std::endl
+			<< "\t\t\tposition: relative;"
+			<< std::endl
+			<< "\t\t\tvertical-align: baseline;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//	There is an alternative styling for aside tag that works
+			//	for bootstrap 4 too: float: right;
+			<< "\t\taside {"
+			<< std::endl
+			<< "\t\t\tposition: absolute;"
+			<< std::endl
+			<< "\t\t\tright: 2em;"
+			<< std::endl
+			<< "\t\t\twidth: 20%;"
+			<< std::endl
+			<< "\t\t\tborder: 1px #D5DBDB solid;"
+			<< std::endl
+			<< "\t\t\tcolor: #9C640C;"
+			<< std::endl
+			<< "\t\t\tpadding: 0.5em;"
+			<< std::endl
+			<< "\t\t\tz-index: -1;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\ttable {"
+			<< std::endl
+			<< "\t\t\tborder-collapse: collapse;"
+			<< std::endl
+			<< "\t\t\tborder-spacing: 0px;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\ttable, th, td {"
+			<< std::endl
+			<< "\t\t\tpadding: 5px;"
+			<< std::endl
+			<< "\t\t\tborder: 1px solid black;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\ttr:nth-child(even) {"
+			<< std::endl
+			<< "\t\t\tbackground-color: #f2f2f2;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tcaption {"
+			<< std::endl
+			<< "\t\t\tfont-weight: bold;"
+			<< std::endl
+			<< "\t\t\tcolor: white;"
+			<< std::endl
+			<< "\t\t\tbackground-color: DimGray;"
+			<< std::endl
+			<< "\t\t\tpadding: 5px;"
+			<< std::endl
+			<< "\t\t\ttext-align: left;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			<< "\t\ttd.docscript-table-truncated {"
+			<< std::endl
+			<< "\t\t\tfont-style: italic;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			<< "\t\tkbd {"
+			<< std::endl
+			<< "\t\t\tpadding: 2px 4px;"
+			<< std::endl
+			<< "\t\t\tfont-size: 90%;"
+			<< std::endl
+			<< "\t\t\tcolor: #ffffff;"
+			<< std::endl
+			<< "\t\t\tbackground-color: #333333;"
+			<< std::endl
+			<< "\t\t\tborder-radius: 3px;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+
+			//
+			//	ToC
+			//
+			<< "\t\tdetails > ul * {"
+			<< std::endl
+			<< "\t\t\tlist-style-type: none;"
+			<< std::endl
+			<< "\t\t\ttext-decoration: none;"
+			<< std::endl
+			<< "\t\t\tmargin-left: 0em;"
+			<< std::endl
+			<< "\t\t\tpadding-left: 0.7em;"
+			<< std::endl
+			<< "\t\t}"
+			<< std::endl
+			;
+		return ofs;
+	}
+
+	style_sheet::style_sheet(cyng::filesystem::path const& root, bool critical)
+		: dir_(root / "css")
+		, critical_(critical)
+		, mutex_()
+		, href_()
+		, done_(false)
+	{}
+
+	bool style_sheet::is_critical() const
+	{
+		return critical_;
+	}
+
+	std::string style_sheet::emit()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (done_)	return href_;
+		done_ = true;
+
+		std::stringstream ss;
+		emit_critical_rules(ss);
+		emit_style_rules(ss);
+		auto const css = ss.str();
+
+		//
+		//	name changes with every change of the rules
+		//
+		auto const name = "docscript-" + compute_hash(css).substr(0, 16) + ".css";
+		auto const p = dir_ / name;
+
+		cyng::error_code ec;
+		if (!cyng::filesystem::exists(p, ec)) {
+
+			cyng::filesystem::create_directories(dir_, ec);
+			std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc | std::ios::binary);
+			if (!ofs.is_open()) {
+				std::cerr
+					<< "***error cannot write stylesheet ["
+					<< p
+					<< "]"
+					<< std::endl;
+				return href_;
+			}
+			ofs << css;
+		}
+		href_ = "css/" + name;
+		return href_;
+	}
+}
@@ -0,0 +1,268 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/svg.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	bool is_editor_data(char const* name)
+	{
+		return boost::algorithm::starts_with(name, "inkscape:")
+			|| boost::algorithm::starts_with(name, "sodipodi:")
+			|| boost::algorithm::equals(name, "metadata")
+			|| boost::algorithm::equals(name, "xmlns:inkscape")
+			|| boost::algorithm::equals(name, "xmlns:sodipodi")
+			|| boost::algorithm::equals(name, "xmlns:rdf")
+			|| boost::algorithm::equals(name, "xmlns:cc")
+			|| boost::algorithm::equals(name, "xmlns:dc")
+			;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Attributes that contain coordinates and lengths only.
+	 */
+	bool is_geometry(char const* name)
+	{
+		static char const* names[] = {
+			"d", "points", "transform", "gradientTransform", "patternTransform",
+			"x", "y", "x1", "y1", "x2", "y2", "cx", "cy", "r", "rx", "ry", "fx", "fy",
+			"width", "height", "stroke-width", "stroke-dashoffset", "font-size", "offset"
+		};
+		for (auto const n : names) {
+			if (std::strcmp(n, name) == 0)	return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * @return larger extent of the viewBox or 0 if the attribute is invalid
+	 */
+	double get_viewbox_extent(char const* value)
+	{
+		//
+		//	min-x min-y width height - separated by whitespace and/or comma
+		//
+		double v[4] = { 0.0, 0.0, 0.0, 0.0 };
+		for (auto& d : v) {
+			while (*value == ',' || std::isspace(static_cast<unsigned char>(*value)))	++value;
+			char* end = nullptr;
+			d = std::strtod(value, &end);
+			if (end == value)	return 0.0;
+			value = end;
+		}
+		return std::max(v[2], v[3]);
+	}
+
+	/**
+	 * Only visible in this compilation unit.
+	 * Scripts may contain line comments.
+	 */
+	bool is_preserved(pugi::xml_node node)
+	{
+		if (boost::algorithm::equals(node.name(), "script"))	return true;
+		for (; node; node = node.parent()) {
+			if (boost::algorithm::equals(node.attribute("xml:space").value(), "preserve"))	return true;
+		}
+		return false;
+	}
+
+	void minify_svg(pugi::xml_node node, std::size_t precision)
+	{
+		std::vector<pugi::xml_node> garbage;
+		for (auto child : node.children()) {
+			switch (child.type()) {
+			case pugi::node_element:
+				if (is_editor_data(child.name())) {
+					garbage.push_back(child);
+				}
+				else {
+					minify_svg(child, precision);
+				}
+				break;
+			case pugi::node_pcdata:
+				if (!is_preserved(node)) {
+
+					//
+					//	no trim - whitespace separates text from nested elements
+					//
+					child.set_value(collapse_whitespace(child.value(), false).c_str());
+				}
+				break;
+			case pugi::node_comment:
+				garbage.push_back(child);
+				break;
+			default:
+				break;
+			}
+		}
+		for (auto& child : garbage) {
+			node.remove_child(child);
+		}
+
+		std::vector<pugi::xml_attribute> attrs;
+		for (auto attr : node.attributes()) {
+			if (is_editor_data(attr.name())) {
+				attrs.push_back(attr);
+			}
+			else if (is_geometry(attr.name())) {
+
+				//
+				//	scale factors need more precision than coordinates
+				//
+				auto const digits = boost::algorithm::iends_with(attr.name(), "transform")
+					? precision + 2
+					: precision
+					;
+				attr.set_value(shorten_numbers(collapse_whitespace(attr.value()), digits).c_str());
+			}
+			else if (boost::algorithm::equals(attr.name(), "style")) {
+				attr.set_value(collapse_whitespace(attr.value()).c_str());
+			}
+		}
+		for (auto& attr : attrs) {
+			node.remove_attribute(attr);
+		}
+	}
+
+	std::size_t get_svg_precision(pugi::xml_node svg, std::size_t digits)
+	{
+		auto extent = get_viewbox_extent(svg.attribute("viewBox").value());
+		if (!(extent > 0.0)) {
+			extent = std::max(get_svg_length(svg.attribute("width").value()), get_svg_length(svg.attribute("height").value()));
+		}
+		if (!(extent > 0.0)) {
+			extent = 100.0;
+		}
+
+		//
+		//	number of digits before the decimal point (negative for extents below 0.1)
+		//
+		auto const magnitude = static_cast<int>(std::floor(std::log10(extent))) + 1;
+		auto const decimals = static_cast<int>(digits) - magnitude;
+		return static_cast<std::size_t>(std::min(std::max(decimals, 0), 9));
+	}
+
+	std::string shorten_numbers(std::string const& str, std::size_t precision)
+	{
+		std::string r;
+		r.reserve(str.size());
+
+		//
+		//	the last emitted number contains a decimal point
+		//
+		bool has_dot{ false };
+
+		std::size_t idx = 0;
+		auto const size = str.size();
+		while (idx < size) {
+			auto const c = str.at(idx);
+			if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && idx + 1 < size && std::isdigit(static_cast<unsigned char>(str.at(idx + 1))))) {
+
+				//
+				//	scan number: digits [. digits] [e [+-] digits]
+				//
+				auto pos = idx;
+				bool fraction{ false }, exponent{ false };
+				while (pos < size && std::isdigit(static_cast<unsigned char>(str.at(pos))))	++pos;
+				if (pos < size && str.at(pos) == '.') {
+					fraction = true;
+					++pos;
+					while (pos < size && std::isdigit(static_cast<unsigned char>(str.at(pos))))	++pos;
+				}
+				if (pos + 1 < size && (str.at(pos) == 'e' || str.at(pos) == 'E')) {
+					auto exp = pos + 1;
+					if (str.at(exp) == '+' || str.at(exp) == '-')	++exp;
+					if (exp < size && std::isdigit(static_cast<unsigned char>(str.at(exp)))) {
+						exponent = true;
+						pos = exp;
+						while (pos < size && std::isdigit(static_cast<unsigned char>(str.at(pos))))	++pos;
+					}
+				}
+
+				std::string num = str.substr(idx, pos - idx);
+				if (fraction || exponent) {
+					char buffer[64];
+					std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(precision), std::strtod(num.c_str(), nullptr));
+					num = buffer;
+					if (num.find('.') != std::string::npos) {
+						while (num.back() == '0')	num.pop_back();
+						if (num.back() == '.')	num.pop_back();
+					}
+
+					//
+					//	"0.5" => ".5"
+					//
+					if (num.size() > 2 && num.at(0) == '0' && num.at(1) == '.') {
+						num.erase(0, 1);
+					}
+				}
+
+				//
+				//	"1.0.5" must not become "1.5"
+				//
+				if (num.at(0) == '.' && !r.empty() && std::isdigit(static_cast<unsigned char>(r.back())) && !has_dot) {
+					r.push_back(' ');
+				}
+
+				has_dot = num.find('.') != std::string::npos;
+				r.append(num);
+				idx = pos;
+			}
+			else {
+				r.push_back(c);
+				++idx;
+			}
+		}
+		return r;
+	}
+
+	std::string collapse_whitespace(std::string const& str, bool trim)
+	{
+		std::string r;
+		r.reserve(str.size());
+		for (auto const c : str) {
+			if (std::isspace(static_cast<unsigned char>(c))) {
+				if (r.empty() ? !trim : r.back() != ' ')	r.push_back(' ');
+			}
+			else {
+				r.push_back(c);
+			}
+		}
+		if (trim && !r.empty() && r.back() == ' ')	r.pop_back();
+		return r;
+	}
+
+	double get_svg_length(char const* value)
+	{
+		char* end = nullptr;
+		auto const d = std::strtod(value, &end);
+		if (end == value)	return 0.0;
+
+		//
+		//	only user units and pixel, no relative lengths
+		//
+		return (*end == '\0' || std::strcmp(end, "px") == 0)
+			? d
+			: 0.0
+			;
+	}
+}
@@ -0,0 +1,146 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/table.h>
+#include <docscript/generator/source.h>
+
+#include <cstring>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	bool is_field_end(char c)
+	{
+		return c == ',' || c == '\n' || c == '\r';
+	}
+
+	std::size_t read_csv(char const* begin, char const* end, std::function<bool(csv_row_t const&)> cb)
+	{
+		if (end - begin >= 3 && std::memcmp(begin, "\xef\xbb\xbf", 3) == 0) {
+			begin += 3;
+		}
+
+		//
+		//	the cells are reused to keep their capacity
+		//
+		csv_row_t row;
+		std::size_t count{ 0 };
+
+		auto pos = begin;
+		while (pos != end) {
+
+			std::size_t n{ 0 };
+			for (;;) {
+				if (n == row.size())	row.emplace_back();
+				auto& cell = row.at(n++);
+				cell.clear();
+
+				if (pos != end && *pos == '"') {
+
+					//
+					//	quoted field
+					//
+					++pos;
+					for (;;) {
+						auto const* quote = static_cast<char const*>(std::memchr(pos, '"', end - pos));
+						if (quote == nullptr) {
+							//	unterminated quote
+							cell.append(pos, end);
+							pos = end;
+							break;
+						}
+						cell.append(pos, quote);
+						pos = quote + 1;
+						if (pos != end && *pos == '"') {
+							cell.push_back('"');
+							++pos;
+						}
+						else {
+							break;
+						}
+					}
+
+					//
+					//	garbage after the closing quote
+					//
+					while (pos != end && !is_field_end(*pos)) {
+						cell.push_back(*pos++);
+					}
+				}
+				else {
+					auto field = pos;
+					while (pos != end && !is_field_end(*pos))	++pos;
+					cell.append(field, pos);
+				}
+
+				if (pos != end && *pos == ',') {
+					++pos;
+				}
+				else {
+					break;
+				}
+			}
+
+			//
+			//	CR, LF or CRLF
+			//
+			if (pos != end && *pos == '\r')	++pos;
+			if (pos != end && *pos == '\n')	++pos;
+
+			//
+			//	skip empty lines
+			//
+			if (n == 1 && row.front().empty())	continue;
+
+			row.resize(n);
+			++count;
+			if (!cb(row))	break;
+		}
+		return count;
+	}
+
+	bool render_csv(cyng::filesystem::path const& p, table_limits const& limits, table_writer& writer)
+	{
+		source_file const src(p);
+		if (!src.is_open())	return false;
+
+		csv_row_t header;
+		bool initial{ true }, truncated{ false };
+		std::size_t rows{ 0 }, page{ 0 };
+
+		read_csv(src.begin(), src.end(), [&](csv_row_t const& row) -> bool {
+			if (initial) {
+				initial = false;
+				header = row;
+				writer.begin_page(page, header);
+				return true;
+			}
+			if (limits.max_rows_ != 0 && rows == limits.max_rows_) {
+				truncated = true;
+				return false;
+			}
+			if (limits.page_size_ != 0 && rows != 0 && rows % limits.page_size_ == 0) {
+				writer.end_page(page);
+				writer.begin_page(++page, header);
+			}
+			writer.row(row);
+			++rows;
+			return true;
+		});
+
+		//
+		//	empty file
+		//
+		if (initial)	writer.begin_page(page, header);
+
+		writer.end_page(page);
+		if (truncated)	writer.truncated(rows);
+		return true;
+	}
+}
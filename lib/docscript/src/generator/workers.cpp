@@ -0,0 +1,54 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/workers.h>
+
+#include <memory>
+#include <thread>
+
+#include <boost/asio/post.hpp>
+
+namespace docscript
+{
+	worker_pool::worker_pool(std::size_t threads)
+		: threads_(get_thread_count(threads))
+		, pool_(threads_)
+	{}
+
+	worker_pool::~worker_pool()
+	{
+		pool_.join();
+	}
+
+	std::shared_future<std::string> worker_pool::submit(std::function<std::string()> job)
+	{
+		//
+		//	asio handlers have to be copyable
+		//
+		auto task = std::make_shared<std::packaged_task<std::string()>>(std::move(job));
+		std::shared_future<std::string> f = task->get_future().share();
+		boost::asio::post(pool_, [task]() {
+			(*task)();
+		});
+		return f;
+	}
+
+	std::size_t worker_pool::size() const
+	{
+		return threads_;
+	}
+
+	std::size_t get_thread_count(std::size_t threads)
+	{
+		if (threads != 0)	return threads;
+		auto const n = std::thread::hardware_concurrency();
+		return (n == 0)
+			? 1u
+			: n
+			;
+	}
+}
@@ -17,6 +17,17 @@ namespace docscript
 	{}
 
 	void sanitizer::read(boost::u8_to_u32_iterator<std::string::const_iterator> first, boost::u8_to_u32_iterator<std::string::const_iterator> last)
+	{
+		read_range(first, last);
+	}
+
+	void sanitizer::read(boost::u8_to_u32_iterator<char const*> first, boost::u8_to_u32_iterator<char const*> last)
+	{
+		read_range(first, last);
+	}
+
+	template <typename I>
+	void sanitizer::read_range(I first, I last)
 	{
 		//
 		//	walk over range
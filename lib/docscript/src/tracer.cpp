@@ -0,0 +1,158 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#include <docscript/tracer.h>
+
+#include <fstream>
+#include <iomanip>
+
+namespace docscript
+{
+	/**
+	 * Only visible in this compilation unit
+	 */
+	void write_json_string(std::ostream&, std::string const&);
+
+	tracer::tracer()
+		: epoch_(clock_t::now())
+		, mutex_()
+		, events_()
+		, threads_()
+	{}
+
+	void tracer::add(std::string const& name
+		, std::string const& cat
+		, clock_t::time_point start
+		, clock_t::time_point stop
+		, args_t&& args)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		events_.push_back(event{ name
+			, cat
+			, to_timestamp(start)
+			, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count())
+			, get_tid()
+			, std::move(args) });
+	}
+
+	void tracer::write(std::ostream& os) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		os << "{\"traceEvents\":[";
+		bool init{ false };
+		for (auto const& e : events_) {
+			if (init)	os << ',';
+			else	init = true;
+
+			os << std::endl << "{\"name\":";
+			write_json_string(os, e.name_);
+			os << ",\"cat\":";
+			write_json_string(os, e.cat_);
+			os
+				<< ",\"ph\":\"X\",\"ts\":"
+				<< e.ts_
+				<< ",\"dur\":"
+				<< e.dur_
+				<< ",\"pid\":1,\"tid\":"
+				<< e.tid_
+				;
+			if (!e.args_.empty()) {
+				os << ",\"args\":{";
+				bool first{ true };
+				for (auto const& a : e.args_) {
+					if (!first)	os << ',';
+					first = false;
+					write_json_string(os, a.first);
+					os << ':';
+					write_json_string(os, a.second);
+				}
+				os << '}';
+			}
+			os << '}';
+		}
+		os
+			<< std::endl
+			<< "],\"displayTimeUnit\":\"ms\"}"
+			<< std::endl
+			;
+	}
+
+	bool tracer::write(cyng::filesystem::path const& p) const
+	{
+		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		if (ofs.is_open()) {
+			write(ofs);
+			return true;
+		}
+		return false;
+	}
+
+	std::uint64_t tracer::to_timestamp(clock_t::time_point tp) const
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(tp - epoch_).count());
+	}
+
+	std::size_t tracer::get_tid()
+	{
+		auto const r = threads_.emplace(std::this_thread::get_id(), threads_.size() + 1);
+		return r.first->second;
+	}
+
+	trace_scope::trace_scope(tracer* tp, std::string const& name, std::string const& cat)
+		: tracer_(tp)
+		, name_((tp != nullptr) ? name : std::string())
+		, cat_((tp != nullptr) ? cat : std::string())
+		, start_((tp != nullptr) ? tracer::clock_t::now() : tracer::clock_t::time_point())
+		, args_()
+	{}
+
+	trace_scope::~trace_scope()
+	{
+		if (tracer_ != nullptr) {
+			tracer_->add(name_, cat_, start_, tracer::clock_t::now(), std::move(args_));
+		}
+	}
+
+	void trace_scope::arg(std::string const& key, std::string const& value)
+	{
+		if (tracer_ != nullptr) {
+			args_.emplace(key, value);
+		}
+	}
+
+	void write_json_string(std::ostream& os, std::string const& str)
+	{
+		os << '"';
+		for (auto const c : str) {
+			switch (c) {
+			case '"':	os << "\\\"";	break;
+			case '\\':	os << "\\\\";	break;
+			case '\n':	os << "\\n";	break;
+			case '\r':	os << "\\r";	break;
+			case '\t':	os << "\\t";	break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					os 
+						<< "\\u"
+						<< std::hex
+						<< std::setw(4)
+						<< std::setfill('0')
+						<< static_cast<int>(c)
+						<< std::dec
+						<< std::setfill(' ')
+						;
+				}
+				else {
+					os << c;
+				}
+				break;
+			}
+		}
+		os << '"';
+	}
+}
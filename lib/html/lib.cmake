@@ -4,11 +4,15 @@
 set (html_lib)
 
 set (html_cpp
+	lib/html/src/compact.cpp
 	lib/html/src/dom.cpp
+	lib/html/src/names.cpp
 )
     
 set (html_h
+	src/main/include/html/compact.hpp
 	src/main/include/html/dom.hpp
+	src/main/include/html/names.hpp
 )
 
 
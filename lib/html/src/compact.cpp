@@ -0,0 +1,261 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <html/compact.hpp>
+#include <html/dom.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace dom
+{
+	namespace compact
+	{
+		arena::arena(std::size_t block_size)
+			: block_size_(block_size)
+			, blocks_()
+			, block_(0)
+			, used_(0)
+		{}
+
+		std::string_view arena::store(std::string_view s)
+		{
+			if (s.empty())	return std::string_view();
+			auto* p = allocate(s.size());
+			std::memcpy(p, s.data(), s.size());
+			return std::string_view(p, s.size());
+		}
+
+		void arena::clear()
+		{
+			block_ = 0;
+			used_ = 0;
+		}
+
+		std::size_t arena::capacity() const
+		{
+			std::size_t size{ 0 };
+			for (auto const& b : blocks_) {
+				size += b.second;
+			}
+			return size;
+		}
+
+		char* arena::allocate(std::size_t n)
+		{
+			//
+			//	reuse the blocks of a previous document
+			//
+			while (block_ < blocks_.size()) {
+				if (used_ + n <= blocks_.at(block_).second) {
+					auto* p = blocks_.at(block_).first.get() + used_;
+					used_ += n;
+					return p;
+				}
+				++block_;
+				used_ = 0;
+			}
+
+			//
+			//	large strings get a block of their own
+			//
+			auto const size = std::max(block_size_, n);
+			blocks_.emplace_back(std::make_unique<char[]>(size), size);
+			block_ = blocks_.size() - 1;
+			used_ = n;
+			return blocks_.back().first.get();
+		}
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Append a slot to a range. A full range is moved to the end
+		 * of the vector with twice the capacity, so appending
+		 * to a parent is amortized O(1). The old slots are not reused.
+		 */
+		template<class T>
+		document::index_t grow_range(std::vector<T>& vec, document::index_t& first, document::index_t& count, document::index_t& capacity)
+		{
+			if (count == capacity) {
+				auto const pos = static_cast<document::index_t>(vec.size());
+				capacity = std::max<document::index_t>(4u, 2u * count);
+				vec.resize(vec.size() + capacity);
+				std::copy_n(vec.begin() + first, count, vec.begin() + pos);
+				first = pos;
+			}
+			return first + count++;
+		}
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Elements with a line break before the end tag.
+		 */
+		bool is_indented(tag_id tag)
+		{
+			switch (tag) {
+			case tag_id::div:
+			case tag_id::ul:
+			case tag_id::ol:
+			case tag_id::li:
+			case tag_id::nav:
+			case tag_id::footer:
+			case tag_id::section:
+				return true;
+			default:
+				break;
+			}
+			return false;
+		}
+
+		document::document()
+			: nodes_()
+			, attrs_()
+			, links_()
+			, writers_()
+			, arena_()
+		{}
+
+		document::index_t document::make_node(tag_id tag, index_t attrs, index_t children)
+		{
+			auto const idx = static_cast<index_t>(nodes_.size());
+			nodes_.push_back(node_rec{ tag
+				, static_cast<index_t>(attrs_.size()), attrs, attrs
+				, static_cast<index_t>(links_.size()), children, children
+				, std::string_view() });
+
+			//
+			//	the slots are filled by the cursor
+			//
+			attrs_.resize(attrs_.size() + attrs, attr_rec{ attr_id::unknown, npos, std::string_view() });
+			links_.resize(links_.size() + children, npos);
+			return idx;
+		}
+
+		document::index_t document::grow_children(index_t parent)
+		{
+			auto& n = nodes_.at(parent);
+			return grow_range(links_, n.first_child_, n.child_count_, n.child_capacity_);
+		}
+
+		document::index_t document::grow_attributes(index_t parent)
+		{
+			auto& n = nodes_.at(parent);
+			return grow_range(attrs_, n.first_attr_, n.attr_count_, n.attr_capacity_);
+		}
+
+		void document::set_text(index_t idx, std::string_view s)
+		{
+			nodes_.at(idx).text_ = arena_.store(s);
+		}
+
+		void document::set_attribute(index_t pos, attr_id id, std::string_view value)
+		{
+			attrs_.at(pos) = attr_rec{ id, npos, arena_.store(value) };
+		}
+
+		void document::set_attribute(index_t pos, attr_id id, writer_t const& writer)
+		{
+			attrs_.at(pos) = attr_rec{ id, static_cast<index_t>(writers_.size()), std::string_view() };
+			writers_.push_back(writer);
+		}
+
+		void document::serialize(std::ostream& os, index_t idx, std::size_t depth) const
+		{
+			auto const& n = nodes_.at(idx);
+
+			if (depth != 0 && depth != minified) {
+				os
+					<< '\n'
+					<< std::string(depth, '\t')
+					;
+			}
+			os
+				<< '<'
+				<< name(n.tag_)
+				;
+
+			for (auto pos = n.first_attr_; pos != n.first_attr_ + n.attr_count_; ++pos) {
+				auto const& attr = attrs_.at(pos);
+				os
+					<< ' '
+					<< name(attr.id_)
+					;
+				if (attr.writer_ != npos) {
+					os << '=' << '"';
+					writers_.at(attr.writer_)(os);
+					os << '"';
+				}
+				else if (!attr.value_.empty()) {
+					os
+						<< '='
+						<< '"'
+						<< attr.value_
+						<< '"'
+						;
+				}
+			}
+
+			if (n.child_count_ == 0) {
+				if (!n.text_.empty()) {
+					os
+						<< '>'
+						<< n.text_
+						<< "</"
+						<< name(n.tag_)
+						<< '>'
+						;
+				}
+				else {
+					os << ' ' << '/' << '>';
+				}
+				return;
+			}
+
+			os << '>';
+			for (auto pos = n.first_child_; pos != n.first_child_ + n.child_count_; ++pos) {
+				if (pos != n.first_child_) {
+					os << ' ';
+				}
+				serialize(os, links_.at(pos), depth == minified ? minified : depth + 1);
+			}
+
+			if (depth != minified && is_indented(n.tag_)) {
+				os
+					<< '\n'
+					<< std::string(depth, '\t')
+					;
+			}
+
+			os
+				<< n.text_
+				<< "</"
+				<< name(n.tag_)
+				<< '>'
+				;
+		}
+
+		std::string	document::operator()(index_t idx, std::size_t depth) const
+		{
+			std::ostringstream ss;
+			serialize(ss, idx, depth);
+			return ss.str();
+		}
+
+		void document::clear()
+		{
+			nodes_.clear();
+			attrs_.clear();
+			links_.clear();
+			writers_.clear();
+			arena_.clear();
+		}
+
+		std::size_t document::size() const
+		{
+			return nodes_.size();
+		}
+	}
+}
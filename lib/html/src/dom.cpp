@@ -6,19 +6,60 @@
  */
 
 #include <html/dom.hpp>
-#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <unordered_set>
 
 namespace dom
 {
 
+	/**
+	 * Only visible in this compilation unit.
+	 * Appends all output to a string. Unlike std::stringstream
+	 * the result is not copied.
+	 */
+	class string_buffer : public std::streambuf
+	{
+	public:
+		explicit string_buffer(std::string& str)
+			: str_(str)
+		{}
+
+	protected:
+		virtual int_type overflow(int_type c) override
+		{
+			if (!traits_type::eq_int_type(c, traits_type::eof())) {
+				str_.push_back(traits_type::to_char_type(c));
+			}
+			return traits_type::not_eof(c);
+		}
+
+		virtual std::streamsize xsputn(char const* s, std::streamsize n) override
+		{
+			str_.append(s, static_cast<std::size_t>(n));
+			return n;
+		}
+
+	private:
+		std::string& str_;
+	};
+
 	node::node()
 	{}
 
 	std::string	node::operator()(std::size_t intend) const
 	{
-		std::stringstream ss;
-		serialize(ss, intend);
-		return ss.str();
+		std::string str;
+		string_buffer buffer(str);
+		std::ostream os(&buffer);
+		serialize(os, intend);
+		return str;
+	}
+
+	std::ostream& node::write(std::ostream& os, std::size_t intend) const
+	{
+		serialize(os, intend);
+		return os;
 	}
 
 	text::text()
@@ -50,13 +91,39 @@ namespace dom
 	}
 
 	attribute::attribute()
-		: name_(std::string("href"))
+		: name_(name(attr_id::href_))
 		, value_()
+		, writer_()
 	{}
 
 	attribute::attribute(std::string name)
-		: name_(patch_attribute_name(name))
+		: name_(intern_attribute(patch_attribute_name(name)))
+		, value_()
+		, writer_()
+	{}
+
+	attribute::attribute(std::string name, std::string value)
+		: name_(intern_attribute(patch_attribute_name(name)))
+		, value_(std::move(value))
+		, writer_()
+	{}
+
+	attribute::attribute(std::string name, writer_t writer)
+		: name_(intern_attribute(patch_attribute_name(name)))
+		, value_()
+		, writer_(std::move(writer))
+	{}
+
+	attribute::attribute(attr_id id, std::string value)
+		: name_(name(id))
+		, value_(std::move(value))
+		, writer_()
+	{}
+
+	attribute::attribute(attr_id id, writer_t writer)
+		: name_(name(id))
 		, value_()
+		, writer_(std::move(writer))
 	{}
 
 	void attribute::serialize(std::ostream& os) const
@@ -65,7 +132,15 @@ namespace dom
 			<< name_
 			;
 
-		if (!value_.empty()) {
+		if (writer_) {
+			os
+				<< '='
+				<< '"'
+				;
+			writer_(os);
+			os << '"';
+		}
+		else if (!value_.empty()) {
 			os
 				<< '='
 				<< '"'
@@ -86,21 +161,40 @@ namespace dom
 	}
 
 	element::element()
-		: tag_(std::string("div"))
+		: id_(tag_id::div)
+		, tag_(name(id_))
 		, attr_()
 		, children_()
 		, text_()
 	{}
 
 	element::element(std::string tag)
-		: tag_(std::move(tag))
+		: id_(lookup_tag(tag))
+		, tag_(intern_tag(tag))
 		, attr_()
 		, children_()
 		, text_()
 	{}
 
 	element::element(std::string tag, text value)
-		: tag_(std::move(tag))
+		: id_(lookup_tag(tag))
+		, tag_(intern_tag(tag))
+		, attr_()
+		, children_()
+		, text_(std::move(value))
+	{}
+
+	element::element(tag_id id)
+		: id_(id)
+		, tag_(name(id))
+		, attr_()
+		, children_()
+		, text_()
+	{}
+
+	element::element(tag_id id, text value)
+		: id_(id)
+		, tag_(name(id))
 		, attr_()
 		, children_()
 		, text_(std::move(value))
@@ -144,7 +238,7 @@ namespace dom
 	{
 		os
 			<< '<'
-			<< tag_.get()
+			<< tag_
 			;
 
 		for (auto const& attr : attr_) {
@@ -159,7 +253,7 @@ namespace dom
 				text_.serialize(os);
 				os
 					<< "</"
-					<< tag_.get()
+					<< tag_
 					<< ">"
 					;
 			}
@@ -173,7 +267,7 @@ namespace dom
 			//	serialize attributes
 			//
 			bool initialized{ false };
-			for (auto const child : children_) {
+			for (auto const& child : children_) {
 				if (initialized) {
 					os << ' ';
 				}
@@ -187,7 +281,7 @@ namespace dom
 
 	void element::serialize(std::ostream& os, std::size_t depth) const
 	{
-		if (depth != 0) {
+		if (depth != 0 && depth != minified) {
 			os
 				<< std::endl
 				<< std::string(depth, '\t')
@@ -195,7 +289,7 @@ namespace dom
 		}
 		os
 			<< '<'
-			<< tag_.get()
+			<< tag_
 			;
 
 		for (auto const& attr : attr_) {
@@ -210,7 +304,7 @@ namespace dom
 				text_.serialize(os);
 				os
 					<< "</"
-					<< tag_.get()
+					<< tag_
 					<< ">"
 					;
 			}
@@ -226,27 +320,26 @@ namespace dom
 			//	serialize children
 			//
 			bool initialized{ false };
-			for (auto const child : children_) {
+			for (auto const& child : children_) {
 				if (initialized) {
 					os << ' ';
 				}
 				else {
 					initialized = true;
 				}
-				child.serialize(os, depth + 1);
+				child.serialize(os, depth == minified ? minified : depth + 1);
 			}
 
 			//
 			//	check indentation
 			//
-			auto const tag = tag_.get();
-			if (boost::algorithm::equals(tag, "div")
-				|| boost::algorithm::equals(tag, "ul")
-				|| boost::algorithm::equals(tag, "ol")
-				|| boost::algorithm::equals(tag, "li")
-				|| boost::algorithm::equals(tag, "nav")
-				|| boost::algorithm::equals(tag, "footer")
-				|| boost::algorithm::equals(tag, "section")) {
+			if (depth != minified && (id_ == tag_id::div
+				|| id_ == tag_id::ul
+				|| id_ == tag_id::ol
+				|| id_ == tag_id::li
+				|| id_ == tag_id::nav
+				|| id_ == tag_id::footer
+				|| id_ == tag_id::section)) {
 
 				os
 					<< std::endl
@@ -257,13 +350,43 @@ namespace dom
 			os
 				<< text_.value_
 				<< "</"
-				<< tag_.get()
+				<< tag_
 				<< ">"
 				;
 
 		}
 	}
 
+	/**
+	 * Only visible in this compilation unit.
+	 * The pool of each thread is never released because elements
+	 * can outlive the thread that created them. The number of
+	 * unknown names is small.
+	 */
+	std::string_view intern(std::string const& name)
+	{
+		thread_local auto* pool = new std::unordered_set<std::string>();
+		return *pool->insert(name).first;
+	}
+
+	std::string_view intern_tag(std::string const& tag)
+	{
+		auto const id = lookup_tag(tag);
+		return (id != tag_id::unknown)
+			? name(id)
+			: intern(tag)
+			;
+	}
+
+	std::string_view intern_attribute(std::string const& attr)
+	{
+		auto const id = lookup_attribute(attr);
+		return (id != attr_id::unknown)
+			? name(id)
+			: intern(attr)
+			;
+	}
+
 	std::string patch_attribute_name(std::string name)
 	{
 		std::replace(name.begin(), name.end(), '_', '-');
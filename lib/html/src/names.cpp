@@ -0,0 +1,32 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <html/names.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace dom
+{
+	tag_id lookup_tag(std::string_view name)
+	{
+		auto const pos = std::lower_bound(std::begin(tag_names), std::end(tag_names), name);
+		return (pos != std::end(tag_names) && *pos == name)
+			? static_cast<tag_id>(std::distance(std::begin(tag_names), pos))
+			: tag_id::unknown
+			;
+	}
+
+	attr_id lookup_attribute(std::string_view name)
+	{
+		auto const pos = std::lower_bound(std::begin(attr_names), std::end(attr_names), name);
+		return (pos != std::end(attr_names) && *pos == name)
+			? static_cast<attr_id>(std::distance(std::begin(attr_names), pos))
+			: attr_id::unknown
+			;
+	}
+}
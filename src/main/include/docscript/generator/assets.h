@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_ASSETS_H
+#define DOCSCRIPT_GENERATOR_ASSETS_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <cyng/object.h>
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * Place referenced files (images) into an "assets" directory
+	 * instead of inlining them. File names are derived from the
+	 * content hash, so unchanged files keep their name and can be
+	 * cached by browsers across all pages. Thread-safe.
+	 */
+	class asset_store
+	{
+		struct asset
+		{
+			std::string source_;
+			std::uintmax_t size_;
+			bool created_;	//!< written in this run
+		};
+
+	public:
+		/**
+		 * @param root output directory. Assets are placed in root/assets.
+		 * @param threshold files up to this size stay inline
+		 * @param hardlink create hard links instead of copies if possible
+		 */
+		asset_store(cyng::filesystem::path const& root, std::uintmax_t threshold, bool hardlink);
+		asset_store(asset_store const&) = delete;
+		asset_store& operator=(asset_store const&) = delete;
+
+		/**
+		 * @return true if a file of the specified size should be inlined
+		 */
+		bool is_inline(std::uintmax_t size) const;
+
+		/**
+		 * Write compressed sidecars of new SVG assets.
+		 *
+		 * @param formats combination of precompress_format values
+		 */
+		void set_precompress(unsigned formats);
+
+		/**
+		 * Copy or link the file into the asset directory.
+		 *
+		 * @param hash content hash if already known - otherwise computed
+		 * @return URL relative to the root directory. Empty if the file
+		 * could not be placed.
+		 */
+		std::string emit(cyng::filesystem::path const& p, std::string hash);
+
+		/**
+		 * @return all emitted assets
+		 */
+		cyng::object to_object() const;
+
+		/**
+		 * write "manifest.json" into the asset directory
+		 *
+		 * @return false if the file could not be written
+		 */
+		bool write_manifest() const;
+
+	private:
+		cyng::filesystem::path const dir_;
+		std::uintmax_t const threshold_;
+		bool const hardlink_;
+		unsigned precompress_;
+
+		mutable std::mutex mutex_;
+
+		/**
+		 * file name => asset
+		 */
+		std::map<std::string, asset>	assets_;
+	};
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_BASE64_H
+#define DOCSCRIPT_GENERATOR_BASE64_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace docscript
+{
+	/**
+	 * @return number of characters required to encode the specified
+	 * number of bytes (including padding)
+	 */
+	std::size_t base64_encoded_size(std::size_t);
+
+	/**
+	 * Base64 encoding (RFC 4648) with padding and without line breaks.
+	 * Uses AVX2 or SSSE3 if supported by the CPU.
+	 *
+	 * @param dst output buffer with at least base64_encoded_size(size) characters
+	 * @return number of written characters
+	 */
+	std::size_t base64_encode(char const* src, std::size_t size, char* dst);
+
+	/**
+	 * Append the encoded data to the specified string
+	 */
+	void base64_encode(std::string&, char const* src, std::size_t size);
+
+	/**
+	 * Write the encoded data directly into the stream.
+	 * Uses a small buffer on the stack.
+	 */
+	void base64_encode(std::ostream&, char const* src, std::size_t size);
+
+	/**
+	 * @return name of the selected kernel: "avx2", "ssse3" or "scalar"
+	 */
+	char const* base64_kernel();
+}
+
+#endif
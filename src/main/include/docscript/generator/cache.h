@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_GENERATOR_CACHE_H
+#define DOCSCRIPT_GENERATOR_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * Content addressed cache of processed resources (encoded images, 
+	 * SVG fragments, ...). Shared by all documents of a batch or site build.
+	 *
+	 * The content hash of a file is recomputed only if size or 
+	 * modification time changed. If a directory is specified all entries 
+	 * survive the process. Thread-safe.
+	 */
+	class content_cache
+	{
+		struct fingerprint
+		{
+			std::uintmax_t size_;
+			std::int64_t mtime_;
+			std::string hash_;
+		};
+
+	public:
+		/**
+		 * @param dir cache directory. With an empty path all entries are kept 
+		 * in memory only.
+		 * @param limit maximum size of all entries held in memory
+		 */
+		explicit content_cache(cyng::filesystem::path const& dir, std::size_t limit = 256u * 1024u * 1024u);
+		content_cache(content_cache const&) = delete;
+		content_cache& operator=(content_cache const&) = delete;
+
+		/**
+		 * write the index of content hashes
+		 */
+		virtual ~content_cache();
+
+		/**
+		 * @return SHA-256 of file content as hex string. Empty string 
+		 * if file cannot be read.
+		 */
+		std::string get_hash(cyng::filesystem::path const&);
+
+		/**
+		 * @param key lookup key - typically created with make_key()
+		 * @param value receives the cached value
+		 * @return true if found
+		 */
+		bool get(std::string const& key, std::string& value);
+
+		/**
+		 * store a value
+		 */
+		void put(std::string const& key, std::string const& value);
+
+		/**
+		 * @return true if entries are stored on disk
+		 */
+		bool is_persistent() const;
+
+	private:
+		void load_index();
+		void save_index() const;
+		cyng::filesystem::path get_entry_path(std::string const& key) const;
+		void remember(std::string const& key, std::string const& value);
+
+	private:
+		cyng::filesystem::path const dir_;
+		std::size_t const limit_;
+
+		mutable std::mutex mutex_;
+
+		/**
+		 * file name => fingerprint
+		 */
+		std::map<std::string, fingerprint>	files_;
+
+		/**
+		 * in-memory values
+		 */
+		std::unordered_map<std::string, std::string>	values_;
+		std::size_t size_;
+	};
+
+	/**
+	 * @return SHA-256 of the specified data as hex string
+	 */
+	std::string compute_hash(char const* p, std::size_t size);
+	std::string compute_hash(std::string const&);
+
+	/**
+	 * @return lower case hex representation of the specified bytes
+	 */
+	std::string to_hex(unsigned char const* p, std::size_t size);
+
+	/**
+	 * Build a cache key from a content hash, a kind and all
+	 * parameters that influence the result.
+	 */
+	std::string make_key(std::string const& hash, std::string const& kind, std::string const& params);
+
+}
+
+#endif
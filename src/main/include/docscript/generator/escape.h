@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_ESCAPE_H
+#define DOCSCRIPT_GENERATOR_ESCAPE_H
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace docscript
+{
+	/**
+	 * Set of special characters. find() tests 16 (SSE2) or 32 (AVX2)
+	 * bytes per step. With more than 16 distinct characters or without
+	 * SIMD support the input is tested byte by byte.
+	 */
+	class char_set
+	{
+	public:
+		explicit char_set(std::string_view chars);
+
+		bool contains(char c) const;
+
+		/**
+		 * @return position of the first special character or end
+		 */
+		char const* find(char const* pos, char const* end) const;
+
+		/**
+		 * @return true if find() uses SIMD instructions
+		 */
+		bool is_simd() const;
+
+	private:
+		std::array<bool, 256> table_;
+		std::array<char, 16> chars_;
+
+		/**
+		 * each special character repeated 32 times, built once
+		 * for the SIMD compare
+		 */
+		alignas(32) std::array<std::array<char, 32>, 16> needles_;
+		std::size_t size_;
+		bool simd_;
+	};
+
+	/**
+	 * Replacement rules of a target language. All runs between
+	 * special characters are copied in bulk.
+	 *
+	 * Pairs are tested first ("<=" to "&leq;"). A character that
+	 * starts a pair but has no single replacement is copied.
+	 */
+	class escape_table
+	{
+	public:
+		struct pair_rule
+		{
+			char first_;
+			char second_;
+			std::string_view replacement_;
+		};
+
+	public:
+		escape_table(std::initializer_list<std::pair<char, std::string_view>> singles
+			, std::initializer_list<pair_rule> pairs = {});
+
+		/**
+		 * Append the escaped string
+		 */
+		void append(std::string&, std::string_view) const;
+
+		/**
+		 * @return escaped string
+		 */
+		std::string operator()(std::string_view) const;
+
+		/**
+		 * Write the escaped string
+		 */
+		void write(std::ostream&, std::string_view) const;
+
+		/**
+		 * @return replacement of a single character. data() is nullptr
+		 * if there is no replacement.
+		 */
+		std::string_view get(char c) const;
+
+	private:
+		static char_set make_specials(std::initializer_list<std::pair<char, std::string_view>> singles
+			, std::initializer_list<pair_rule> pairs);
+
+		template<typename F>
+		void scan(std::string_view, F&& emit) const;
+
+	private:
+		char_set const specials_;
+		std::array<std::string_view, 256> singles_;
+		std::vector<pair_rule> const pairs_;
+	};
+
+	/**
+	 * & < > " in HTML text
+	 */
+	escape_table const& html_text_escape();
+
+	/**
+	 * & < > " ' in HTML attribute values
+	 */
+	escape_table const& html_attribute_escape();
+
+	void escape_html(std::ostream&, std::string_view);
+	std::string escape_html(std::string_view);
+	void escape_html_attribute(std::ostream&, std::string_view);
+}
+
+#endif
@@ -16,7 +16,7 @@ namespace docscript
 	class gen_latex : public generator
 	{
 	public:
-		gen_latex(std::vector< cyng::filesystem::path > const&);
+		gen_latex(std::vector< cyng::filesystem::path > const&, bool sync = false);
 
 	private:
 		/**
@@ -62,11 +62,12 @@ namespace docscript
 		virtual void format_sup(cyng::context& ctx) override;
 		virtual void format_mark(cyng::context& ctx) override;
 
-		std::ofstream& emit_file(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_class(std::ofstream&) const;
-		std::ofstream& emit_title(std::ofstream&) const;
-		std::ofstream& emit_document(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_document(std::ofstream&, cyng::object) const;
+		std::ostream& emit_file(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_class(std::ostream&) const;
+		std::ostream& emit_title(std::ostream&) const;
+		std::ostream& emit_document(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_document(std::ostream&, cyng::object) const;
+		std::ostream& emit_intrinsic(std::ostream&, boost::uuids::uuid) const;
 
 		std::string create_section(std::size_t level, std::string tag, std::string title);
 
@@ -15,7 +15,7 @@ namespace docscript
 	class gen_asciidoc : public generator
 	{
 	public:
-		gen_asciidoc(std::vector< cyng::filesystem::path > const&);
+		gen_asciidoc(std::vector< cyng::filesystem::path > const&, bool sync = false);
 
 	private:
 		/**
@@ -61,9 +61,10 @@ namespace docscript
 		virtual void format_sup(cyng::context& ctx) override;
 		virtual void format_mark(cyng::context& ctx) override;
 
-		std::ofstream& emit_file(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_meta(std::ofstream&) const;
-		std::ofstream& emit_obj(std::ofstream&, cyng::object) const;
+		std::ostream& emit_file(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_meta(std::ostream&) const;
+		std::ostream& emit_obj(std::ostream&, cyng::object) const;
+		std::ostream& emit_intrinsic(std::ostream&, boost::uuids::uuid) const;
 
 	private:
 		//footnotes_t footnotes_;
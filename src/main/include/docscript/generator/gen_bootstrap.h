@@ -17,7 +17,9 @@ namespace docscript
 	class gen_bootstrap : public generator
 	{
 	public:
-		gen_bootstrap(std::vector< cyng::filesystem::path > const&);
+		gen_bootstrap(std::vector< cyng::filesystem::path > const&, bool sync = false);
+
+		virtual void reset() override;
 
 	private:
 		/**
@@ -66,13 +68,23 @@ namespace docscript
 		virtual void format_sup(cyng::context& ctx) override;
 		virtual void format_mark(cyng::context& ctx) override;
 
-		std::ofstream& emit_file(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_body(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_body(std::ofstream&, cyng::object) const;
-		std::ofstream& emit_footnotes(std::ofstream&) const;
-		std::ofstream& emit_intrinsic(std::ofstream&, boost::uuids::uuid) const;
-		std::ofstream& emit_toc(std::ofstream&, std::size_t) const;
-		std::ofstream& emit_toc(std::ofstream&, cyng::vector_t const&, std::size_t, std::size_t) const;
+		std::ostream& emit_file(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+
+		/**
+		 * emit_file() with all references resolved
+		 */
+		std::ostream& emit_resolved(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+
+		/**
+		 * @return link of the reference with the specified index
+		 */
+		std::string resolve_ref(std::size_t) const;
+		std::ostream& emit_body(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_body(std::ostream&, cyng::object) const;
+		std::ostream& emit_footnotes(std::ostream&) const;
+		std::ostream& emit_intrinsic(std::ostream&, boost::uuids::uuid) const;
+		std::ostream& emit_toc(std::ostream&, std::size_t) const;
+		std::ostream& emit_toc(std::ostream&, cyng::vector_t const&, std::size_t, std::size_t) const;
 
 		std::string compute_fig_title(boost::uuids::uuid tag, std::string caption);
 		std::string compute_tbl_title(boost::uuids::uuid tag, std::string caption);
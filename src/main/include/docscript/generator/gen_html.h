@@ -10,6 +10,9 @@
 
 #include <docscript/generator/generator.h>
 #include <docscript/generator/numbering.h>
+#include <docscript/generator/image.h>
+#include <docscript/generator/source.h>
+#include <docscript/generator/table.h>
 #include <html/dom.hpp>
 
 namespace docscript
@@ -17,7 +20,9 @@ namespace docscript
 	class gen_html : public generator
 	{
 	public:
-		gen_html(std::vector< cyng::filesystem::path > const&, bool body_only);
+		gen_html(std::vector< cyng::filesystem::path > const&, bool body_only, bool sync = false);
+
+		virtual void reset() override;
 
 	private:
 		/**
@@ -65,17 +70,27 @@ namespace docscript
 		virtual void format_sup(cyng::context& ctx) override;
 		virtual void format_mark(cyng::context& ctx) override;
 
-		std::ofstream& emit_file(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_doctype(std::ofstream&) const;
-		std::ofstream& emit_head(std::ofstream&) const;
-		std::ofstream& emit_meta(std::ofstream&) const;
-		std::ofstream& emit_styles(std::ofstream&) const;
-		std::ofstream& emit_body(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_body(std::ofstream&, cyng::object) const;
-		std::ofstream& emit_footnotes(std::ofstream&) const;
-		std::ofstream& emit_intrinsic(std::ofstream&, boost::uuids::uuid) const;
-		std::ofstream& emit_toc(std::ofstream&, std::size_t) const;
-		std::ofstream& emit_toc(std::ofstream&, cyng::vector_t const&, std::size_t, std::size_t) const;
+		std::ostream& emit_file(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+
+		/**
+		 * emit_file() with all references resolved
+		 */
+		std::ostream& emit_resolved(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+
+		/**
+		 * @return link of the reference with the specified index
+		 */
+		std::string resolve_ref(std::size_t) const;
+		std::ostream& emit_doctype(std::ostream&) const;
+		std::ostream& emit_head(std::ostream&) const;
+		std::ostream& emit_meta(std::ostream&) const;
+		std::ostream& emit_styles(std::ostream&) const;
+		std::ostream& emit_body(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_body(std::ostream&, cyng::object) const;
+		std::ostream& emit_footnotes(std::ostream&) const;
+		std::ostream& emit_intrinsic(std::ostream&, boost::uuids::uuid) const;
+		std::ostream& emit_toc(std::ostream&, std::size_t) const;
+		std::ostream& emit_toc(std::ostream&, cyng::vector_t const&, std::size_t, std::size_t) const;
 
 		std::string compute_fig_title(boost::uuids::uuid tag, std::string caption);
 		std::string compute_tbl_title(boost::uuids::uuid tag, std::string caption);
@@ -96,20 +111,103 @@ namespace docscript
 		const static std::string icon_caution_;
 	};
 
+	/**
+	 * Write a list of figures or tables as collapsible list of links.
+	 * Used by the HTML and Bootstrap generator.
+	 *
+	 * @param depth DOM serialization depth of the links
+	 * @param plain converts a caption with references into plain text
+	 */
+	std::ostream& emit_list(std::ostream&, std::list<element> const&, std::string const& name, std::size_t depth, std::function<std::string(std::string const&)> const& plain);
+
 	/**
 	 * Substitute HTML entities
 	 */
 	std::string replace_html_entities(std::string const& str);
 
+	/**
+	 * Element without attributes that contains the plain text of
+	 * the frame. Same result as dom::X(accumulate_plain_text(frame))(0)
+	 * but the text is copied only once.
+	 */
+	std::string make_inline(std::string_view tag, cyng::vector_t const& frame);
+
+	/**
+	 * Write an element without attributes that contains the text of
+	 * the rope.
+	 */
+	void write_inline(std::ostream&, std::string_view tag, rope const&);
+
+	/**
+	 * Link of a reference. Without a text of its own the link
+	 * shows the specified label text.
+	 *
+	 * @param lbl target or nullptr if the reference is dangling
+	 */
+	dom::element make_reference(reference const& ref, label const* lbl, std::string const& text);
+
 	/**
 	 * Create a HTML figure tag
+	 *
+	 * @param lazy image is below the fold and loaded on demand
 	 */
 	dom::element make_figure(cyng::filesystem::path
 		, std::string id
 		, double width
 		, std::string caption
 		, std::string title
-		, std::string alt);
+		, std::string alt
+		, content_cache*
+		, asset_store*
+		, bool lazy);
+
+	/**
+	 * Apply the filter of the specified language to a memory mapped
+	 * file and write the <pre> element into the specified stream. 
+	 * The result is cached by file content, language, line numbers, 
+	 * caption, tag and range. Without cache the output is not buffered.
+	 *
+	 * @param range selected lines and maximal size
+	 * @param tag prefix of line number ids
+	 */
+	void render_code(std::ostream&
+		, cyng::filesystem::path const& p
+		, excerpt const& range
+		, std::string const& language
+		, std::string const& caption
+		, bool line_numbers
+		, boost::uuids::uuid tag
+		, content_cache*);
+
+	/**
+	 * Stream a CSV file as HTML table. The first row is the table
+	 * header. All cells are escaped.
+	 *
+	 * @param limits row limit and rows per <tbody> element
+	 * @param notice text in the footer if the row limit was reached
+	 */
+	void render_table(std::ostream&
+		, cyng::filesystem::path const& p
+		, std::string const& id
+		, std::string const& caption
+		, table_limits const& limits
+		, std::string const& notice);
+
+	/**
+	 * Create an img tag with intrinsic size and optional lazy loading
+	 */
+	dom::element make_img(std::string const& alt
+		, std::string const& caption
+		, std::string const& max_width
+		, image_size_t const& dims
+		, bool lazy
+		, dom::attribute&& src);
+
+	/**
+	 * Intrinsic size of an image. Cached by content hash if 
+	 * a hash is available.
+	 */
+	image_size_t get_image_size(cyng::filesystem::path const&, std::string const& hash, content_cache*);
 }
 
 #endif
@@ -15,7 +15,9 @@ namespace docscript
 	class gen_md : public generator
 	{
 	public:
-		gen_md(std::vector< cyng::filesystem::path > const&);
+		gen_md(std::vector< cyng::filesystem::path > const&, bool sync = false);
+
+		virtual void reset() override;
 
 	private:
 		/**
@@ -61,13 +63,13 @@ namespace docscript
 		virtual void format_sup(cyng::context& ctx) override;
 		virtual void format_mark(cyng::context& ctx) override;
 
-		std::ofstream& emit_file(std::ofstream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
-		std::ofstream& emit_meta(std::ofstream&) const;
-		std::ofstream& emit_obj(std::ofstream&, cyng::object) const;
-		std::ofstream& emit_footnotes(std::ofstream&) const;
-		std::ofstream& emit_intrinsic(std::ofstream&, boost::uuids::uuid) const;
-		std::ofstream& emit_toc(std::ofstream&, std::size_t) const;
-		std::ofstream& emit_toc(std::ofstream&, cyng::vector_t const&, std::size_t, std::size_t) const;
+		std::ostream& emit_file(std::ostream&, cyng::vector_t::const_iterator, cyng::vector_t::const_iterator) const;
+		std::ostream& emit_meta(std::ostream&) const;
+		std::ostream& emit_obj(std::ostream&, cyng::object) const;
+		std::ostream& emit_footnotes(std::ostream&) const;
+		std::ostream& emit_intrinsic(std::ostream&, boost::uuids::uuid) const;
+		std::ostream& emit_toc(std::ostream&, std::size_t) const;
+		std::ostream& emit_toc(std::ostream&, cyng::vector_t const&, std::size_t, std::size_t) const;
 
 
 	private:
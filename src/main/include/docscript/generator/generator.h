@@ -9,6 +9,17 @@
 #define DOCSCRIPT_GENERATOR_H
 
 #include <docscript/generator/numbering.h>
+#include <docscript/generator/assets.h>
+#include <docscript/generator/cache.h>
+#include <docscript/generator/labels.h>
+#include <docscript/generator/placeholder.h>
+#include <docscript/generator/precompress.h>
+#include <docscript/generator/profiler.h>
+#include <docscript/generator/rope.h>
+#include <docscript/generator/sink.h>
+#include <docscript/generator/style.h>
+#include <docscript/generator/workers.h>
+#include <docscript/tracer.h>
 
 #include <cyng/intrinsics/sets.h>
 #include <cyng/vm/controller.h>
@@ -17,6 +28,18 @@
 
 #include <boost/uuid/name_generator.hpp>
 #include <boost/uuid/random_generator.hpp>
+#include <boost/asio/io_service.hpp>
+
+#include <map>
+#include <memory>
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace dom
+{
+	class element;
+}
 
 namespace docscript
 {
@@ -25,6 +48,7 @@ namespace docscript
 			WID_FIGURE,
 			WID_TABLE,
 			WID_TOC,
+			WID_TABLE_TRUNCATED,	//!<	notice below a table with row limit
 		};
 	}
 
@@ -34,19 +58,132 @@ namespace docscript
 	class generator
 	{
 	public:
-		generator(std::vector< cyng::filesystem::path > const&);
+		/**
+		 * Writes the output of a build-in function
+		 */
+		using writer_f = std::function<void(std::ostream&)>;
+
+	private:
+		/**
+		 * The build-in function that is currently running. Deferred
+		 * output is profiled and traced under its name.
+		 */
+		struct origin
+		{
+			std::string name_;
+			std::string file_;	//!<	empty if not available
+			std::size_t seq_;	//!<	sequence number in the profiler
+		};
+
+		/**
+		 * Output of an expensive build-in function. Without a worker 
+		 * pool the writer streams directly into the output file.
+		 */
+		struct deferred
+		{
+			writer_f writer_;
+			std::shared_future<std::string> result_;
+			origin origin_;
+		};
+
+	public:
+		/**
+		 * @param inc include paths
+		 * @param sync if true the program runs on the calling thread 
+		 * and no scheduler will be started. Default is the asynchronous
+		 * mode.
+		 */
+		generator(std::vector< cyng::filesystem::path > const& inc, bool sync = false);
 		virtual ~generator();
 
+		/**
+		 * Execute the specified program. In synchronous mode this 
+		 * function returns after the last instruction was processed.
+		 */
 		void run(cyng::vector_t&&);
 
+		/**
+		 * Clear all document related data (variables, meta data, 
+		 * content table, ...) to process the next program with 
+		 * the same instance. Requires synchronous mode.
+		 */
+		virtual void reset();
+
 		cyng::param_map_t const& get_meta() const;
 
+		/**
+		 * Record call counts, execution times and produced bytes
+		 * of all build-in functions.
+		 */
+		void set_profiling(bool);
+
+		/**
+		 * @return profiling data or nullptr if profiling is disabled
+		 */
+		profiler const* get_profiler() const;
+
+		/**
+		 * Record file output in the specified timing trace.
+		 * Pass nullptr to disable.
+		 */
+		void set_tracer(tracer*);
+
+		/**
+		 * Reuse processed resources (encoded images, ...) from
+		 * the specified cache. Pass nullptr to disable.
+		 */
+		void set_cache(content_cache*);
+
+		/**
+		 * Place images as external files instead of inlining them.
+		 * Pass nullptr to disable.
+		 */
+		void set_assets(asset_store*);
+
+		/**
+		 * Render expensive build-in functions (code, figure, gallery,
+		 * table) on the specified threads. Pass nullptr to render
+		 * them on the VM thread.
+		 */
+		void set_workers(worker_pool*);
+
+		/**
+		 * Reference a shared stylesheet instead of inlining all
+		 * style rules. Pass nullptr to disable.
+		 */
+		void set_style_sheet(style_sheet*);
+
+		/**
+		 * Write HTML without indentation, comments and redundant
+		 * whitespace.
+		 */
+		void set_minify(bool);
+
+		/**
+		 * Write compressed sidecars of HTML and JSON files.
+		 *
+		 * @param formats combination of precompress_format values
+		 */
+		void set_precompress(unsigned formats);
+
 	protected:
 		/**
 		 * register all build-in functions
 		 */
 		void register_this();
 
+		/**
+		 * Register a build-in function at the VM. Calls are
+		 * recorded if profiling is enabled.
+		 */
+		void register_function(std::string const& name, std::size_t arity, std::function<void(cyng::context&)> proc);
+
+		/**
+		 * Push a text result on the stack and account the
+		 * number of produced bytes.
+		 */
+		void push_text(cyng::context& ctx, std::string&&);
+
 		void init_meta_data(cyng::context& ctx);
 		void meta(cyng::context& ctx);
 		void var_set(cyng::context& ctx);
@@ -61,6 +198,73 @@ namespace docscript
 		virtual void make_map(cyng::context& ctx);
 		virtual void get_version(cyng::context& ctx);
 
+		/**
+		 * push the tag of the specified placeholder (list of figures, 
+		 * list of tables, footnotes)
+		 */
+		void make_placeholder(placeholder_kind, cyng::context& ctx);
+
+		/**
+		 * Count emitted images. All images after the first few
+		 * are assumed to be below the fold.
+		 *
+		 * @return true if the next image should be loaded lazily
+		 */
+		bool is_lazy_image();
+
+		/**
+		 * Generate a tag that is the same in each run as long as 
+		 * the document structure does not change. Each call with 
+		 * the same name yields the next tag of this name.
+		 */
+		boost::uuids::uuid make_stable_tag(std::string const& name);
+
+		/**
+		 * Push a DEFERRED placeholder. The output writer splices the 
+		 * result back in document order. With a worker pool the writer 
+		 * runs on a worker thread, otherwise it streams directly into the 
+		 * output file when the placeholder is emitted.
+		 *
+		 * Numbering, tags and all other document state must be computed
+		 * before. The writer must capture everything by value.
+		 * Time and output of the writer are profiled and traced under
+		 * the name of the calling build-in function.
+		 */
+		void push_deferred(cyng::context& ctx, writer_f);
+
+		/**
+		 * Write the result of a deferred build-in function. Waits for 
+		 * the worker if required.
+		 *
+		 * @param idx parameter of the DEFERRED placeholder
+		 */
+		void emit_deferred(std::ostream&, std::size_t idx) const;
+
+		/**
+		 * Push a DOM fragment of the document body. The element is
+		 * serialized directly into the output file when the placeholder
+		 * is emitted, so no intermediate strings are created.
+		 *
+		 * Only for standalone build-in functions (paragraph, quote, alert).
+		 * Results that are consumed by other functions must be pushed
+		 * as text.
+		 */
+		void push_element(cyng::context& ctx, dom::element&&, std::size_t depth);
+
+		/**
+		 * Push a writer that streams directly into the output file
+		 * when the placeholder is emitted. Never on a worker thread.
+		 * Same restrictions as push_element(). Time and output are
+		 * profiled under the name of the calling build-in function.
+		 */
+		void push_writer(cyng::context& ctx, writer_f);
+
+		/**
+		 * @return the specified indentation depth for DOM serialization
+		 * or dom::minified if minification is enabled.
+		 */
+		std::size_t indent(std::size_t) const;
+
 		virtual void generate_file(cyng::context& ctx) = 0;
 		virtual void generate_meta(cyng::context& ctx) = 0;
 		virtual void convert_numeric(cyng::context& ctx) = 0;
@@ -121,6 +325,32 @@ namespace docscript
 		 */
 		std::string get_name(i18n::word_id) const;
 
+		/**
+		 * @return default text of a reference to the specified label
+		 * like "Figure 3" or "2.1"
+		 */
+		std::string get_label_text(label const&) const;
+
+		/**
+		 * @return plain text of the reference with the specified index:
+		 * the link text, the label text or the name of the undefined label
+		 */
+		std::string get_ref_text(std::size_t) const;
+
+		/**
+		 * Replace the reference markers with plain text. Use this for
+		 * attributes and all other places where a link cannot be inserted.
+		 * Labels that are defined later in the document are known
+		 * only after the VM run.
+		 */
+		std::string resolve_plain(std::string const&) const;
+
+		/**
+		 * Replace the reference markers in the meta data with plain
+		 * text. Call this after the VM run.
+		 */
+		void resolve_meta();
+
 		/**
 		 * provide a slug if not defined yet
 		 */
@@ -134,7 +364,36 @@ namespace docscript
 		 */
 		boost::uuids::name_generator_sha1 name_gen_;
 
-		cyng::async::scheduler	scheduler_;
+		/**
+		 * precomputed tags of all intrinsic markers
+		 */
+		placeholders placeholders_;
+
+		/**
+		 * name based UUIDs in a fixed namespace
+		 */
+		boost::uuids::name_generator_sha1 stable_gen_;
+
+		/**
+		 * number of stable tags generated for each name
+		 */
+		std::map<std::string, std::size_t> stable_tags_;
+
+		/**
+		 * synchronous execution mode
+		 */
+		bool const sync_;
+
+		/**
+		 * In synchronous mode the VM is bound to this I/O context
+		 * which is driven by the calling thread.
+		 */
+		boost::asio::io_service io_;
+
+		/**
+		 * only available in asynchronous mode
+		 */
+		std::unique_ptr<cyng::async::scheduler> scheduler_;
 		cyng::controller vm_;
 
 		/**
@@ -146,18 +405,92 @@ namespace docscript
 		std::vector< cyng::filesystem::path > const includes_;
 		numbering content_table_;
 
+		/**
+		 * targets and references of the current document
+		 */
+		label_table labels_;
+
 		/**
 		 * meta data
 		 */
 		cyng::param_map_t meta_;
 
+		/**
+		 * optional profiling data
+		 */
+		std::unique_ptr<profiler> profiler_;
+
+		/**
+		 * bytes produced by the current build-in function
+		 */
+		std::size_t produced_;
+
+		/**
+		 * current build-in function
+		 */
+		origin current_;
+
+		/**
+		 * number of images in the current document
+		 */
+		std::size_t images_;
+
+		/**
+		 * optional timing trace
+		 */
+		tracer* tracer_;
+
+		/**
+		 * optional cache of processed resources
+		 */
+		content_cache* cache_;
+
+		/**
+		 * optional external asset directory
+		 */
+		asset_store* assets_;
+
+		/**
+		 * optional threads for expensive build-in functions
+		 */
+		worker_pool* workers_;
+
+		/**
+		 * optional external stylesheet
+		 */
+		style_sheet* style_sheet_;
+
+		/**
+		 * write minified HTML
+		 */
+		bool minify_;
+
+		/**
+		 * formats of compressed sidecars
+		 */
+		unsigned precompress_;
+
+		/**
+		 * deferred output of the current document
+		 */
+		std::vector<deferred> deferred_;
+
 	};
 
 	std::string get_extension(cyng::filesystem::path const& p);
 
-	std::string accumulate_plain_text(cyng::object);
-	std::string accumulate_plain_text(cyng::tuple_t);
-	std::string accumulate_plain_text(cyng::vector_t);
+	std::string accumulate_plain_text(cyng::object const&);
+	std::string accumulate_plain_text(cyng::tuple_t const&);
+	std::string accumulate_plain_text(cyng::vector_t const&);
+
+	/**
+	 * Append the plain text as segments. Strings are referenced,
+	 * so the objects must outlive the rope. Nested tuples and
+	 * vectors are not flattened.
+	 */
+	void accumulate_plain_text(rope&, cyng::object const&);
+	void accumulate_plain_text(rope&, cyng::tuple_t const&);
+	void accumulate_plain_text(rope&, cyng::vector_t const&);
 
 	/**
 	 * @brief generate_slug
@@ -0,0 +1,38 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_IMAGE_H
+#define DOCSCRIPT_GENERATOR_IMAGE_H
+
+#include <cstdint>
+#include <utility>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * width and height in pixel
+	 */
+	using image_size_t = std::pair<std::uint32_t, std::uint32_t>;
+
+	/**
+	 * Read the intrinsic size of a PNG, JPEG, GIF or WebP image from
+	 * the file header. The image is not decoded.
+	 *
+	 * @return {0, 0} if format is unknown or the header is damaged
+	 */
+	image_size_t get_image_size(cyng::filesystem::path const&);
+
+	/**
+	 * Same as above, but from a memory buffer that contains
+	 * at least the header.
+	 */
+	image_size_t get_image_size(char const* p, std::size_t size);
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_LABELS_H
+#define DOCSCRIPT_GENERATOR_LABELS_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+
+namespace docscript
+{
+	enum class label_kind : std::uint8_t
+	{
+		HEADING,
+		FIGURE,
+		TABLE,
+		FOOTNOTE,
+	};
+
+	/**
+	 * Target of a reference
+	 */
+	struct label
+	{
+		label_kind kind_;
+		std::string number_;
+		std::string caption_;
+	};
+
+	/**
+	 * Reference to a label. The label can be defined later
+	 * in the document.
+	 */
+	struct reference
+	{
+		boost::uuids::uuid tag_;
+
+		/**
+		 * name as used in the document
+		 */
+		std::string name_;
+
+		/**
+		 * optional link text
+		 */
+		std::string text_;
+	};
+
+	/**
+	 * All labels (headings, figures, tables, footnotes) and references
+	 * of a document.
+	 *
+	 * A reference is pushed as a marker since a forward reference
+	 * cannot be resolved while the VM is running. The markers are
+	 * replaced by the label_stream when the output file is written.
+	 */
+	class label_table
+	{
+	public:
+		/**
+		 * A marker is this character, the index of the reference and
+		 * this character again. Control characters are not valid in HTML.
+		 */
+		static constexpr char marker = '\x1a';
+
+	public:
+		label_table();
+
+		/**
+		 * Define a label. The first definition of a tag wins.
+		 *
+		 * @return false if the tag is already defined
+		 */
+		bool add(boost::uuids::uuid const&, label_kind, std::string number, std::string caption);
+
+		/**
+		 * @return nullptr if the tag is not defined
+		 */
+		label const* find(boost::uuids::uuid const&) const;
+
+		/**
+		 * Register a reference
+		 *
+		 * @return marker of the reference
+		 */
+		std::string add_ref(boost::uuids::uuid const&, std::string name, std::string text);
+
+		/**
+		 * @return reference with the specified index or nullptr
+		 */
+		reference const* get_ref(std::size_t) const;
+
+		bool has_refs() const;
+
+		/**
+		 * Write a warning for each reference without target
+		 *
+		 * @return number of dangling references
+		 */
+		std::size_t report_dangling() const;
+
+		void clear();
+
+	private:
+		std::unordered_map<boost::uuids::uuid, label, boost::hash<boost::uuids::uuid>> labels_;
+		std::vector<reference> refs_;
+	};
+
+	/**
+	 * Stream buffer that replaces the reference markers with the
+	 * result of the resolver and writes everything else unchanged
+	 * into the target buffer. Markers can span multiple writes.
+	 */
+	class label_buffer : public std::streambuf
+	{
+	public:
+		using resolver_f = std::function<std::string(std::size_t)>;
+
+	public:
+		label_buffer(std::streambuf*, resolver_f);
+		virtual ~label_buffer();
+
+		/**
+		 * Process all pending data. An incomplete marker is
+		 * written unchanged.
+		 */
+		void close();
+
+	protected:
+		virtual int_type overflow(int_type c) override;
+		virtual std::streamsize xsputn(char const* s, std::streamsize n) override;
+		virtual int sync() override;
+
+	private:
+		void process_buffer();
+		void process(char const* s, std::size_t n);
+
+		/**
+		 * write the marker that is pending as text
+		 */
+		void write_pending();
+
+	private:
+		std::streambuf* target_;
+		resolver_f const resolver_;
+		std::vector<char> buffer_;
+
+		/**
+		 * inside a marker
+		 */
+		bool open_;
+
+		/**
+		 * digits of the current marker
+		 */
+		std::string index_;
+	};
+
+	/**
+	 * Output stream that resolves the reference markers.
+	 * Pending data are written by the destructor.
+	 */
+	class label_stream : public std::ostream
+	{
+	public:
+		label_stream(std::ostream&, label_buffer::resolver_f);
+		virtual ~label_stream();
+
+	private:
+		label_buffer buffer_;
+	};
+
+	/**
+	 * @return string with all reference markers replaced by
+	 * the result of the resolver
+	 */
+	std::string resolve_markers(std::string const&, label_buffer::resolver_f const&);
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_MINIFY_H
+#define DOCSCRIPT_GENERATOR_MINIFY_H
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace docscript
+{
+	/**
+	 * Stream buffer that minifies HTML on the fly and writes
+	 * the result into the target buffer:
+	 *
+	 * - collapse whitespace in text and remove it next to block level tags
+	 * - remove comments
+	 * - remove redundant whitespace and quotes in tags
+	 * - omit optional end tags (li, dt, dd, tr, td, th, option)
+	 * - collapse whitespace in style sheets
+	 *
+	 * The content of pre, textarea and script elements is not changed.
+	 * Data are processed in chunks, so the document is never
+	 * stored completely.
+	 */
+	class minify_buffer : public std::streambuf
+	{
+		enum class state {
+			TEXT,
+			TAG,		//!<	from '<' to '>'
+			COMMENT,
+			RAW,		//!<	pre, textarea, script
+			STYLE,
+		};
+
+	public:
+		explicit minify_buffer(std::streambuf*);
+		virtual ~minify_buffer();
+
+		/**
+		 * Process all pending data. An incomplete tag is written
+		 * unchanged.
+		 */
+		void close();
+
+	protected:
+		virtual int_type overflow(int_type c) override;
+		virtual std::streamsize xsputn(char const* s, std::streamsize n) override;
+		virtual int sync() override;
+
+	private:
+		void process_buffer();
+		void process(char const* s, std::size_t n);
+		void text(char c);
+		void tag(char c);
+		void comment(char c);
+		void raw(char c);
+		void style(char c);
+
+		/**
+		 * Write the complete tag in tag_
+		 */
+		void emit_tag();
+
+		/**
+		 * Emit pending whitespace of the text
+		 */
+		void emit_space();
+
+		/**
+		 * Search the end tag of pre, textarea, script and style
+		 *
+		 * @return true if the end tag was found
+		 */
+		bool match_end(char c);
+
+	private:
+		std::streambuf* target_;
+		std::vector<char> buffer_;
+
+		/**
+		 * processed output of the current chunk
+		 */
+		std::string out_;
+
+		state state_;
+
+		/**
+		 * current tag
+		 */
+		std::string tag_;
+		char quote_;
+
+		/**
+		 * whitespace in text not written yet
+		 */
+		bool space_;
+
+		/**
+		 * last tag was a block level tag
+		 */
+		bool block_;
+
+		/**
+		 * last character written in a style sheet
+		 */
+		char last_;
+
+		/**
+		 * end tag of raw content ("</pre") and number
+		 * of matching characters
+		 */
+		std::string end_;
+		std::size_t match_;
+	};
+
+	/**
+	 * Output stream that minifies HTML into the specified stream.
+	 * Pending data are written by the destructor.
+	 */
+	class minify_stream : public std::ostream
+	{
+	public:
+		explicit minify_stream(std::ostream&);
+		virtual ~minify_stream();
+
+	private:
+		minify_buffer buffer_;
+	};
+}
+
+#endif
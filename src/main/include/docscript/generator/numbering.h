@@ -11,48 +11,89 @@
 #include <cyng/object.h>
 #include <cyng/intrinsics/sets.h>
 
-#include <memory>
+#include <list>
 #include <string>
-//#include <vector>
+#include <vector>
 #include <boost/uuid/uuid.hpp>
 
 namespace docscript
 {
 	/**
 	 * content table as hierarchical structure.
-	 * Each node has an optional sibbling (next_) and
-	 * one child (sub_) optionally.
+	 * All entries are stored in document order. The path of the
+	 * last entry on each level is kept, so adding a heading
+	 * doesn't depend on the size of the document.
 	 */
 	class numbering
 	{
-		friend cyng::vector_t serialize(numbering const&);
-		friend cyng::vector_t serialize(std::size_t depth, numbering const* p, std::vector<std::size_t>);
+		friend cyng::vector_t const& serialize(numbering const&);
+
+	public:
+		struct entry
+		{
+			boost::uuids::uuid const tag_;
+			std::string const title_;
+
+			/**
+			 * like 3.2.5
+			 */
+			std::string const number_;
+
+			/**
+			 * 1 for top level entries
+			 */
+			std::size_t const depth_;
+
+			/**
+			 * position in the parent entry
+			 */
+			std::size_t const index_;
+		};
 
 	public:
 		numbering();
-		numbering(boost::uuids::uuid, std::string);
-		numbering(numbering&&) = default;
-		numbering& operator=(numbering&&) = default;
-		virtual ~numbering();
 
+		/**
+		 * @return numbering of the new entry
+		 */
 		std::string add(std::size_t level, boost::uuids::uuid, std::string);
 
+		/**
+		 * remove all entries
+		 */
+		void clear();
+
+		/**
+		 * @return all entries in document order
+		 */
+		std::vector<entry> const& get_entries() const;
+
 	private:
-		void add(std::vector<std::size_t>&, std::size_t level, numbering*);
-		void add_next(numbering*);
-		void add_sub(numbering*);
+		std::size_t append(std::size_t parent, std::size_t depth, std::size_t index, boost::uuids::uuid, std::string const&);
+
+		/**
+		 * @param pos position in entries_ - will be advanced
+		 */
+		cyng::vector_t serialize(std::size_t& pos, std::size_t depth) const;
 
 	private:
-		boost::uuids::uuid const tag_;
-		std::string const title_;
+		/**
+		 * The first entry is an empty root with the number 0. Entries
+		 * below the first heading get a number like 0.1 and are not
+		 * part of the outline.
+		 */
+		std::vector<entry> entries_;
+
+		/**
+		 * last entry of each level (current path)
+		 */
+		std::vector<std::size_t> path_;
 
 		/**
-		 * @brief next_ We have to work with pointers since
-		 * std::optional<> requires complete types and no recursive
-		 * declarations are possible.
+		 * result of serialize() - valid until the next insert
 		 */
-		std::unique_ptr<numbering> next_;	//	sibling
-		std::unique_ptr<numbering> sub_;	//	child
+		mutable cyng::vector_t outline_;
+		mutable bool valid_;
 	};
 
 	/**
@@ -62,11 +103,11 @@ namespace docscript
 	std::string get_numbering(std::vector<std::size_t> const&);
 
 	/**
-	 * Convert a tree of numbering classes into a string
-	 * like 3.2.5 ...
+	 * Convert the content table into a tree of parameter maps
+	 * (tag, title, number, depth and sub).
+	 * The result is cached until the next entry is added.
 	 */
-	cyng::vector_t serialize(numbering const&);
-	cyng::vector_t serialize(std::size_t, numbering const* n, std::vector<std::size_t>);
+	cyng::vector_t const& serialize(numbering const&);
 
 	/**
 	 * element like table, figure, footnote with an UUID
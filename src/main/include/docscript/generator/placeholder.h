@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_GENERATOR_PLACEHOLDER_H
+#define DOCSCRIPT_GENERATOR_PLACEHOLDER_H
+
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/name_generator.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace docscript
+{
+	/**
+	 * Content that is not available before the whole
+	 * document was processed.
+	 */
+	enum class placeholder_kind : std::uint8_t
+	{
+		TOC,	//!<	table of contents (parameter is depth)
+		LIST_OF_FIGURES,
+		LIST_OF_TABLES,
+		FOOTNOTES,
+		DEFERRED,	//!<	content produced by a worker thread (parameter is an index)
+	};
+
+	struct placeholder
+	{
+		placeholder_kind kind_;
+		std::size_t param_;
+	};
+
+	/**
+	 * Registry of all placeholder tags. The tags of the intrinsic
+	 * markers are computed once per generator so a lookup costs no
+	 * SHA-1 computation.
+	 */
+	class placeholders
+	{
+	public:
+		/**
+		 * Maximal depth of the table of contents. 
+		 * "[ToC]" has this depth, "[ToC-1]" ... "[ToC-4]" the specified depth.
+		 */
+		static constexpr std::size_t max_toc_depth = 5;
+
+	public:
+		placeholders(boost::uuids::name_generator_sha1 const&);
+
+		/**
+		 * @return the tag of the table of contents with the specified depth
+		 */
+		boost::uuids::uuid get_toc(std::size_t depth) const;
+
+		/**
+		 * @return tag of list of figures, list of tables or footnotes
+		 */
+		boost::uuids::uuid get(placeholder_kind) const;
+
+		/**
+		 * @return nullptr if tag is not a placeholder
+		 */
+		placeholder const* find(boost::uuids::uuid const&) const;
+
+		/**
+		 * Register an additional placeholder
+		 */
+		void add(boost::uuids::uuid const&, placeholder_kind, std::size_t param);
+
+		/**
+		 * remove all additional placeholders
+		 */
+		void clear();
+
+	private:
+		std::array<boost::uuids::uuid, max_toc_depth> const toc_;
+		boost::uuids::uuid const lof_, lot_, footnotes_;
+		std::unordered_map<boost::uuids::uuid, placeholder, boost::hash<boost::uuids::uuid>> map_;
+	};
+
+}
+
+#endif
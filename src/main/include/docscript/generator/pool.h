@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_GENERATOR_POOL_H
+#define DOCSCRIPT_GENERATOR_POOL_H
+
+#include <docscript/generator/generator.h>
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace docscript
+{
+	/**
+	 * Thread-safe pool of warm generator instances keyed by 
+	 * output format. Building a generator is expensive (random generator,
+	 * VM and registration of all build-in functions) so batch and site 
+	 * builds reuse the instances.
+	 *
+	 * The pool has to outlive all acquired generators.
+	 */
+	class generator_pool
+	{
+	public:
+		generator_pool(std::vector< cyng::filesystem::path > const& inc);
+		generator_pool(generator_pool const&) = delete;
+		generator_pool& operator=(generator_pool const&) = delete;
+
+		/**
+		 * Get an idle generator or create a new one. 
+		 * When the last reference is released the generator will be 
+		 * reset and returned into the pool.
+		 *
+		 * @param format output format as provided by get_format()
+		 * @return empty pointer if format is unknown
+		 */
+		std::shared_ptr<generator> acquire(std::string const& format);
+
+		/**
+		 * @return count of idle generators
+		 */
+		std::size_t size() const;
+
+	private:
+		void release(std::string const& format, generator*);
+
+	private:
+		std::vector< cyng::filesystem::path > const includes_;
+
+		mutable std::mutex mutex_;
+		std::map<std::string, std::vector<std::unique_ptr<generator>>>	idle_;
+	};
+
+	/**
+	 * Create a generator in synchronous mode.
+	 *
+	 * @param format output format as provided by get_format()
+	 * @return empty pointer if format is unknown
+	 */
+	std::unique_ptr<generator> make_generator(std::string const& format, std::vector< cyng::filesystem::path > const& inc);
+
+	/**
+	 * Map the file extension of the output file to an output format:
+	 * "html", "html-body", "md", "asciidoc", "tex" or "bootstrap".
+	 *
+	 * @return empty string if extension is unknown
+	 */
+	std::string get_format(std::string const& extension, bool body_only);
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_PRECOMPRESS_H
+#define DOCSCRIPT_GENERATOR_PRECOMPRESS_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * Formats of precompressed sidecar files
+	 */
+	enum precompress_format : unsigned
+	{
+		PRECOMPRESS_NONE = 0,
+		PRECOMPRESS_GZIP = 1,	//!<	".gz"
+		PRECOMPRESS_ZSTD = 2,	//!<	".zst"
+	};
+
+	/**
+	 * @return all formats supported by this build. Depends on the
+	 * libraries (zlib, libzstd) found at configure time.
+	 */
+	unsigned precompress_formats();
+
+	/**
+	 * Write compressed copies of an output file (index.html.gz,
+	 * index.html.zst) that web servers can deliver without compressing
+	 * at request time. Data are compressed with the highest level.
+	 *
+	 * Each sidecar contains the SHA-256 of the uncompressed content
+	 * (gzip: file comment, zstd: skippable frame). The content is only
+	 * hashed while it is written. If an existing sidecar has the same 
+	 * hash, the file is not compressed again and the sidecar is kept, 
+	 * so timestamps and ETags of unchanged files stay stable.
+	 */
+	class precompressor
+	{
+		struct sidecar;
+		struct gzip_sidecar;
+		struct zstd_sidecar;
+
+	public:
+		/**
+		 * @param p path of the uncompressed file
+		 * @param formats combination of precompress_format values
+		 */
+		precompressor(cyng::filesystem::path const& p, unsigned formats);
+		precompressor(precompressor const&) = delete;
+		precompressor& operator=(precompressor const&) = delete;
+
+		virtual ~precompressor();
+
+		/**
+		 * hash the next chunk
+		 */
+		void write(char const* s, std::size_t n);
+
+		/**
+		 * Compress the file into all sidecars with a different hash.
+		 * The uncompressed file must be complete and closed.
+		 *
+		 * @return false if an error occured
+		 */
+		bool close();
+
+	private:
+		cyng::filesystem::path const path_;
+		unsigned const formats_;
+
+		/**
+		 * SHA-256 of the uncompressed content
+		 */
+		struct digest;
+		std::unique_ptr<digest> digest_;
+	};
+
+	/**
+	 * Write the sidecars of an existing file.
+	 *
+	 * @return false if an error occured
+	 */
+	bool precompress_file(cyng::filesystem::path const& p, unsigned formats);
+}
+
+#endif
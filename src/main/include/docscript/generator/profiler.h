@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_GENERATOR_PROFILER_H
+#define DOCSCRIPT_GENERATOR_PROFILER_H
+
+#include <cyng/object.h>
+#include <cyng/intrinsics/sets.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace docscript
+{
+	/**
+	 * Collect execution statistics of all build-in functions
+	 * of the generator VM. Thread-safe, so deferred output rendered
+	 * by parallel workers can be added.
+	 */
+	class profiler
+	{
+	public:
+		using clock_t = std::chrono::steady_clock;
+
+		/**
+		 * accumulated values of one build-in function
+		 */
+		struct entry
+		{
+			std::size_t calls_;
+			clock_t::duration total_;
+			clock_t::duration max_;
+			std::size_t bytes_;
+		};
+
+		/**
+		 * a single call
+		 */
+		struct call
+		{
+			std::string name_;
+			std::size_t seq_;	//!<	sequence number of call
+			clock_t::duration duration_;
+			std::size_t bytes_;
+			std::string file_;	//!<	empty if not available
+			std::size_t line_;	//!<	0 if not available
+		};
+
+	public:
+		/**
+		 * @param top_n number of slowest calls to keep
+		 */
+		explicit profiler(std::size_t top_n = 10);
+
+		/**
+		 * Update statistics of the specified build-in function
+		 */
+		void record(std::string const& name
+			, clock_t::duration
+			, std::size_t bytes
+			, std::string const& file
+			, std::size_t line);
+
+		/**
+		 * @return sequence number of the next recorded call
+		 */
+		std::size_t next_seq() const;
+
+		/**
+		 * Add the time and output of deferred work to a call.
+		 * The number of calls doesn't change.
+		 *
+		 * @param seq sequence number of the call
+		 */
+		void add(std::string const& name
+			, clock_t::duration
+			, std::size_t bytes
+			, std::string const& file
+			, std::size_t seq);
+
+		/**
+		 * remove all entries
+		 */
+		void clear();
+
+		/**
+		 * @return true if no call was recorded
+		 */
+		bool empty() const;
+
+		/**
+		 * @return all statistics as JSON compatible object
+		 */
+		cyng::object to_object() const;
+
+		/**
+		 * Print a summary table ordered by cumulative time
+		 */
+		void print(std::ostream&) const;
+
+	private:
+		/**
+		 * @return statistics of the specified build-in function,
+		 * created if required
+		 */
+		entry& get_entry(std::string const& name);
+
+		/**
+		 * Merge the call with an entry of the same sequence number
+		 * and update the list of the slowest calls.
+		 *
+		 * @return total duration of the call
+		 */
+		clock_t::duration merge(call&&);
+
+	private:
+		std::size_t const top_n_;
+		mutable std::mutex mutex_;
+		std::size_t seq_;
+		std::map<std::string, entry>	entries_;
+
+		/**
+		 * The slowest calls in descending order
+		 */
+		std::vector<call>	slowest_;
+	};
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_ROPE_H
+#define DOCSCRIPT_GENERATOR_ROPE_H
+
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace docscript
+{
+	/**
+	 * List of text segments. Segments are referenced, not copied,
+	 * so nested fragments are linked instead of concatenated.
+	 * The bytes are copied once by str(), append_to() or write().
+	 *
+	 * Referenced strings must outlive the rope.
+	 */
+	class rope
+	{
+	public:
+		rope();
+		rope(rope const&) = delete;
+		rope& operator=(rope const&) = delete;
+		rope(rope&&) = default;
+		rope& operator=(rope&&) = default;
+
+		/**
+		 * Reference a segment
+		 */
+		rope& append(std::string_view);
+
+		/**
+		 * Append a segment that is owned by the rope
+		 */
+		rope& append(std::string&&);
+
+		/**
+		 * Append an empty segment that can be filled later.
+		 *
+		 * @return index of the segment
+		 */
+		std::size_t mark();
+
+		/**
+		 * Set the content of a segment created by mark()
+		 */
+		void fill(std::size_t idx, std::string_view);
+
+		/**
+		 * @return total size in bytes
+		 */
+		std::size_t size() const;
+		bool empty() const;
+
+		/**
+		 * @return last character. The rope must not be empty.
+		 */
+		char back() const;
+
+		/**
+		 * Copy all segments into one string
+		 */
+		std::string str() const;
+		void append_to(std::string&) const;
+		void write(std::ostream&) const;
+
+		void clear();
+
+	private:
+		std::vector<std::string_view> segments_;
+
+		/**
+		 * owned segments. A deque never moves its elements.
+		 */
+		std::deque<std::string> owned_;
+		std::size_t size_;
+	};
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_GENERATOR_SINK_H
+#define DOCSCRIPT_GENERATOR_SINK_H
+
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	class precompressor;
+
+	/**
+	 * Stream buffer with a large user-space buffer. 
+	 * Data are written to the target only if the buffer is full 
+	 * or the buffer is closed. sync() (std::endl, std::flush) does 
+	 * not write anything.
+	 */
+	class sink_buffer : public std::streambuf
+	{
+	public:
+		/**
+		 * Write into a file. The file is owned by the buffer 
+		 * if close_file is true.
+		 */
+		sink_buffer(std::FILE*, bool close_file, std::size_t size);
+
+		/**
+		 * Append all data to the specified string
+		 */
+		sink_buffer(std::string&, std::size_t size);
+
+		virtual ~sink_buffer();
+
+		/**
+		 * write all pending data and close the file
+		 *
+		 * @return false if an error occured
+		 */
+		bool close();
+
+		bool is_open() const;
+
+		/**
+		 * Pass all data to the specified precompressor too. 
+		 * Must be set before the first write.
+		 */
+		void set_precompressor(std::unique_ptr<precompressor>);
+
+	protected:
+		virtual int_type overflow(int_type c) override;
+		virtual std::streamsize xsputn(char const* s, std::streamsize n) override;
+		virtual int sync() override;
+
+	private:
+		bool write_buffer();
+		bool write(char const* s, std::size_t n);
+
+	private:
+		std::FILE* file_;
+		bool const close_file_;
+		std::string* str_;
+		std::vector<char> buffer_;
+		bool good_;
+		std::unique_ptr<precompressor> precompressor_;
+	};
+
+	/**
+	 * Output stream shared by all generators. 
+	 * Writes through a large buffer to a file, stdout/pipe or string 
+	 * and never flushes per line.
+	 */
+	class sink : public std::ostream
+	{
+	public:
+		/**
+		 * 64 KB
+		 */
+		static constexpr std::size_t default_buffer_size = 0x10000;
+
+		/**
+		 * Open the specified file for writing. The path "-" selects stdout.
+		 */
+		explicit sink(cyng::filesystem::path const&, std::size_t size = default_buffer_size);
+
+		/**
+		 * Write to an already opened file or pipe (not owned).
+		 */
+		explicit sink(std::FILE*, std::size_t size = default_buffer_size);
+
+		/**
+		 * Append to the specified string.
+		 */
+		explicit sink(std::string&, std::size_t size = default_buffer_size);
+
+		/**
+		 * Calls close()
+		 */
+		virtual ~sink();
+
+		bool is_open() const;
+
+		/**
+		 * Write compressed sidecar files (".gz", ".zst") next to
+		 * the output file. Call this before writing anything.
+		 * Has no effect for stdout and strings.
+		 *
+		 * @param formats combination of precompress_format values
+		 */
+		void precompress(unsigned formats);
+
+		/**
+		 * write all pending data to the target.
+		 */
+		void close();
+
+	private:
+		cyng::filesystem::path const path_;
+		sink_buffer buffer_;
+	};
+
+}
+
+#endif
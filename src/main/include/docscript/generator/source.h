@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_SOURCE_H
+#define DOCSCRIPT_GENERATOR_SOURCE_H
+
+#include <cstddef>
+
+#include <cyng/compatibility/file_system.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace docscript
+{
+	/**
+	 * Part of a source file as specified by the parameters 
+	 * "first", "last" and "maxsize" of the code() function.
+	 */
+	struct excerpt
+	{
+		std::size_t first_;	//!<	first line (1-based), 0 is the start of the file
+		std::size_t last_;	//!<	last line (inclusive), 0 is the end of the file
+		std::size_t max_size_;	//!<	size limit in bytes, 0 is unlimited
+	};
+
+	/**
+	 * Read-only view of a source file for the code() filters. 
+	 * The file is memory mapped and the filters read directly from 
+	 * the mapping. An excerpt of a huge file is selected by a line 
+	 * range and a size limit without loading the whole file.
+	 */
+	class source_file
+	{
+	public:
+		/**
+		 * The excerpt is cut after the last complete line within 
+		 * the size limit. A single line longer than the limit is
+		 * cut at the last UTF-8 code point boundary.
+		 */
+		source_file(cyng::filesystem::path const&, excerpt const& = excerpt{ 0, 0, 0 });
+		source_file(source_file const&) = delete;
+		source_file& operator=(source_file const&) = delete;
+
+		/**
+		 * @return false if file cannot be mapped
+		 */
+		bool is_open() const;
+
+		char const* begin() const;
+		char const* end() const;
+		std::size_t size() const;
+
+		/**
+		 * @return number of lines skipped before the excerpt. 
+		 * Filters add this value to their line numbers.
+		 */
+		std::size_t get_offset() const;
+
+		/**
+		 * @return number of bytes skipped before the excerpt.
+		 * Binary filters add this value to their positions.
+		 */
+		std::size_t get_position() const;
+
+		/**
+		 * @return true if the excerpt was cut because of the size limit
+		 */
+		bool is_truncated() const;
+
+	private:
+		void select(std::size_t first, std::size_t last, std::size_t max_size);
+
+	private:
+		boost::interprocess::file_mapping file_;
+		boost::interprocess::mapped_region region_;
+		bool open_;
+		char const* begin_;
+		char const* end_;
+		std::size_t offset_;
+		bool truncated_;
+	};
+}
+
+#endif
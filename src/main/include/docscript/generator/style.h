@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_STYLE_H
+#define DOCSCRIPT_GENERATOR_STYLE_H
+
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * CSS rules for above-the-fold content (body and headings)
+	 */
+	std::ostream& emit_critical_rules(std::ostream&);
+
+	/**
+	 * CSS rules for all other elements (figures, gallery, tables,
+	 * code, footnotes, alerts)
+	 */
+	std::ostream& emit_style_rules(std::ostream&);
+
+	/**
+	 * Write all CSS rules of the HTML generator once per build into
+	 * an external file instead of repeating them in the head of
+	 * each page. The file name contains the content hash, so
+	 * browsers can cache it without expiration. Thread-safe.
+	 */
+	class style_sheet
+	{
+	public:
+		/**
+		 * @param root output directory. The stylesheet is placed in root/css.
+		 * @param critical keep the critical rules inline
+		 */
+		style_sheet(cyng::filesystem::path const& root, bool critical);
+		style_sheet(style_sheet const&) = delete;
+		style_sheet& operator=(style_sheet const&) = delete;
+
+		/**
+		 * Write the stylesheet if not done yet.
+		 *
+		 * @return URL relative to the root directory. Empty if the file
+		 * could not be written.
+		 */
+		std::string emit();
+
+		/**
+		 * @return true if critical rules stay inline
+		 */
+		bool is_critical() const;
+
+	private:
+		cyng::filesystem::path const dir_;
+		bool const critical_;
+
+		std::mutex mutex_;
+
+		/**
+		 * relative URL of the written file
+		 */
+		std::string href_;
+		bool done_;
+	};
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_SVG_H
+#define DOCSCRIPT_GENERATOR_SVG_H
+
+#include <cstddef>
+#include <string>
+
+#include <pugixml.hpp>
+
+namespace docscript
+{
+	/**
+	 * Reduce the size of an SVG document before embedding it into HTML:
+	 *
+	 * - remove editor data (inkscape, sodipodi, metadata)
+	 * - collapse whitespace in text and in geometry attributes
+	 * - round all numbers of geometry attributes to the specified
+	 *   number of decimal places (transformations get two more)
+	 * - the viewBox is left unchanged
+	 *
+	 * Save the document with pugi::format_raw to omit indentation.
+	 */
+	void minify_svg(pugi::xml_node, std::size_t precision);
+
+	/**
+	 * @return number of decimal places that keep the specified number of
+	 * significant digits relative to the size of the drawing. The size is
+	 * the larger extent of the viewBox, otherwise of width and height.
+	 * Without both a size of 100 is assumed.
+	 * Example: 5 digits => 2 decimal places for a viewBox of 0 0 210 297
+	 */
+	std::size_t get_svg_precision(pugi::xml_node, std::size_t digits);
+
+	/**
+	 * Round all numbers in the specified string to the given
+	 * number of decimal places. Trailing zeros are removed.
+	 * Example: "M 10.000001,20.123456" => "M 10,20.123"
+	 */
+	std::string shorten_numbers(std::string const&, std::size_t precision);
+
+	/**
+	 * Replace all sequences of whitespace by a single space
+	 * and optionally trim the result.
+	 */
+	std::string collapse_whitespace(std::string const&, bool trim = true);
+
+	/**
+	 * @return SVG length in pixel or 0 if the value has a
+	 * different unit or is a percentage
+	 */
+	double get_svg_length(char const*);
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_TABLE_H
+#define DOCSCRIPT_GENERATOR_TABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * cells of a CSV row
+	 */
+	using csv_row_t = std::vector<std::string>;
+
+	/**
+	 * Parse CSV data (RFC 4180) row by row. Fields are separated by
+	 * a comma and may be enclosed in double quotes. Quoted fields can
+	 * contain commas, line breaks and escaped quotes ("").
+	 * A leading UTF-8 BOM is skipped.
+	 *
+	 * The row is reused for all calls of the callback.
+	 * Parsing stops if the callback returns false.
+	 *
+	 * @return number of parsed rows
+	 */
+	std::size_t read_csv(char const* begin, char const* end, std::function<bool(csv_row_t const&)>);
+
+	/**
+	 * Limits of a table from a CSV file
+	 */
+	struct table_limits
+	{
+		std::size_t max_rows_;	//!<	maximal number of body rows, 0 is unlimited
+		std::size_t page_size_;	//!<	body rows per page, 0 is a single page
+	};
+
+	/**
+	 * Output format of a CSV table. The first CSV row is the header,
+	 * all other rows are body rows. Cells are not escaped.
+	 */
+	class table_writer
+	{
+	public:
+		virtual ~table_writer() = default;
+
+		/**
+		 * Start a new page. Pages are numbered from 0.
+		 */
+		virtual void begin_page(std::size_t page, csv_row_t const& header) = 0;
+		virtual void row(csv_row_t const&) = 0;
+		virtual void end_page(std::size_t page) = 0;
+
+		/**
+		 * Called after the last page if the row limit was reached.
+		 */
+		virtual void truncated(std::size_t rows) = 0;
+	};
+
+	/**
+	 * Stream the specified CSV file into the table writer.
+	 * The file is memory mapped and no row is stored.
+	 *
+	 * @return false if the file cannot be read
+	 */
+	bool render_csv(cyng::filesystem::path const&, table_limits const&, table_writer&);
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_GENERATOR_WORKERS_H
+#define DOCSCRIPT_GENERATOR_WORKERS_H
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <string>
+
+#include <boost/asio/thread_pool.hpp>
+
+namespace docscript
+{
+	/**
+	 * Threads to render expensive build-in functions (code, figure,
+	 * gallery, table) in parallel to the VM. Shared by all generators
+	 * of a batch or site build.
+	 *
+	 * A job must not access the VM or the generator. Everything it
+	 * needs has to be captured by value.
+	 */
+	class worker_pool
+	{
+	public:
+		/**
+		 * @param threads number of threads. With 0 the number of
+		 * hardware threads is used.
+		 */
+		explicit worker_pool(std::size_t threads);
+		worker_pool(worker_pool const&) = delete;
+		worker_pool& operator=(worker_pool const&) = delete;
+
+		/**
+		 * wait for all pending jobs
+		 */
+		virtual ~worker_pool();
+
+		/**
+		 * Schedule a job. Exceptions are transported to the caller
+		 * of get().
+		 */
+		std::shared_future<std::string> submit(std::function<std::string()>);
+
+		/**
+		 * @return number of threads
+		 */
+		std::size_t size() const;
+
+	private:
+		std::size_t const threads_;
+		boost::asio::thread_pool pool_;
+	};
+
+	/**
+	 * @return the specified number of threads or the number
+	 * of hardware threads if 0.
+	 */
+	std::size_t get_thread_count(std::size_t);
+}
+
+#endif
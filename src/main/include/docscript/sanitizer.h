@@ -27,6 +27,11 @@ namespace docscript
 		 */
 		void read(boost::u8_to_u32_iterator<std::string::const_iterator> first, boost::u8_to_u32_iterator<std::string::const_iterator> last);
 
+		/**
+		 * Same as above for memory mapped input
+		 */
+		void read(boost::u8_to_u32_iterator<char const*> first, boost::u8_to_u32_iterator<char const*> last);
+
 		/**
 		 * After reading the input file, the last pending
 		 * character in the input buffer have to be emitted.
@@ -34,6 +39,9 @@ namespace docscript
 		void flush(bool eof);
 
 	private:
+		template <typename I>
+		void read_range(I first, I last);
+
 		void next(std::uint32_t);
 		void emit(std::uint32_t) const;
 		void emit(std::uint32_t, std::size_t) const;
@@ -0,0 +1,111 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Sylko Olzscher 
+ * 
+ */ 
+
+#ifndef DOCSCRIPT_TRACER_H
+#define DOCSCRIPT_TRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cyng/compatibility/file_system.hpp>
+
+namespace docscript
+{
+	/**
+	 * Collect timing events of all processing phases in
+	 * Chrome trace-event format ("complete" events). 
+	 * Thread-safe, so parallel workers can share one instance.
+	 */
+	class tracer
+	{
+	public:
+		using clock_t = std::chrono::steady_clock;
+		using args_t = std::map<std::string, std::string>;
+
+		struct event
+		{
+			std::string name_;
+			std::string cat_;
+			std::uint64_t ts_;	//!<	start in microseconds
+			std::uint64_t dur_;	//!<	duration in microseconds
+			std::size_t tid_;
+			args_t args_;
+		};
+
+	public:
+		tracer();
+
+		/**
+		 * Add a complete event
+		 */
+		void add(std::string const& name
+			, std::string const& cat
+			, clock_t::time_point start
+			, clock_t::time_point stop
+			, args_t&& args);
+
+		/**
+		 * Write all events as JSON
+		 */
+		void write(std::ostream&) const;
+
+		/**
+		 * Write all events into the specified file
+		 *
+		 * @return false if file could not be opened
+		 */
+		bool write(cyng::filesystem::path const&) const;
+
+	private:
+		std::uint64_t to_timestamp(clock_t::time_point) const;
+		std::size_t get_tid();
+
+	private:
+		clock_t::time_point const epoch_;
+		mutable std::mutex mutex_;
+		std::vector<event>	events_;
+
+		/**
+		 * map thread ids to small numbers
+		 */
+		std::map<std::thread::id, std::size_t>	threads_;
+	};
+
+	/**
+	 * Measures the lifetime of a scope and adds an event
+	 * on destruction. Does nothing if no tracer is specified.
+	 */
+	class trace_scope
+	{
+	public:
+		trace_scope(tracer*, std::string const& name, std::string const& cat);
+		trace_scope(trace_scope const&) = delete;
+		trace_scope& operator=(trace_scope const&) = delete;
+		~trace_scope();
+
+		/**
+		 * Add an argument to the event
+		 */
+		void arg(std::string const& key, std::string const& value);
+
+	private:
+		tracer* const tracer_;
+		std::string const name_;
+		std::string const cat_;
+		tracer::clock_t::time_point const start_;
+		tracer::args_t args_;
+	};
+
+}
+
+#endif
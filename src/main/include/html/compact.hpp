@@ -0,0 +1,328 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef HTML_COMPACT_H
+#define HTML_COMPACT_H
+
+#include <html/names.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dom
+{
+	/**
+	 * Alternative DOM for large documents (tables, galleries).
+	 * All nodes of a document are stored in a few vectors, strings
+	 * in an arena. Tags and attribute names are compile-time ids.
+	 * Building a tree needs no allocation per node.
+	 */
+	namespace compact
+	{
+		/**
+		 * Writes the attribute value directly into the output stream
+		 */
+		using writer_t = std::function<void(std::ostream&)>;
+
+		/**
+		 * String storage of a document. Memory is allocated in blocks
+		 * and reused after clear().
+		 */
+		class arena
+		{
+		public:
+			explicit arena(std::size_t block_size = 0x4000);
+			arena(arena const&) = delete;
+			arena& operator=(arena const&) = delete;
+
+			/**
+			 * Copy a string into the arena. The view is valid until
+			 * the next call of clear().
+			 */
+			std::string_view store(std::string_view);
+
+			/**
+			 * Release all strings. All blocks are kept.
+			 */
+			void clear();
+
+			/**
+			 * @return total size of all blocks
+			 */
+			std::size_t capacity() const;
+
+		private:
+			char* allocate(std::size_t);
+
+		private:
+			std::size_t const block_size_;
+			std::vector<std::pair<std::unique_ptr<char[]>, std::size_t>> blocks_;
+
+			/**
+			 * current block and the used bytes in it
+			 */
+			std::size_t block_;
+			std::size_t used_;
+		};
+
+		/**
+		 * Result of the attribute helpers (class_(), id_(), ...)
+		 */
+		template<class T>
+		struct attribute_builder
+		{
+			attr_id const id_;
+			T value_;
+		};
+
+		/**
+		 * Result of the element helpers (div(), p(), ...). Holds the
+		 * arguments until the element is added to a document.
+		 */
+		template<class ...Args>
+		struct element_builder
+		{
+			tag_id const tag_;
+			std::tuple<Args...> args_;
+		};
+
+		template<class T>
+		struct is_attribute_builder : std::false_type {};
+		template<class T>
+		struct is_attribute_builder<attribute_builder<T>> : std::true_type {};
+
+		template<class T>
+		struct is_element_builder : std::false_type {};
+		template<class ...Args>
+		struct is_element_builder<element_builder<Args...>> : std::true_type {};
+
+		class document
+		{
+		public:
+			using index_t = std::uint32_t;
+
+		private:
+			struct node_rec
+			{
+				tag_id tag_;
+
+				/**
+				 * attributes are a range in attrs_
+				 */
+				index_t first_attr_;
+				index_t attr_count_;
+				index_t attr_capacity_;
+
+				/**
+				 * children are a range in links_
+				 */
+				index_t first_child_;
+				index_t child_count_;
+				index_t child_capacity_;
+
+				/**
+				 * points into the arena
+				 */
+				std::string_view text_;
+			};
+
+			struct attr_rec
+			{
+				attr_id id_;
+
+				/**
+				 * index in writers_ or npos
+				 */
+				index_t writer_;
+				std::string_view value_;
+			};
+
+		public:
+			static constexpr index_t npos = static_cast<index_t>(-1);
+
+			document();
+			document(document const&) = delete;
+			document& operator=(document const&) = delete;
+
+			/**
+			 * Add an element with all its children.
+			 *
+			 * @return index of the new element
+			 */
+			template<class ...Args>
+			index_t add(element_builder<Args...> const& b)
+			{
+				auto const idx = make_node(b.tag_
+					, (0u + ... + (is_attribute_builder<Args>::value ? 1u : 0u))
+					, (0u + ... + (is_element_builder<Args>::value ? 1u : 0u)));
+
+				cursor c{ idx, nodes_[idx].first_attr_, nodes_[idx].first_child_ };
+				std::apply([this, &c](auto const& ...args) {
+					(assign(c, args), ...);
+				}, b.args_);
+				return idx;
+			}
+
+			/**
+			 * Add an element as last child of the specified parent
+			 *
+			 * @return index of the new element
+			 */
+			template<class ...Args>
+			index_t append(index_t parent, element_builder<Args...> const& b)
+			{
+				auto const pos = grow_children(parent);
+				auto const idx = add(b);
+				links_[pos] = idx;
+				return idx;
+			}
+
+			/**
+			 * Add an attribute to the specified element
+			 */
+			template<class T>
+			void append(index_t parent, attribute_builder<T> const& b)
+			{
+				auto const pos = grow_attributes(parent);
+				assign_attribute(pos, b);
+			}
+
+			/**
+			 * Serialize the element with the specified index.
+			 * Same format as dom::element.
+			 */
+			void serialize(std::ostream&, index_t, std::size_t depth) const;
+			std::string	operator()(index_t, std::size_t depth) const;
+
+			/**
+			 * Remove all nodes. Memory is kept for the next document.
+			 */
+			void clear();
+
+			/**
+			 * @return number of elements
+			 */
+			std::size_t size() const;
+
+		private:
+			/**
+			 * next free slots of the element that is built
+			 */
+			struct cursor
+			{
+				index_t node_;
+				index_t attr_;
+				index_t child_;
+			};
+
+			/**
+			 * append a node and reserve the slots for attributes and children
+			 */
+			index_t make_node(tag_id, index_t attrs, index_t children);
+
+			/**
+			 * @return position of a new slot in links_
+			 */
+			index_t grow_children(index_t parent);
+
+			/**
+			 * @return position of a new slot in attrs_
+			 */
+			index_t grow_attributes(index_t parent);
+
+			void set_text(index_t, std::string_view);
+			void set_attribute(index_t pos, attr_id, std::string_view);
+			void set_attribute(index_t pos, attr_id, writer_t const&);
+
+			template<class ...Args>
+			void assign(cursor& c, element_builder<Args...> const& b)
+			{
+				auto const pos = c.child_++;
+				auto const idx = add(b);
+				links_[pos] = idx;
+			}
+
+			template<class T>
+			void assign(cursor& c, attribute_builder<T> const& b)
+			{
+				assign_attribute(c.attr_++, b);
+			}
+
+			/**
+			 * Everything else is text. Like dom::element the last text wins.
+			 */
+			template<class T>
+			void assign(cursor& c, T const& val)
+			{
+				if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+					set_text(c.node_, val);
+				}
+				else {
+					set_text(c.node_, format(val));
+				}
+			}
+
+			template<class T>
+			void assign_attribute(index_t pos, attribute_builder<T> const& b)
+			{
+				if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+					set_attribute(pos, b.id_, std::string_view(b.value_));
+				}
+				else if constexpr (std::is_convertible_v<T const&, writer_t>) {
+					set_attribute(pos, b.id_, writer_t(b.value_));
+				}
+				else {
+					set_attribute(pos, b.id_, format(b.value_));
+				}
+			}
+
+			template<class T>
+			static std::string format(T const& val)
+			{
+				std::ostringstream ss;
+				ss << val;
+				return ss.str();
+			}
+
+		private:
+			std::vector<node_rec> nodes_;
+			std::vector<attr_rec> attrs_;
+			std::vector<index_t> links_;
+			std::vector<writer_t> writers_;
+			arena arena_;
+		};
+
+#define DEFINE_COMPACT_ELEMENT(X) template<class ...Args> \
+	element_builder<std::decay_t<Args>...> X(Args &&...args)	\
+	{return element_builder<std::decay_t<Args>...>{tag_id::X, std::tuple<std::decay_t<Args>...>(std::forward<Args>(args)...)};}
+
+#define DEFINE_COMPACT_ATTRIBUTE(X, S) \
+	template<class T> \
+	attribute_builder<std::decay_t<T>> X##_(T &&val){return attribute_builder<std::decay_t<T>>{attr_id::X##_, std::forward<T>(val)};}
+
+		inline namespace elem
+		{
+			HTML_ELEMENTS(DEFINE_COMPACT_ELEMENT)
+		}
+
+		inline namespace attr
+		{
+			HTML_ATTRIBUTES(DEFINE_COMPACT_ATTRIBUTE)
+		}
+	}
+}
+
+#endif
@@ -8,11 +8,13 @@
 #ifndef HTML_DOM_H
 #define HTML_DOM_H
 
+#include <html/names.hpp>
+
 #include <list>
 #include <iostream>
 #include <sstream>
-
-#include <boost/flyweight.hpp>
+#include <functional>
+#include <string_view>
 
 namespace dom
 {
@@ -30,6 +32,19 @@ namespace dom
 	 */
 	std::string patch_attribute_name(std::string value);
 
+	/**
+	 * @return the name from the static table or an interned copy
+	 * for unknown names. Each thread has its own pool of interned
+	 * names, so no lock is required.
+	 */
+	std::string_view intern_tag(std::string const&);
+	std::string_view intern_attribute(std::string const&);
+
+	/**
+	 * Pass as depth to serialize without line breaks and indentation.
+	 */
+	constexpr std::size_t minified = static_cast<std::size_t>(-1);
+
 	/**
 	 * base class
 	 */
@@ -43,6 +58,12 @@ namespace dom
 
 		std::string	operator()(std::size_t intend) const;
 
+		/**
+		 * Serialize directly into the stream. Same output as
+		 * operator() without an intermediate string.
+		 */
+		std::ostream& write(std::ostream&, std::size_t intend) const;
+
 	protected:
 		virtual void serialize(std::ostream&, std::size_t depth) const = 0;
 	};
@@ -91,15 +112,42 @@ namespace dom
 	 */
 	class attribute : public node
 	{
-		struct dom_attribute {};
+	public:
+		/**
+		 * Writes the attribute value directly into the output stream.
+		 * Used for large values like inline images.
+		 */
+		using writer_t = std::function<void(std::ostream&)>;
+
 	public:
 		attribute();
 		attribute(std::string);
+		attribute(std::string name, std::string value);
+		attribute(std::string name, writer_t);
+		attribute(attr_id, std::string value);
+		attribute(attr_id, writer_t);
 
 		template<typename ...Args>
 		attribute(std::string name, Args... args)
-			: name_(patch_attribute_name(name))
+			: name_(intern_attribute(patch_attribute_name(name)))
+			, value_()
+			, writer_()
+		{
+			std::size_t n{ 0 };
+			std::stringstream ss;
+
+			((ss
+				<< args
+				<< (++n != sizeof...(Args) ? " " : "")), ...);
+
+			value_ = ss.str();
+		}
+
+		template<typename ...Args>
+		attribute(attr_id id, Args... args)
+			: name_(name(id))
 			, value_()
+			, writer_()
 		{
 			std::size_t n{ 0 };
 			std::stringstream ss;
@@ -119,8 +167,12 @@ namespace dom
 		virtual void serialize(std::ostream&, std::size_t depth) const override;
 
 	private:
-		boost::flyweight<std::string, boost::flyweights::tag<dom_attribute>> const name_;
+		/**
+		 * static or interned name
+		 */
+		std::string_view const name_;
 		std::string value_;
+		writer_t writer_;
 	};
 
 
@@ -129,15 +181,29 @@ namespace dom
 	 */
 	class element : public node
 	{
-		struct dom_element {};
 	public:
 		element();
 		element(std::string tag);
 		element(std::string tag, text);
+		element(tag_id);
+		element(tag_id, text);
 
 		template<typename ...Args>
 		element(std::string tag, Args... args)
-			: tag_(std::move(tag))
+			: id_(lookup_tag(tag))
+			, tag_(intern_tag(tag))
+			, attr_()
+			, children_()
+			, text_()
+		{
+			assign(std::forward<Args>(args)...);
+		}
+
+		template<typename ...Args>
+		element(tag_id id, Args... args)
+			: id_(id)
+			, tag_(name(id))
+			, attr_()
 			, children_()
 			, text_()
 		{
@@ -186,7 +252,12 @@ namespace dom
 
 
 	private:
-		boost::flyweight<std::string, boost::flyweights::tag<dom_element>> const tag_;
+		tag_id const id_;
+
+		/**
+		 * static or interned name
+		 */
+		std::string_view const tag_;
 		std::list<attribute> attr_;
 		std::list<element>	children_;
 		text text_;
@@ -196,11 +267,11 @@ namespace dom
 
 #define DEFINE_ELEMENT(X) template<class ...Args> \
 	element X(Args &&...args)	\
-	{return element(#X, std::forward<Args>(args)...);}
+	{return element(tag_id::X, std::forward<Args>(args)...);}
 
 #define DEFINE_ATTRIBUTE(X) \
 	template<class T> \
-	attribute X##_(T &&val){return attribute(#X, std::forward<T>(val));}
+	attribute X##_(T &&val){return attribute(attr_id::X##_, std::forward<T>(val));}
 
 
 	inline namespace elem
@@ -381,6 +452,7 @@ namespace dom
 		DEFINE_ATTRIBUTE(data_toggle)	//	bootstrap 4
 		DEFINE_ATTRIBUTE(datetime)
 		DEFINE_ATTRIBUTE(declare)
+		DEFINE_ATTRIBUTE(decoding)
 		DEFINE_ATTRIBUTE(default)
 		DEFINE_ATTRIBUTE(defer)
 		DEFINE_ATTRIBUTE(dir)
@@ -0,0 +1,445 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef HTML_NAMES_H
+#define HTML_NAMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * All known element names. The list must be sorted.
+ */
+#define HTML_ELEMENTS(X) \
+	X(a) \
+	X(abbr) \
+	X(acronym) \
+	X(address) \
+	X(applet) \
+	X(area) \
+	X(article) \
+	X(aside) \
+	X(audio) \
+	X(autocomplete) \
+	X(autofocus) \
+	X(b) \
+	X(base) \
+	X(basefont) \
+	X(bdi) \
+	X(bdo) \
+	X(big) \
+	X(blockquote) \
+	X(body) \
+	X(br) \
+	X(button) \
+	X(canvas) \
+	X(caption) \
+	X(center) \
+	X(cite) \
+	X(code) \
+	X(col) \
+	X(colgroup) \
+	X(command) \
+	X(datalist) \
+	X(dd) \
+	X(del) \
+	X(details) \
+	X(dfn) \
+	X(dialog) \
+	X(dir) \
+	X(div) \
+	X(dl) \
+	X(dt) \
+	X(em) \
+	X(embed) \
+	X(fieldset) \
+	X(figcaption) \
+	X(figure) \
+	X(font) \
+	X(footer) \
+	X(form) \
+	X(frame) \
+	X(frameset) \
+	X(h1) \
+	X(h2) \
+	X(h3) \
+	X(h4) \
+	X(h5) \
+	X(h6) \
+	X(head) \
+	X(header) \
+	X(hr) \
+	X(html) \
+	X(i) \
+	X(iframe) \
+	X(img) \
+	X(input) \
+	X(ins) \
+	X(isindex) \
+	X(kbd) \
+	X(keygen) \
+	X(label) \
+	X(legend) \
+	X(li) \
+	X(link) \
+	X(map) \
+	X(mark) \
+	X(menu) \
+	X(menuitem) \
+	X(meta) \
+	X(meter) \
+	X(nav) \
+	X(noframes) \
+	X(noscript) \
+	X(object) \
+	X(ol) \
+	X(optgroup) \
+	X(option) \
+	X(output) \
+	X(p) \
+	X(param) \
+	X(pre) \
+	X(progress) \
+	X(q) \
+	X(rp) \
+	X(rt) \
+	X(ruby) \
+	X(s) \
+	X(samp) \
+	X(script) \
+	X(section) \
+	X(select) \
+	X(source) \
+	X(span) \
+	X(strike) \
+	X(strong) \
+	X(style) \
+	X(sub) \
+	X(summary) \
+	X(sup) \
+	X(table) \
+	X(tbody) \
+	X(td) \
+	X(textarea) \
+	X(tfoot) \
+	X(th) \
+	X(thead) \
+	X(time) \
+	X(title) \
+	X(tr) \
+	X(track) \
+	X(tt) \
+	X(u) \
+	X(ul) \
+	X(var) \
+	X(video) \
+	X(wbr) \
+	X(xmp)
+
+/**
+ * All known attribute names as identifier and HTML name.
+ * The list must be sorted by the HTML name.
+ */
+#define HTML_ATTRIBUTES(X) \
+	X(abbr, "abbr") \
+	X(accept, "accept") \
+	X(accept_charset, "accept-charset") \
+	X(accesskey, "accesskey") \
+	X(action, "action") \
+	X(align, "align") \
+	X(alink, "alink") \
+	X(alt, "alt") \
+	X(archive, "archive") \
+	X(aria_hidden, "aria-hidden") \
+	X(aria_labelledby, "aria-labelledby") \
+	X(async, "async") \
+	X(autocomplete, "autocomplete") \
+	X(autofocus, "autofocus") \
+	X(autoplay, "autoplay") \
+	X(axis, "axis") \
+	X(background, "background") \
+	X(bgcolor, "bgcolor") \
+	X(border, "border") \
+	X(cellpadding, "cellpadding") \
+	X(cellspacing, "cellspacing") \
+	X(challenge, "challenge") \
+	X(char, "char") \
+	X(charoff, "charoff") \
+	X(charset, "charset") \
+	X(checked, "checked") \
+	X(cite, "cite") \
+	X(class, "class") \
+	X(classid, "classid") \
+	X(code, "code") \
+	X(codebase, "codebase") \
+	X(codetype, "codetype") \
+	X(color, "color") \
+	X(cols, "cols") \
+	X(colspan, "colspan") \
+	X(compact, "compact") \
+	X(content, "content") \
+	X(contenteditable, "contenteditable") \
+	X(contextmenu, "contextmenu") \
+	X(controls, "controls") \
+	X(coords, "coords") \
+	X(data, "data") \
+	X(data_target, "data-target") \
+	X(data_toggle, "data-toggle") \
+	X(datetime, "datetime") \
+	X(declare, "declare") \
+	X(decoding, "decoding") \
+	X(default, "default") \
+	X(defer, "defer") \
+	X(dir, "dir") \
+	X(disabled, "disabled") \
+	X(download, "download") \
+	X(draggable, "draggable") \
+	X(dropzone, "dropzone") \
+	X(enctype, "enctype") \
+	X(face, "face") \
+	X(for, "for") \
+	X(form, "form") \
+	X(formaction, "formaction") \
+	X(formenctype, "formenctype") \
+	X(formmethod, "formmethod") \
+	X(formnovalidate, "formnovalidate") \
+	X(formtarget, "formtarget") \
+	X(frame, "frame") \
+	X(frameborder, "frameborder") \
+	X(headers, "headers") \
+	X(height, "height") \
+	X(hidden, "hidden") \
+	X(high, "high") \
+	X(href, "href") \
+	X(hreflang, "hreflang") \
+	X(hspace, "hspace") \
+	X(http_equiv, "http-equiv") \
+	X(icon, "icon") \
+	X(id, "id") \
+	X(ismap, "ismap") \
+	X(keytype, "keytype") \
+	X(kind, "kind") \
+	X(label, "label") \
+	X(lang, "lang") \
+	X(language, "language") \
+	X(link, "link") \
+	X(list, "list") \
+	X(loading, "loading") \
+	X(longdesc, "longdesc") \
+	X(loop, "loop") \
+	X(low, "low") \
+	X(manifest, "manifest") \
+	X(max, "max") \
+	X(maxlength, "maxlength") \
+	X(media, "media") \
+	X(method, "method") \
+	X(min, "min") \
+	X(multiple, "multiple") \
+	X(muted, "muted") \
+	X(name, "name") \
+	X(nohref, "nohref") \
+	X(noresize, "noresize") \
+	X(noshade, "noshade") \
+	X(novalidate, "novalidate") \
+	X(nowrap, "nowrap") \
+	X(object, "object") \
+	X(onabort, "onabort") \
+	X(onafterprint, "onafterprint") \
+	X(onbeforeprint, "onbeforeprint") \
+	X(onbeforeunload, "onbeforeunload") \
+	X(onblur, "onblur") \
+	X(oncanplay, "oncanplay") \
+	X(oncanplaythrough, "oncanplaythrough") \
+	X(onchange, "onchange") \
+	X(onclick, "onclick") \
+	X(oncontextmenu, "oncontextmenu") \
+	X(ondblclick, "ondblclick") \
+	X(ondrag, "ondrag") \
+	X(ondragend, "ondragend") \
+	X(ondragenter, "ondragenter") \
+	X(ondragleave, "ondragleave") \
+	X(ondragover, "ondragover") \
+	X(ondragstart, "ondragstart") \
+	X(ondrop, "ondrop") \
+	X(ondurationchange, "ondurationchange") \
+	X(onemptied, "onemptied") \
+	X(onended, "onended") \
+	X(onerror, "onerror") \
+	X(onfocus, "onfocus") \
+	X(onformchange, "onformchange") \
+	X(onforminput, "onforminput") \
+	X(onhaschange, "onhaschange") \
+	X(oninput, "oninput") \
+	X(oninvalid, "oninvalid") \
+	X(onkeydown, "onkeydown") \
+	X(onkeypress, "onkeypress") \
+	X(onkeyup, "onkeyup") \
+	X(onload, "onload") \
+	X(onloadeddata, "onloadeddata") \
+	X(onloadedmetadata, "onloadedmetadata") \
+	X(onloadstart, "onloadstart") \
+	X(onmessage, "onmessage") \
+	X(onmousedown, "onmousedown") \
+	X(onmousemove, "onmousemove") \
+	X(onmouseout, "onmouseout") \
+	X(onmouseover, "onmouseover") \
+	X(onmouseup, "onmouseup") \
+	X(onmousewheel, "onmousewheel") \
+	X(onoffline, "onoffline") \
+	X(ononline, "ononline") \
+	X(onpagehide, "onpagehide") \
+	X(onpageshow, "onpageshow") \
+	X(onpause, "onpause") \
+	X(onplay, "onplay") \
+	X(onplaying, "onplaying") \
+	X(onpopstate, "onpopstate") \
+	X(onprogress, "onprogress") \
+	X(onratechange, "onratechange") \
+	X(onreadystatechange, "onreadystatechange") \
+	X(onredo, "onredo") \
+	X(onreset, "onreset") \
+	X(onresize, "onresize") \
+	X(onscroll, "onscroll") \
+	X(onseeked, "onseeked") \
+	X(onseeking, "onseeking") \
+	X(onselect, "onselect") \
+	X(onstalled, "onstalled") \
+	X(onstorage, "onstorage") \
+	X(onsubmit, "onsubmit") \
+	X(onsuspend, "onsuspend") \
+	X(ontimeupdate, "ontimeupdate") \
+	X(onundo, "onundo") \
+	X(onunload, "onunload") \
+	X(onvolumechange, "onvolumechange") \
+	X(onwaiting, "onwaiting") \
+	X(open, "open") \
+	X(optimum, "optimum") \
+	X(pattern, "pattern") \
+	X(placeholder, "placeholder") \
+	X(poster, "poster") \
+	X(preload, "preload") \
+	X(profile, "profile") \
+	X(pubdate, "pubdate") \
+	X(radiogroup, "radiogroup") \
+	X(readonly, "readonly") \
+	X(rel, "rel") \
+	X(required, "required") \
+	X(rev, "rev") \
+	X(reversed, "reversed") \
+	X(role, "role") \
+	X(rows, "rows") \
+	X(rowspan, "rowspan") \
+	X(rules, "rules") \
+	X(sandbox, "sandbox") \
+	X(scheme, "scheme") \
+	X(scope, "scope") \
+	X(scrolling, "scrolling") \
+	X(seamless, "seamless") \
+	X(selected, "selected") \
+	X(shape, "shape") \
+	X(size, "size") \
+	X(span, "span") \
+	X(spellcheck, "spellcheck") \
+	X(src, "src") \
+	X(srcdoc, "srcdoc") \
+	X(srclang, "srclang") \
+	X(standby, "standby") \
+	X(start, "start") \
+	X(step, "step") \
+	X(style, "style") \
+	X(summary, "summary") \
+	X(tabindex, "tabindex") \
+	X(target, "target") \
+	X(text, "text") \
+	X(title, "title") \
+	X(translate, "translate") \
+	X(type, "type") \
+	X(usemap, "usemap") \
+	X(valign, "valign") \
+	X(value, "value") \
+	X(valuetype, "valuetype") \
+	X(vlink, "vlink") \
+	X(vspace, "vspace") \
+	X(width, "width") \
+	X(wrap, "wrap") \
+	X(xmlns, "xmlns")
+
+namespace dom
+{
+	/**
+	 * Compile-time id of an element name
+	 */
+	enum class tag_id : std::uint16_t {
+#define X(name) name,
+		HTML_ELEMENTS(X)
+#undef X
+		unknown
+	};
+
+	/**
+	 * Compile-time id of an attribute name. All ids have a trailing
+	 * underscore like the attribute helpers (class_, for_).
+	 */
+	enum class attr_id : std::uint16_t {
+#define X(name, str) name##_,
+		HTML_ATTRIBUTES(X)
+#undef X
+		unknown
+	};
+
+	constexpr std::string_view tag_names[] = {
+#define X(name) #name,
+		HTML_ELEMENTS(X)
+#undef X
+	};
+
+	constexpr std::string_view attr_names[] = {
+#define X(name, str) str,
+		HTML_ATTRIBUTES(X)
+#undef X
+	};
+
+	/**
+	 * @return element name or an empty string for unknown ids
+	 */
+	constexpr std::string_view name(tag_id id)
+	{
+		return (id < tag_id::unknown)
+			? tag_names[static_cast<std::size_t>(id)]
+			: std::string_view()
+			;
+	}
+
+	/**
+	 * @return attribute name or an empty string for unknown ids
+	 */
+	constexpr std::string_view name(attr_id id)
+	{
+		return (id < attr_id::unknown)
+			? attr_names[static_cast<std::size_t>(id)]
+			: std::string_view()
+			;
+	}
+
+	/**
+	 * Binary search in the name table
+	 *
+	 * @return tag_id::unknown if the name is not in the list
+	 */
+	tag_id lookup_tag(std::string_view);
+
+	/**
+	 * Binary search in the name table. Expects the HTML name
+	 * ("data-target" not "data_target").
+	 *
+	 * @return attr_id::unknown if the name is not in the list
+	 */
+	attr_id lookup_attribute(std::string_view);
+}
+
+#endif
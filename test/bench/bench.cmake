@@ -0,0 +1,24 @@
+# 
+#	reset 
+#
+set (bench)
+
+set (bench_cpp
+	test/bench/src/main.cpp
+	test/bench/src/bench.cpp
+	test/bench/src/bench_generator.cpp
+	test/bench/src/bench_base64.cpp
+	test/bench/src/bench_dom.cpp
+	test/bench/src/bench_escape.cpp
+)
+    
+set (bench_h
+	 "${PROJECT_BINARY_DIR}/DOCC_project_info.h"
+	test/bench/src/bench.h
+)
+
+# define the benchmark program
+set (bench
+  ${bench_cpp}
+  ${bench_h}
+)
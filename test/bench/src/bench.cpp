@@ -0,0 +1,50 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * Only visible in this compilation unit
+		 */
+		std::size_t volatile sink_value = 0;
+
+		void report(std::string const& name, double us, std::size_t bytes)
+		{
+			std::cout
+				<< std::left
+				<< std::setw(40)
+				<< name
+				<< std::right
+				<< std::fixed
+				<< std::setprecision(2)
+				<< std::setw(14)
+				<< us
+				<< " us"
+				;
+			if (bytes != 0 && us > 0.0) {
+				std::cout
+					<< std::setw(12)
+					<< (static_cast<double>(bytes) / us)
+					<< " MB/s"
+					;
+			}
+			std::cout << std::endl;
+		}
+
+		void consume(std::size_t n)
+		{
+			sink_value = sink_value + n;
+		}
+	}
+}
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#ifndef DOCSCRIPT_BENCH_H
+#define DOCSCRIPT_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * @return average wall clock time of one call in microseconds
+		 */
+		template <typename F>
+		double measure(std::size_t rounds, F&& f)
+		{
+			auto const start = std::chrono::steady_clock::now();
+			for (std::size_t idx = 0; idx < rounds; ++idx) {
+				f();
+			}
+			std::chrono::duration<double, std::micro> const delta = std::chrono::steady_clock::now() - start;
+			return delta.count() / static_cast<double>(rounds);
+		}
+
+		/**
+		 * Print one result line. With a size the throughput is printed too.
+		 *
+		 * @param us average time of one round in microseconds
+		 * @param bytes processed bytes per round
+		 */
+		void report(std::string const& name, double us, std::size_t bytes = 0);
+
+		/**
+		 * Prevent the compiler from removing a computation
+		 */
+		void consume(std::size_t);
+
+		/**
+		 * VM based generators in synchronous and asynchronous mode:
+		 * construction and execution of a program
+		 */
+		void run_generator(std::size_t rounds);
+
+		/**
+		 * base64 kernels compared with the encoder of the crypto
+		 * library: raw buffer, string and stream
+		 */
+		void run_base64(std::size_t rounds);
+
+		/**
+		 * DOM construction with static and runtime names, on one and
+		 * on all cores, compared with the compact DOM. Serialization too.
+		 */
+		void run_dom(std::size_t rounds);
+
+		/**
+		 * Escaping of prose and of source code for HTML text and
+		 * attributes, LaTeX, Markdown and AsciiDoc
+		 */
+		void run_escape(std::size_t rounds);
+	}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <docscript/generator/base64.h>
+#include <crypto/hash/base64.h>
+
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * Only visible in this compilation unit.
+		 * Counts the written characters and discards them.
+		 */
+		class null_buffer : public std::streambuf
+		{
+		public:
+			std::size_t size_ = 0;
+		protected:
+			virtual std::streamsize xsputn(char const*, std::streamsize n) override
+			{
+				size_ += static_cast<std::size_t>(n);
+				return n;
+			}
+			virtual int_type overflow(int_type c) override
+			{
+				++size_;
+				return traits_type::not_eof(c);
+			}
+		};
+
+		void run_base64(std::size_t rounds)
+		{
+			std::mt19937 gen(42);
+			std::uniform_int_distribution<int> dist(0, 255);
+
+			//
+			//	small icon and large photo
+			//
+			for (std::size_t const size : { std::size_t(4 * 1024), std::size_t(4 * 1024 * 1024) }) {
+
+				std::vector<char> data(size);
+				for (auto& c : data) {
+					c = static_cast<char>(dist(gen));
+				}
+				auto const suffix = " " + std::to_string(size / 1024) + " KB";
+
+				report("base64 crypto" + suffix, measure(rounds, [&data]() {
+					consume(cyng::crypto::base64_encode(data.data(), data.size()).size());
+				}), size);
+
+				std::string buffer(base64_encoded_size(size), '\0');
+				report(std::string("base64 ") + base64_kernel() + suffix, measure(rounds, [&data, &buffer]() {
+					consume(base64_encode(data.data(), data.size(), &buffer[0]));
+				}), size);
+
+				report("base64 string" + suffix, measure(rounds, [&data]() {
+					std::string s;
+					base64_encode(s, data.data(), data.size());
+					consume(s.size());
+				}), size);
+
+				report("base64 stream" + suffix, measure(rounds, [&data]() {
+					null_buffer nb;
+					std::ostream os(&nb);
+					base64_encode(os, data.data(), data.size());
+					consume(nb.size_);
+				}), size);
+			}
+		}
+	}
+}
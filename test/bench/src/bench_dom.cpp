@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <html/dom.hpp>
+#include <html/compact.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * Only visible in this compilation unit.
+		 * A table like the ones generated from CSV files.
+		 */
+		dom::element build_table(std::size_t rows)
+		{
+			auto table = dom::table(dom::class_("docscript-table"));
+			for (std::size_t row = 0; row < rows; ++row) {
+				auto tr = dom::tr(dom::class_("docscript-tr"));
+				for (std::size_t col = 0; col < 8; ++col) {
+					tr += dom::td(dom::class_("docscript-td"), dom::title_("cell"), row * 8 + col);
+				}
+				table += std::move(tr);
+			}
+			return table;
+		}
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Tags and attributes with runtime names go through the per thread interning.
+		 */
+		dom::element build_runtime_names(std::size_t rows)
+		{
+			auto div = dom::element("x-table");
+			for (std::size_t row = 0; row < rows; ++row) {
+				auto tr = dom::element("x-row", dom::attribute("data_row", row));
+				for (std::size_t col = 0; col < 8; ++col) {
+					tr += dom::attribute("data_col_" + std::to_string(col), col);
+				}
+				div += std::move(tr);
+			}
+			return div;
+		}
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Same table in the compact representation.
+		 *
+		 * @return index of the table element
+		 */
+		dom::compact::document::index_t build_compact(dom::compact::document& doc, std::size_t rows)
+		{
+			namespace c = dom::compact;
+			doc.clear();
+			auto const table = doc.add(c::table(c::class_("docscript-table")));
+			for (std::size_t row = 0; row < rows; ++row) {
+				auto const tr = doc.append(table, c::tr(c::class_("docscript-tr")));
+				for (std::size_t col = 0; col < 8; ++col) {
+					doc.append(tr, c::td(c::class_("docscript-td"), c::title_("cell"), row * 8 + col));
+				}
+			}
+			return table;
+		}
+
+		void run_dom(std::size_t rounds)
+		{
+			std::size_t const rows = 1000;
+
+			report("dom table 1000 rows", measure(rounds, [rows]() {
+				consume(static_cast<std::size_t>(build_table(rows).get_node_type()));
+			}));
+
+			report("dom runtime names 1000 rows", measure(rounds, [rows]() {
+				consume(static_cast<std::size_t>(build_runtime_names(rows).get_node_type()));
+			}));
+
+			dom::compact::document doc;
+			report("dom compact 1000 rows", measure(rounds, [&doc, rows]() {
+				build_compact(doc, rows);
+				consume(doc.size());
+			}));
+
+			//
+			//	every core builds the same table. Without contention in
+			//	the name lookup this takes as long as one table.
+			//
+			auto const threads = std::max(2u, std::thread::hardware_concurrency());
+			report("dom table " + std::to_string(threads) + " threads", measure(rounds, [rows, threads]() {
+				std::vector<std::size_t> results(threads, 0);
+				std::vector<std::thread> pool;
+				for (unsigned idx = 0; idx < threads; ++idx) {
+					pool.emplace_back([rows, &results, idx]() {
+						results.at(idx) = static_cast<std::size_t>(build_table(rows).get_node_type());
+					});
+				}
+				for (auto& t : pool) {
+					t.join();
+				}
+				for (auto const r : results) {
+					consume(r);
+				}
+			}));
+
+			auto const table = build_table(rows);
+			report("dom serialize 1000 rows", measure(rounds, [&table]() {
+				consume(table(dom::minified).size());
+			}));
+
+			auto const root = build_compact(doc, rows);
+			report("dom compact serialize 1000 rows", measure(rounds, [&doc, root]() {
+				consume(doc(root, dom::minified).size());
+			}));
+		}
+	}
+}
@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <docscript/generator/escape.h>
+#include <docscript/generator/gen_html.h>
+#include <docscript/generator/gen_LaTeX.h>
+#include <docscript/generator/gen_md.h>
+#include <docscript/generator/gen_asciidoc.h>
+
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * Only visible in this compilation unit.
+		 * Counts the written characters and discards them.
+		 */
+		class null_sink : public std::streambuf
+		{
+		public:
+			std::size_t size_ = 0;
+		protected:
+			virtual std::streamsize xsputn(char const*, std::streamsize n) override
+			{
+				size_ += static_cast<std::size_t>(n);
+				return n;
+			}
+			virtual int_type overflow(int_type c) override
+			{
+				++size_;
+				return traits_type::not_eof(c);
+			}
+		};
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Random text with one special character in about every
+		 * "period" bytes.
+		 */
+		std::string make_text(std::size_t size, int period)
+		{
+			std::mt19937 gen(42);
+			std::uniform_int_distribution<int> letter(0, 25);
+			std::uniform_int_distribution<int> pick(0, period - 1);
+			std::string const specials("<>&\"'#$%_{}[]*\\`|-=!:~^");
+			std::uniform_int_distribution<std::size_t> special(0, specials.size() - 1);
+
+			std::string text;
+			text.reserve(size);
+			while (text.size() < size) {
+				if (pick(gen) == 0) {
+					text += specials.at(special(gen));
+				}
+				else if (pick(gen) < period / 6) {
+					text += ' ';
+				}
+				else {
+					text += static_cast<char>('a' + letter(gen));
+				}
+			}
+			return text;
+		}
+
+		/**
+		 * Only visible in this compilation unit.
+		 * Byte by byte HTML escaping as the filters did it before.
+		 */
+		std::string escape_bytewise(std::string const& str)
+		{
+			std::string result;
+			result.reserve(str.size());
+			for (auto const c : str) {
+				switch (c) {
+				case '<':	result.append("&lt;");	break;
+				case '>':	result.append("&gt;");	break;
+				case '&':	result.append("&amp;");	break;
+				case '"':	result.append("&quot;");	break;
+				default:
+					result += c;
+					break;
+				}
+			}
+			return result;
+		}
+
+		void run_escape(std::size_t rounds)
+		{
+			std::size_t const size = 1024 * 1024;
+
+			//
+			//	prose and source code
+			//
+			for (auto const period : { 200, 8 }) {
+
+				auto const text = make_text(size, period);
+				auto const suffix = " 1/" + std::to_string(period);
+
+				report("escape bytewise" + suffix, measure(rounds, [&text]() {
+					consume(escape_bytewise(text).size());
+				}), size);
+
+				report("escape html text" + suffix, measure(rounds, [&text]() {
+					consume(html_text_escape()(text).size());
+				}), size);
+
+				report("escape html stream" + suffix, measure(rounds, [&text]() {
+					null_sink ns;
+					std::ostream os(&ns);
+					escape_html(os, text);
+					consume(ns.size_);
+				}), size);
+
+				report("escape html attribute" + suffix, measure(rounds, [&text]() {
+					null_sink ns;
+					std::ostream os(&ns);
+					escape_html_attribute(os, text);
+					consume(ns.size_);
+				}), size);
+
+				report("escape html entities" + suffix, measure(rounds, [&text]() {
+					consume(replace_html_entities(text).size());
+				}), size);
+
+				report("escape latex" + suffix, measure(rounds, [&text]() {
+					consume(replace_latex_entities(text).size());
+				}), size);
+
+				report("escape markdown" + suffix, measure(rounds, [&text]() {
+					consume(replace_md_entities(text).size());
+				}), size);
+
+				report("escape asciidoc" + suffix, measure(rounds, [&text]() {
+					consume(replace_asciidoc_entities(text).size());
+				}), size);
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <docscript/generator/gen_html.h>
+#include <docscript/generator/gen_md.h>
+
+#include <cyng/object.h>
+#include <cyng/vm/generator.h>
+
+#include <boost/uuid/random_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+namespace docscript
+{
+	namespace bench
+	{
+		/**
+		 * Only visible in this compilation unit.
+		 * Same structure as the code of the compiler: one call frame
+		 * for the output file and one call of "paragraph" per paragraph.
+		 */
+		cyng::vector_t make_program(cyng::filesystem::path const& out, std::size_t paragraphs)
+		{
+			std::vector<std::string> const words{ "The", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog", "." };
+
+			cyng::vector_t prg;
+			prg
+				<< cyng::code::ESBA
+				<< out
+				;
+
+			for (std::size_t idx = 0; idx < paragraphs; ++idx) {
+				cyng::vector_t par;
+				par
+					<< cyng::code::ASP
+					<< cyng::code::ESBA
+					;
+				for (auto const& w : words) {
+					par << w;
+				}
+				par
+					<< cyng::invoke("paragraph")
+					<< cyng::pr_n(1)
+					<< cyng::code::REBA
+					;
+				prg << cyng::unwinder(par);
+			}
+
+			prg
+				<< cyng::invoke("generate.file")
+				<< cyng::code::REBA
+				;
+			return prg;
+		}
+
+		/**
+		 * Only visible in this compilation unit
+		 */
+		template <typename G>
+		void run_mode(std::string const& name, bool sync, std::size_t rounds, std::size_t paragraphs, cyng::filesystem::path const& out)
+		{
+			std::vector< cyng::filesystem::path > const inc;
+
+			//
+			//	construction only
+			//
+			auto const ctor = measure(rounds, [&]() {
+				G gen(inc, sync);
+			});
+
+			//
+			//	construction and execution
+			//
+			auto const total = measure(rounds, [&]() {
+				G gen(inc, sync);
+				gen.run(make_program(out, paragraphs));
+			});
+
+			auto const mode = std::string(sync ? " sync" : " async");
+			report(name + mode + " construct", ctor);
+			report(name + mode + " construct + run (" + std::to_string(paragraphs) + ")", total);
+		}
+
+		/**
+		 * Only visible in this compilation unit
+		 */
+		struct html_factory : gen_html
+		{
+			html_factory(std::vector< cyng::filesystem::path > const& inc, bool sync)
+				: gen_html(inc, false, sync)
+			{}
+		};
+
+		void run_generator(std::size_t rounds)
+		{
+			auto const dir = cyng::filesystem::temp_directory_path();
+			auto const tag = boost::uuids::to_string(boost::uuids::random_generator()());
+			auto const out_html = dir / ("docscript-bench-" + tag + ".html");
+			auto const out_md = dir / ("docscript-bench-" + tag + ".md");
+
+			for (auto const paragraphs : { 10u, 1000u }) {
+				run_mode<html_factory>("html", true, rounds, paragraphs, out_html);
+				run_mode<html_factory>("html", false, rounds, paragraphs, out_html);
+				run_mode<gen_md>("md", true, rounds, paragraphs, out_md);
+				run_mode<gen_md>("md", false, rounds, paragraphs, out_md);
+			}
+
+			cyng::error_code ec;
+			cyng::filesystem::remove(out_html, ec);
+			cyng::filesystem::remove(out_md, ec);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Usage: bench [rounds] [name ...]
+ * Without a name all benchmarks are executed.
+ */
+int main(int argc, char* argv[])
+{
+	std::vector<std::pair<std::string, std::function<void(std::size_t)>>> const benchmarks{
+		{ "generator", &docscript::bench::run_generator },
+		{ "base64", &docscript::bench::run_base64 },
+		{ "dom", &docscript::bench::run_dom },
+		{ "escape", &docscript::bench::run_escape },
+	};
+
+	std::size_t rounds = 10;
+	int pos = 1;
+	if (argc > 1 && std::atoi(argv[1]) > 0) {
+		rounds = static_cast<std::size_t>(std::atoi(argv[1]));
+		pos = 2;
+	}
+
+	int result = EXIT_SUCCESS;
+	for (auto const& b : benchmarks) {
+		bool selected = (pos == argc);
+		for (int idx = pos; idx < argc; ++idx) {
+			selected = selected || (b.first == argv[idx]);
+		}
+		if (selected) {
+			std::cout
+				<< "*** "
+				<< b.first
+				<< std::endl
+				;
+			b.second(rounds);
+		}
+	}
+	for (int idx = pos; idx < argc; ++idx) {
+		bool found = false;
+		for (auto const& b : benchmarks) {
+			found = found || (b.first == argv[idx]);
+		}
+		if (!found) {
+			std::cerr
+				<< "***error unknown benchmark ["
+				<< argv[idx]
+				<< ']'
+				<< std::endl;
+			result = EXIT_FAILURE;
+		}
+	}
+	return result;
+}
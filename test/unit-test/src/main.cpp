@@ -0,0 +1,12 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+/**
+ * The test runner. Each test_*.cpp file contains one test suite.
+ */
+#define BOOST_TEST_MODULE docscript
+#include <boost/test/included/unit_test.hpp>
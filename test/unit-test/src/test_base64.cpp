@@ -0,0 +1,125 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/base64.h>
+#include <crypto/hash/base64.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * Reproducible random data
+	 */
+	std::vector<char> make_data(std::size_t size)
+	{
+		std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+		std::uniform_int_distribution<int> dist(0, 255);
+		std::vector<char> data(size);
+		for (auto& c : data) {
+			c = static_cast<char>(dist(gen));
+		}
+		return data;
+	}
+
+	std::string encode_buffer(char const* src, std::size_t size)
+	{
+		std::string out(docscript::base64_encoded_size(size), '?');
+		auto const n = docscript::base64_encode(src, size, &out[0]);
+		BOOST_REQUIRE_EQUAL(n, out.size());
+		return out;
+	}
+
+	std::string encode_string(char const* src, std::size_t size)
+	{
+		std::string out;
+		docscript::base64_encode(out, src, size);
+		return out;
+	}
+
+	std::string encode_stream(char const* src, std::size_t size)
+	{
+		std::ostringstream ss;
+		docscript::base64_encode(ss, src, size);
+		return ss.str();
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(base64_suite)
+
+BOOST_AUTO_TEST_CASE(rfc4648)
+{
+	//
+	//	test vectors from RFC 4648, section 10
+	//
+	std::vector<std::pair<std::string, std::string>> const vectors{
+		{ "", "" },
+		{ "f", "Zg==" },
+		{ "fo", "Zm8=" },
+		{ "foo", "Zm9v" },
+		{ "foob", "Zm9vYg==" },
+		{ "fooba", "Zm9vYmE=" },
+		{ "foobar", "Zm9vYmFy" },
+	};
+	for (auto const& v : vectors) {
+		BOOST_CHECK_EQUAL(encode_buffer(v.first.data(), v.first.size()), v.second);
+		BOOST_CHECK_EQUAL(encode_string(v.first.data(), v.first.size()), v.second);
+		BOOST_CHECK_EQUAL(encode_stream(v.first.data(), v.first.size()), v.second);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(encoded_size)
+{
+	BOOST_CHECK_EQUAL(docscript::base64_encoded_size(0), 0u);
+	BOOST_CHECK_EQUAL(docscript::base64_encoded_size(1), 4u);
+	BOOST_CHECK_EQUAL(docscript::base64_encoded_size(3), 4u);
+	BOOST_CHECK_EQUAL(docscript::base64_encoded_size(4), 8u);
+	BOOST_CHECK_EQUAL(docscript::base64_encoded_size(1024), 1368u);
+}
+
+BOOST_AUTO_TEST_CASE(all_lengths)
+{
+	//
+	//	covers the tail handling of all kernels and
+	//	the chunk boundaries of the stream variant
+	//
+	for (std::size_t size = 0; size < 2000; ++size) {
+		auto const data = make_data(size);
+		auto const expected = cyng::crypto::base64_encode(data.data(), data.size());
+		BOOST_REQUIRE_EQUAL(encode_buffer(data.data(), data.size()), expected);
+		BOOST_REQUIRE_EQUAL(encode_string(data.data(), data.size()), expected);
+		BOOST_REQUIRE_EQUAL(encode_stream(data.data(), data.size()), expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(unaligned)
+{
+	auto const data = make_data(64 * 1024 + 7);
+	for (std::size_t offset = 1; offset < 8; ++offset) {
+		auto const expected = cyng::crypto::base64_encode(data.data() + offset, data.size() - offset);
+		BOOST_CHECK_EQUAL(encode_buffer(data.data() + offset, data.size() - offset), expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(append)
+{
+	//
+	//	existing content is preserved (data URI prefix)
+	//
+	std::string const prefix = "data:image/png;base64,";
+	auto const data = make_data(1000);
+	std::string out = prefix;
+	docscript::base64_encode(out, data.data(), data.size());
+	BOOST_CHECK_EQUAL(out, prefix + cyng::crypto::base64_encode(data.data(), data.size()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/cache.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * @return number of temporary files in the directory
+	 */
+	std::size_t count_temp_files(cyng::filesystem::path const& dir)
+	{
+		std::size_t count{ 0 };
+		for (auto const& e : cyng::filesystem::directory_iterator(dir)) {
+			if (e.path().extension() == ".tmp")	++count;
+		}
+		return count;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(cache_suite)
+
+BOOST_AUTO_TEST_CASE(concurrent)
+{
+	auto const dir = cyng::filesystem::temp_directory_path() / ("docscript-cache-test-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+	cyng::error_code ec;
+	cyng::filesystem::remove_all(dir, ec);
+
+	std::size_t const size = 1024 * 1024;
+	std::size_t incomplete{ 0 };
+	{
+		//
+		//	all writers store the same key, each with a different value
+		//	while a second cache reads the entry from disk
+		//
+		docscript::content_cache cache(dir, 0u);
+		std::atomic<bool> done{ false };
+		std::thread reader([&]() {
+			docscript::content_cache other(dir, 0u);
+			std::string value;
+			while (!done) {
+				if (other.get("logo.svg", value)) {
+					if (value.size() != size || value.find_first_not_of(value.front()) != std::string::npos) {
+						++incomplete;
+					}
+				}
+			}
+		});
+		std::vector<std::thread> writers;
+		for (char c = 'a'; c < 'i'; ++c) {
+			writers.emplace_back([&cache, c, size]() {
+				for (int round = 0; round < 16; ++round) {
+					cache.put("logo.svg", std::string(size, c));
+				}
+			});
+		}
+		for (auto& t : writers) {
+			t.join();
+		}
+		done = true;
+		reader.join();
+	}
+	BOOST_CHECK_EQUAL(incomplete, 0u);
+	BOOST_CHECK_EQUAL(count_temp_files(dir), 0u);
+
+	//
+	//	the entry is complete and written by one writer
+	//
+	docscript::content_cache cache(dir, 0u);
+	std::string value;
+	BOOST_REQUIRE(cache.get("logo.svg", value));
+	BOOST_REQUIRE_EQUAL(value.size(), size);
+	BOOST_CHECK_EQUAL(value.find_first_not_of(value.front()), std::string::npos);
+
+	cyng::filesystem::remove_all(dir, ec);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <html/compact.hpp>
+#include <html/dom.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * All depths used by the generators
+	 */
+	std::vector<std::size_t> const depths{ 0, 1, 3, dom::minified };
+}
+
+BOOST_AUTO_TEST_SUITE(compact_suite)
+
+BOOST_AUTO_TEST_CASE(element)
+{
+	auto const el = dom::p(dom::class_("docscript-p"), dom::id_("p-1"), "Hello & welcome");
+
+	dom::compact::document doc;
+	auto const idx = doc.add(dom::compact::p(dom::compact::class_("docscript-p"), dom::compact::id_("p-1"), "Hello & welcome"));
+
+	for (auto const d : depths) {
+		BOOST_CHECK_EQUAL(doc(idx, d), el(d));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	auto const el = dom::br();
+
+	dom::compact::document doc;
+	auto const idx = doc.add(dom::compact::br());
+
+	for (auto const d : depths) {
+		BOOST_CHECK_EQUAL(doc(idx, d), el(d));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested)
+{
+	//
+	//	gallery with two figures
+	//
+	auto const el = dom::div(dom::id_("gallery")
+		, dom::h4("Gallery")
+		, dom::div(dom::class_("gallery"), dom::style_("grid-template-columns: repeat(2, 1fr)")
+			, dom::figure(dom::id_("f-1"), dom::img(dom::alt_("one"), dom::src_("1.png")), dom::figcaption("figure: 1"))
+			, dom::figure(dom::id_("f-2"), dom::img(dom::alt_("two"), dom::src_("2.png")), dom::figcaption("figure: 2"))));
+
+	namespace c = dom::compact;
+	c::document doc;
+	auto const idx = doc.add(c::div(c::id_("gallery")
+		, c::h4("Gallery")
+		, c::div(c::class_("gallery"), c::style_("grid-template-columns: repeat(2, 1fr)")
+			, c::figure(c::id_("f-1"), c::img(c::alt_("one"), c::src_("1.png")), c::figcaption("figure: 1"))
+			, c::figure(c::id_("f-2"), c::img(c::alt_("two"), c::src_("2.png")), c::figcaption("figure: 2")))));
+
+	BOOST_CHECK_EQUAL(doc.size(), 9u);
+	for (auto const d : depths) {
+		BOOST_CHECK_EQUAL(doc(idx, d), el(d));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(append)
+{
+	//
+	//	table built row by row
+	//
+	auto el = dom::table(dom::class_("docscript-table"));
+	namespace c = dom::compact;
+	c::document doc;
+	auto const idx = doc.add(c::table(c::class_("docscript-table")));
+
+	for (std::size_t row = 0; row < 20; ++row) {
+		auto tr = dom::tr(dom::class_("docscript-tr"));
+		auto const tr_idx = doc.append(idx, c::tr(c::class_("docscript-tr")));
+		for (std::size_t col = 0; col < 5; ++col) {
+			tr += dom::td(row * 5 + col);
+			doc.append(tr_idx, c::td(row * 5 + col));
+		}
+		el += std::move(tr);
+	}
+	el += dom::title_("page 0");
+	doc.append(idx, c::title_("page 0"));
+
+	for (auto const d : depths) {
+		BOOST_CHECK_EQUAL(doc(idx, d), el(d));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(writer)
+{
+	auto const w = [](std::ostream& os) { os << "data:image/png;base64,AAAA"; };
+	auto const el = dom::img(dom::attribute("src", dom::attribute::writer_t(w)));
+
+	dom::compact::document doc;
+	auto const idx = doc.add(dom::compact::img(dom::compact::src_(dom::compact::writer_t(w))));
+
+	for (auto const d : depths) {
+		BOOST_CHECK_EQUAL(doc(idx, d), el(d));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+	dom::compact::document doc;
+	doc.add(dom::compact::div(dom::compact::p("first")));
+	BOOST_CHECK_EQUAL(doc.size(), 2u);
+
+	doc.clear();
+	BOOST_CHECK_EQUAL(doc.size(), 0u);
+
+	auto const idx = doc.add(dom::compact::span("second"));
+	BOOST_CHECK_EQUAL(doc(idx, 0), dom::span("second")(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/escape.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * byte by byte reference
+	 */
+	char const* find_scalar(std::string const& chars, char const* pos, char const* end)
+	{
+		return std::find_first_of(pos, end, chars.begin(), chars.end());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(escape_suite)
+
+BOOST_AUTO_TEST_CASE(distinct)
+{
+	//
+	//	Markdown singles followed by the first characters of the pair rules
+	//
+	std::string const md("\\`*_{}[]#|" "<<<=--!!:::");
+	docscript::char_set const set(md);
+#if defined(__SSE2__) || defined(_M_X64)
+	BOOST_CHECK(set.is_simd());
+#endif
+
+	docscript::char_set const large("abcdefghijklmnopq");
+	BOOST_CHECK(!large.is_simd());
+	BOOST_CHECK(large.contains('q'));
+}
+
+BOOST_AUTO_TEST_CASE(find)
+{
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> dist(32, 126);
+
+	for (std::string const chars : { "<>&\"", "\\`*_{}[]#|<=-!:", "abcdefghijklmnopq" }) {
+		docscript::char_set const set(chars);
+		for (std::size_t size = 0; size < 200; ++size) {
+			std::string s(size, ' ');
+			for (auto& c : s) {
+				c = static_cast<char>(dist(gen));
+			}
+			auto const* end = s.data() + s.size();
+			for (auto const* pos = s.data(); pos != end; ++pos) {
+				BOOST_REQUIRE(set.find(pos, end) == find_scalar(chars, pos, end));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(html)
+{
+	BOOST_CHECK_EQUAL(docscript::escape_html("a < b && c > \"d\""), "a &lt; b &amp;&amp; c &gt; &quot;d&quot;");
+	BOOST_CHECK_EQUAL(docscript::escape_html(std::string(40, 'x') + "<"), std::string(40, 'x') + "&lt;");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/labels.h>
+
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/uuid/string_generator.hpp>
+
+namespace
+{
+	boost::uuids::uuid const fig = boost::uuids::string_generator()("338d542a-a4e3-4a4c-9efe-b8d3032306c3");
+	boost::uuids::uuid const tbl = boost::uuids::string_generator()("9d0dd0fd-de54-49cc-86b0-64fe35b6d5a5");
+
+	/**
+	 * Plain text of a reference: the number of the label or the
+	 * name of the reference
+	 */
+	docscript::label_buffer::resolver_f make_resolver(docscript::label_table const& labels)
+	{
+		return [&labels](std::size_t idx) -> std::string {
+			auto const* ref = labels.get_ref(idx);
+			if (ref == nullptr)	return "?";
+			auto const* lbl = labels.find(ref->tag_);
+			return (lbl != nullptr)
+				? lbl->number_
+				: ref->name_
+				;
+		};
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(labels_suite)
+
+BOOST_AUTO_TEST_CASE(table)
+{
+	docscript::label_table labels;
+	BOOST_CHECK(!labels.has_refs());
+	BOOST_CHECK(labels.add(fig, docscript::label_kind::FIGURE, "1", "Daisies"));
+	BOOST_CHECK(!labels.add(fig, docscript::label_kind::FIGURE, "2", "Frog"));
+
+	auto const* lbl = labels.find(fig);
+	BOOST_REQUIRE(lbl != nullptr);
+	BOOST_CHECK_EQUAL(lbl->number_, "1");
+	BOOST_CHECK_EQUAL(lbl->caption_, "Daisies");
+	BOOST_CHECK(labels.find(tbl) == nullptr);
+
+	auto const m = labels.add_ref(tbl, "tbl", "");
+	BOOST_CHECK_EQUAL(m, std::string("\x1a") + "0" + "\x1a");
+	BOOST_CHECK(labels.has_refs());
+	BOOST_CHECK_EQUAL(labels.report_dangling(), 1u);
+
+	labels.add(tbl, docscript::label_kind::TABLE, "3", "Prices");
+	BOOST_CHECK_EQUAL(labels.report_dangling(), 0u);
+
+	labels.clear();
+	BOOST_CHECK(!labels.has_refs());
+	BOOST_CHECK(labels.find(fig) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(stream)
+{
+	docscript::label_table labels;
+
+	//
+	//	forward reference
+	//
+	auto const text = "see " + labels.add_ref(fig, "fig", "") + " and " + labels.add_ref(tbl, "tbl", "");
+	labels.add(fig, docscript::label_kind::FIGURE, "1", "Daisies");
+
+	std::ostringstream out;
+	{
+		docscript::label_stream los(out, make_resolver(labels));
+		los << text << std::endl;
+	}
+	BOOST_CHECK_EQUAL(out.str(), "see 1 and tbl\n");
+
+	//
+	//	marker split over single characters
+	//
+	out.str("");
+	{
+		docscript::label_stream los(out, make_resolver(labels));
+		for (auto const c : text) {
+			los << c;
+		}
+	}
+	BOOST_CHECK_EQUAL(out.str(), "see 1 and tbl");
+
+	//
+	//	larger than the internal buffer
+	//
+	std::string const large(0x3000, 'x');
+	out.str("");
+	{
+		docscript::label_stream los(out, make_resolver(labels));
+		los << large << text << large;
+	}
+	BOOST_CHECK_EQUAL(out.str(), large + "see 1 and tbl" + large);
+}
+
+BOOST_AUTO_TEST_CASE(incomplete)
+{
+	docscript::label_table labels;
+	labels.add_ref(fig, "fig", "");
+
+	std::string const text = std::string("a\x1a") + "0b\x1a" + "12";
+	std::ostringstream out;
+	{
+		docscript::label_stream los(out, make_resolver(labels));
+		los << text;
+	}
+	BOOST_CHECK_EQUAL(out.str(), text);
+}
+
+BOOST_AUTO_TEST_CASE(resolve)
+{
+	docscript::label_table labels;
+	auto const caption = "Prices as in " + labels.add_ref(fig, "fig", "");
+	labels.add(fig, docscript::label_kind::FIGURE, "2", "Daisies");
+	labels.add(tbl, docscript::label_kind::TABLE, "1", caption);
+
+	BOOST_CHECK_EQUAL(docscript::resolve_markers("no references", make_resolver(labels)), "no references");
+	BOOST_CHECK_EQUAL(docscript::resolve_markers(labels.find(tbl)->caption_, make_resolver(labels)), "Prices as in 2");
+	BOOST_CHECK_EQUAL(docscript::resolve_markers("", make_resolver(labels)), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/precompress.h>
+
+#include <fstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#ifdef DOCSCRIPT_ZLIB_INSTALLED
+
+namespace
+{
+	void write_file(cyng::filesystem::path const& p, std::string const& content)
+	{
+		std::ofstream ofs(p.string(), std::ios::binary | std::ios::trunc);
+		ofs << content;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(precompress_suite)
+
+BOOST_AUTO_TEST_CASE(unchanged)
+{
+	auto const p = cyng::filesystem::temp_directory_path() / "docscript-test-precompress.html";
+	cyng::filesystem::path const gz(p.string() + ".gz");
+	cyng::error_code ec;
+	cyng::filesystem::remove(gz, ec);
+
+	write_file(p, std::string(10000, 'x'));
+	BOOST_REQUIRE(docscript::precompress_file(p, docscript::PRECOMPRESS_GZIP));
+	BOOST_REQUIRE(cyng::filesystem::exists(gz));
+	auto const size = cyng::filesystem::file_size(gz);
+
+	//
+	//	same content: the sidecar is not written again
+	//
+	cyng::filesystem::resize_file(gz, size + 1);
+	BOOST_CHECK(docscript::precompress_file(p, docscript::PRECOMPRESS_GZIP));
+	BOOST_CHECK_EQUAL(cyng::filesystem::file_size(gz), size + 1);
+
+	//
+	//	new content: the sidecar is replaced
+	//
+	write_file(p, "changed");
+	BOOST_CHECK(docscript::precompress_file(p, docscript::PRECOMPRESS_GZIP));
+	BOOST_CHECK(cyng::filesystem::file_size(gz) != size + 1);
+	BOOST_CHECK(!cyng::filesystem::exists(p.string() + ".gz.tmp"));
+
+	cyng::filesystem::remove(gz, ec);
+	cyng::filesystem::remove(p, ec);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/source.h>
+
+#include <fstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	/**
+	 * Temporary file that is removed at the end of the test
+	 */
+	struct temp_file
+	{
+		temp_file(std::string const& content)
+			: path_(cyng::filesystem::temp_directory_path() / "docscript-test-source.txt")
+		{
+			std::ofstream ofs(path_.string(), std::ios::binary | std::ios::trunc);
+			ofs << content;
+		}
+		~temp_file()
+		{
+			cyng::error_code ec;
+			cyng::filesystem::remove(path_, ec);
+		}
+		cyng::filesystem::path const path_;
+	};
+
+	std::string to_string(docscript::source_file const& src)
+	{
+		return std::string(src.begin(), src.end());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(source_suite)
+
+BOOST_AUTO_TEST_CASE(lines)
+{
+	temp_file const f("one\ntwo\nthree\nfour\n");
+
+	docscript::source_file const all(f.path_);
+	BOOST_REQUIRE(all.is_open());
+	BOOST_CHECK_EQUAL(to_string(all), "one\ntwo\nthree\nfour\n");
+	BOOST_CHECK_EQUAL(all.get_offset(), 0u);
+	BOOST_CHECK_EQUAL(all.get_position(), 0u);
+
+	docscript::source_file const range(f.path_, docscript::excerpt{ 2, 3, 0 });
+	BOOST_CHECK_EQUAL(to_string(range), "two\nthree\n");
+	BOOST_CHECK_EQUAL(range.get_offset(), 1u);
+	BOOST_CHECK_EQUAL(range.get_position(), 4u);
+	BOOST_CHECK(!range.is_truncated());
+}
+
+BOOST_AUTO_TEST_CASE(max_size)
+{
+	temp_file const f("one\ntwo\nthree\n");
+
+	//
+	//	cut after the last complete line
+	//
+	docscript::source_file const src(f.path_, docscript::excerpt{ 0, 0, 10 });
+	BOOST_CHECK_EQUAL(to_string(src), "one\ntwo\n");
+	BOOST_CHECK(src.is_truncated());
+}
+
+BOOST_AUTO_TEST_CASE(utf8)
+{
+	//
+	//	a single line of 2 byte (U+00E4) and 3 byte (U+20AC) sequences
+	//
+	temp_file const f("\xc3\xa4\xc3\xa4\xe2\x82\xac\xe2\x82\xac");
+
+	docscript::source_file const odd(f.path_, docscript::excerpt{ 0, 0, 3 });
+	BOOST_CHECK_EQUAL(to_string(odd), "\xc3\xa4");
+	BOOST_CHECK(odd.is_truncated());
+
+	docscript::source_file const inside(f.path_, docscript::excerpt{ 0, 0, 9 });
+	BOOST_CHECK_EQUAL(to_string(inside), "\xc3\xa4\xc3\xa4\xe2\x82\xac");
+
+	docscript::source_file const exact(f.path_, docscript::excerpt{ 0, 0, 7 });
+	BOOST_CHECK_EQUAL(to_string(exact), "\xc3\xa4\xc3\xa4\xe2\x82\xac");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Sylko Olzscher
+ *
+ */
+
+#include <docscript/generator/svg.h>
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(svg_suite)
+
+BOOST_AUTO_TEST_CASE(shorten)
+{
+	BOOST_CHECK_EQUAL(docscript::shorten_numbers("M 10.000001,20.123456", 3), "M 10,20.123");
+	BOOST_CHECK_EQUAL(docscript::shorten_numbers("0.5 1.0.5", 2), ".5 1 .5");
+	BOOST_CHECK_EQUAL(docscript::shorten_numbers("M 1e-7,2", 3), "M 0,2");
+}
+
+BOOST_AUTO_TEST_CASE(precision)
+{
+	pugi::xml_document doc;
+
+	BOOST_REQUIRE(doc.load_string("<svg viewBox=\"0 0 210 297\"/>"));
+	BOOST_CHECK_EQUAL(docscript::get_svg_precision(doc.child("svg"), 5), 2u);
+
+	BOOST_REQUIRE(doc.load_string("<svg viewBox=\"0,0,1.5,1\"/>"));
+	BOOST_CHECK_EQUAL(docscript::get_svg_precision(doc.child("svg"), 5), 4u);
+
+	BOOST_REQUIRE(doc.load_string("<svg viewBox=\"0 0 24000 12000\"/>"));
+	BOOST_CHECK_EQUAL(docscript::get_svg_precision(doc.child("svg"), 5), 0u);
+
+	//
+	//	intrinsic size, no viewBox
+	//
+	BOOST_REQUIRE(doc.load_string("<svg width=\"16px\" height=\"16px\"/>"));
+	BOOST_CHECK_EQUAL(docscript::get_svg_precision(doc.child("svg"), 5), 3u);
+
+	//
+	//	no size at all
+	//
+	BOOST_REQUIRE(doc.load_string("<svg width=\"100%\"/>"));
+	BOOST_CHECK_EQUAL(docscript::get_svg_precision(doc.child("svg"), 5), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(minify)
+{
+	pugi::xml_document doc;
+	BOOST_REQUIRE(doc.load_string("<svg viewBox=\"0 0 10.123456 10.123456\"><!-- comment --><path d=\"M 1.123456 2.987654\"/></svg>"));
+	auto svg = doc.child("svg");
+	docscript::minify_svg(svg, 2);
+	BOOST_CHECK_EQUAL(std::string(svg.attribute("viewBox").value()), "0 0 10.123456 10.123456");
+	BOOST_CHECK_EQUAL(std::string(svg.child("path").attribute("d").value()), "M 1.12 2.99");
+	BOOST_CHECK(svg.first_child().type() != pugi::node_comment);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
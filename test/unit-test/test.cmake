@@ -0,0 +1,26 @@
+# 
+#	reset 
+#
+set (unit_test)
+
+set (unit_test_cpp
+	test/unit-test/src/main.cpp
+	test/unit-test/src/test_base64.cpp
+	test/unit-test/src/test_svg.cpp
+	test/unit-test/src/test_source.cpp
+	test/unit-test/src/test_precompress.cpp
+	test/unit-test/src/test_compact.cpp
+	test/unit-test/src/test_labels.cpp
+	test/unit-test/src/test_escape.cpp
+	test/unit-test/src/test_cache.cpp
+)
+    
+set (unit_test_h
+	 "${PROJECT_BINARY_DIR}/DOCC_project_info.h"
+)
+
+# define the unit test program
+set (unit_test
+  ${unit_test_cpp}
+  ${unit_test_h}
+)
@@ -8,6 +8,7 @@
 
 #include "batch.h"
 #include "../../src/driver.h"
+#include <docscript/generator/sink.h>
 
 #include <cyng/json.h>
 #include <cyng/dom/reader.h>
@@ -29,12 +30,55 @@ namespace docscript
 		, int verbose)
 	: includes_(inc.begin(), inc.end())
 		, verbose_(verbose)
+		, pool_(std::vector< cyng::filesystem::path >(inc.begin(), inc.end()))
+		, tracer_(nullptr)
+		, cache_(nullptr)
+		, assets_(nullptr)
+		, workers_(nullptr)
+		, style_sheet_(nullptr)
+		, minify_(false)
+		, precompress_(0)
 		, index_()
 	{}
 
 	batch::~batch()
 	{}
 
+	void batch::set_tracer(docscript::tracer& t)
+	{
+		tracer_ = &t;
+	}
+
+	void batch::set_cache(docscript::content_cache& c)
+	{
+		cache_ = &c;
+	}
+
+	void batch::set_assets(docscript::asset_store& a)
+	{
+		assets_ = &a;
+	}
+
+	void batch::set_workers(docscript::worker_pool& w)
+	{
+		workers_ = &w;
+	}
+
+	void batch::set_style_sheet(docscript::style_sheet& s)
+	{
+		style_sheet_ = &s;
+	}
+
+	void batch::set_minify(bool b)
+	{
+		minify_ = b;
+	}
+
+	void batch::set_precompress(unsigned formats)
+	{
+		precompress_ = formats;
+	}
+
 	int batch::run(cyng::filesystem::path const& inp
 		, cyng::filesystem::path const& out
 		, bool gen_robot
@@ -80,7 +124,16 @@ namespace docscript
 				//
 				//	Construct driver instance
 				//
+				trace_scope ts(tracer_, inp.filename().string(), "document");
 				driver d(includes_, verbose_);
+				d.use_pool(pool_);
+				if (tracer_ != nullptr)	d.set_tracer(*tracer_);
+				if (cache_ != nullptr)	d.set_cache(*cache_);
+				if (assets_ != nullptr)	d.set_assets(*assets_);
+				if (workers_ != nullptr)	d.set_workers(*workers_);
+				if (style_sheet_ != nullptr)	d.set_style_sheet(*style_sheet_);
+				d.set_minify(minify_);
+				d.set_precompress(precompress_);
 
 				//
 				//	output file
@@ -116,6 +169,8 @@ namespace docscript
 		, bool gen_robot
 		, bool gen_sitemap)
 	{
+		trace_scope ts(tracer_, "index", "document");
+
 		//
 		//	chronological order
 		//
@@ -154,7 +209,7 @@ namespace docscript
 	{
 		cyng::filesystem::path p = out / "index.html";
 
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -165,6 +220,7 @@ namespace docscript
 		}
 		else
 		{
+			ofs.precompress(precompress_);
 			ofs
 				<< "<div class=\"docscript\">"
 				<< std::endl
@@ -235,7 +291,7 @@ namespace docscript
 	{
 		cyng::filesystem::path p = out / "index.json";
 
-		std::ofstream ofs(p.string(), std::ios::out | std::ios::trunc);
+		sink ofs(p);
 		if (!ofs.is_open())
 		{
 			std::cerr
@@ -246,6 +302,8 @@ namespace docscript
 		}
 		else
 		{
+			ofs.precompress(precompress_);
+
 			//
 			//	data vector of all available posts
 			//
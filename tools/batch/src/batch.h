@@ -8,6 +8,8 @@
 #ifndef DOCC_BATCH_H
 #define DOCC_BATCH_H
 
+#include <docscript/generator/pool.h>
+
 #include <cyng/object.h>
 #include <cyng/intrinsics/sets.h>
 #include <chrono>
@@ -49,6 +51,48 @@ namespace docscript
 			, bool gen_robot
 			, bool gen_sitemap);
 
+		/**
+		 * Record the timing of all processed files.
+		 * The tracer must outlive this object.
+		 */
+		void set_tracer(docscript::tracer&);
+
+		/**
+		 * Share encoded images and other processed resources
+		 * between all processed files.
+		 * The cache must outlive this object.
+		 */
+		void set_cache(docscript::content_cache&);
+
+		/**
+		 * Write images of all processed files into a shared 
+		 * asset directory. The asset store must outlive this object.
+		 */
+		void set_assets(docscript::asset_store&);
+
+		/**
+		 * Render listings, figures and tables of all processed files
+		 * on the specified threads. The worker pool must outlive this object.
+		 */
+		void set_workers(docscript::worker_pool&);
+
+		/**
+		 * Reference one stylesheet from all processed files.
+		 * The stylesheet must outlive this object.
+		 */
+		void set_style_sheet(docscript::style_sheet&);
+
+		/**
+		 * Write minified HTML.
+		 */
+		void set_minify(bool);
+
+		/**
+		 * Write compressed sidecars (".gz", ".zst") of all
+		 * generated HTML and JSON files.
+		 */
+		void set_precompress(unsigned formats);
+
 	private:
 		void process_file(cyng::filesystem::path const& inp
 			, cyng::filesystem::path const& out);
@@ -78,6 +122,45 @@ namespace docscript
 		 */
 		int const verbose_;
 
+		/**
+		 * Reuse generators for all processed files
+		 */
+		generator_pool pool_;
+
+		/**
+		 * optional timing trace
+		 */
+		tracer* tracer_;
+
+		/**
+		 * optional cache of processed resources
+		 */
+		content_cache* cache_;
+
+		/**
+		 * optional external asset directory
+		 */
+		asset_store* assets_;
+
+		/**
+		 * optional threads for expensive build-in functions
+		 */
+		worker_pool* workers_;
+
+		/**
+		 * optional external stylesheet
+		 */
+		style_sheet* style_sheet_;
+
+		/**
+		 * minify HTML output
+		 */
+		bool minify_;
+
+		/**
+		 * formats of compressed sidecars
+		 */
+		unsigned precompress_;
 
 		//cyng::param_map_t index_;
 		std::map<cyng::filesystem::path, cyng::param_map_t> index_;
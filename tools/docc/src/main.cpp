@@ -13,6 +13,11 @@
 #include <iostream>
 #include <DOCC_project_info.h>
 #include "../../src/driver.h"
+#include <docscript/generator/assets.h>
+#include <docscript/generator/cache.h>
+#include <docscript/generator/precompress.h>
+#include <docscript/generator/style.h>
+#include <docscript/generator/workers.h>
 #if BOOST_OS_WINDOWS
 #include <windows.h>
 #endif
@@ -63,6 +68,7 @@ int main(int argc, char* argv[]) {
 			("include-path,I", boost::program_options::value< std::vector<std::string> >()->default_value(std::vector<std::string>(1, cwd.string()), cwd.string()), "include path")
 			//	verbose level
 			("verbose,V", boost::program_options::value<int>()->default_value(0)->implicit_value(1), "verbose level")
+			("trace", boost::program_options::value<std::string>(), "write a timing trace in Chrome trace-event format")
 			;
 
 		boost::program_options::options_description gen("generator");
@@ -71,6 +77,16 @@ int main(int argc, char* argv[]) {
 			("generator.meta", boost::program_options::bool_switch()->default_value(true), "generate a JSON file with meta data")
 			("generator.index", boost::program_options::bool_switch()->default_value(true), "generate an index file \"index.json\"")
 			("generator.type,T", boost::program_options::value<std::string>()->default_value("report"), "og:type (article/report)")
+			("generator.profile", boost::program_options::bool_switch()->default_value(false), "profile build-in functions")
+			("generator.cache", boost::program_options::value<std::string>()->default_value(""), "directory to keep processed images between runs")
+			("generator.assets", boost::program_options::bool_switch()->default_value(false), "write images into an assets directory next to the output file")
+			("generator.inline-limit", boost::program_options::value<std::uintmax_t>()->default_value(4096), "images up to this size stay inline in asset mode")
+			("generator.hardlink", boost::program_options::bool_switch()->default_value(false), "hardlink assets instead of copying them")
+			("generator.jobs,j", boost::program_options::value<std::size_t>()->default_value(1), "threads to render listings, figures and tables (1 = no threads, 0 = all cores)")
+			("generator.stylesheet", boost::program_options::bool_switch()->default_value(false), "write style rules into a css directory next to the output file (HTML)")
+			("generator.critical-css", boost::program_options::bool_switch()->default_value(false), "keep body and heading rules inline in stylesheet mode")
+			("generator.minify", boost::program_options::bool_switch()->default_value(false), "remove indentation, comments and redundant whitespace (HTML)")
+			("generator.precompress", boost::program_options::bool_switch()->default_value(false), "write .gz and .zst files next to generated HTML, JSON and SVG files")
 			;
 
 		//
@@ -237,15 +253,66 @@ int main(int argc, char* argv[]) {
 
 		}
 #endif
+		//
+		//	optional cache of processed images
+		//
+		auto const cache_dir = vm["generator.cache"].as< std::string >();
+		docscript::content_cache cache(cache_dir);
+
+		//
+		//	optional external images
+		//
+		docscript::asset_store assets(cyng::filesystem::path(out_file).parent_path()
+			, vm["generator.inline-limit"].as< std::uintmax_t >()
+			, vm["generator.hardlink"].as< bool >());
+
+		//
+		//	listings, figures and tables are rendered in parallel
+		//
+		auto const jobs = vm["generator.jobs"].as< std::size_t >();
+		docscript::worker_pool workers(jobs);
+
+		//
+		//	optional shared stylesheet
+		//
+		docscript::style_sheet styles(cyng::filesystem::path(out_file).parent_path()
+			, vm["generator.critical-css"].as< bool >());
+
 		//
 		//	Construct driver instance
 		//
   		docscript::driver d(inc_paths, verbose);
+		d.set_profiling(vm["generator.profile"].as< bool >());
+		if (!cache_dir.empty())	d.set_cache(cache);
+		if (vm["generator.assets"].as< bool >())	d.set_assets(assets);
+		if (jobs != 1)	d.set_workers(workers);
+		if (vm["generator.stylesheet"].as< bool >())	d.set_style_sheet(styles);
+		d.set_minify(vm["generator.minify"].as< bool >());
+
+		//
+		//	compressed sidecars
+		//
+		if (vm["generator.precompress"].as< bool >()) {
+			auto const formats = docscript::precompress_formats();
+			if (formats == docscript::PRECOMPRESS_NONE) {
+				std::cerr
+					<< "***warning: precompression requires zlib or libzstd"
+					<< std::endl;
+			}
+			assets.set_precompress(formats);
+			d.set_precompress(formats);
+		}
+
+		//
+		//	optional timing trace
+		//
+		docscript::tracer t;
+		if (vm.count("trace"))	d.set_tracer(t);
 
 		//
 		//	Start driver with the main/input file
 		//
- 		return d.run(cyng::filesystem::path(inp_file).filename()
+ 		auto const rc = d.run(cyng::filesystem::path(inp_file).filename()
  			, tmp
 			, out_file
 			, vm["generator.body"].as< bool >()
@@ -253,6 +320,22 @@ int main(int argc, char* argv[]) {
 			, vm["generator.index"].as< bool >()
 			, vm["generator.type"].as< std::string >());
 
+		if (vm["generator.assets"].as< bool >() && !assets.write_manifest()) {
+			std::cerr
+				<< "***error: cannot write asset manifest"
+				<< std::endl
+				;
+		}
+
+		if (vm.count("trace") && !t.write(vm["trace"].as< std::string >())) {
+			std::cerr
+				<< "***error: cannot write trace file "
+				<< vm["trace"].as< std::string >()
+				<< std::endl
+				;
+		}
+		return rc;
+
 	}
 	catch (std::exception& e)
 	{
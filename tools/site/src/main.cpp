@@ -67,6 +67,14 @@ int main(int argc, char* argv[]) {
 			("include-path,I", boost::program_options::value< std::vector<std::string> >()->default_value(std::vector<std::string>(1, cwd.string()), cwd.string()), "include path")
 			//	verbose level
 			("verbose,V", boost::program_options::value<int>()->default_value(0)->implicit_value(1), "verbose level")
+			("trace", boost::program_options::value<std::string>(), "write a timing trace in Chrome trace-event format")
+			("cache", boost::program_options::value<std::string>()->default_value(""), "directory to keep processed images between runs")
+			("assets", boost::program_options::bool_switch()->default_value(false), "write images into <output>/assets instead of inlining them")
+			("inline-limit", boost::program_options::value<std::uintmax_t>()->default_value(4096), "images up to this size stay inline in asset mode")
+			("hardlink", boost::program_options::bool_switch()->default_value(false), "hardlink assets instead of copying them")
+			("jobs,j", boost::program_options::value<std::size_t>()->default_value(1), "threads to render listings, figures and tables (1 = no threads, 0 = all cores)")
+			("minify", boost::program_options::bool_switch()->default_value(false), "remove indentation, comments and redundant whitespace")
+			("precompress", boost::program_options::bool_switch()->default_value(false), "write .gz and .zst files next to generated HTML, JSON and SVG files")
 			("robot,R", boost::program_options::bool_switch()->default_value(true), "generate robots.txt")
 			//	https://www.sitemaps.org/index.html
 			("sitemap", boost::program_options::bool_switch()->default_value(false), "generate a sitemap file")
@@ -211,19 +219,76 @@ int main(int argc, char* argv[]) {
 
 		}
 #endif
+		//
+		//	Processed images are shared between all documents.
+		//	Without a cache directory they are kept in memory only.
+		//
+		docscript::content_cache cache(vm["cache"].as< std::string >());
+
+		//
+		//	optional external images
+		//
+		docscript::asset_store assets(out_dir, vm["inline-limit"].as< std::uintmax_t >(), vm["hardlink"].as< bool >());
+
+		//
+		//	listings, figures and tables are rendered in parallel
+		//
+		auto const jobs = vm["jobs"].as< std::size_t >();
+		docscript::worker_pool workers(jobs);
+
 		//
 		//	Construct driver instance
 		//
   		docscript::site s(inc_paths, verbose);
+		s.set_cache(cache);
+		if (vm["assets"].as< bool >())	s.set_assets(assets);
+		if (jobs != 1)	s.set_workers(workers);
+		s.set_minify(vm["minify"].as< bool >());
+
+		//
+		//	compressed sidecars
+		//
+		if (vm["precompress"].as< bool >()) {
+			auto const formats = docscript::precompress_formats();
+			if (formats == docscript::PRECOMPRESS_NONE) {
+				std::cerr
+					<< "***warning: precompression requires zlib or libzstd"
+					<< std::endl;
+			}
+			assets.set_precompress(formats);
+			s.set_precompress(formats);
+		}
+
+		//
+		//	optional timing trace
+		//
+		docscript::tracer t;
+		if (vm.count("trace"))	s.set_tracer(t);
 
 		//
 		//	Start driver with the main/input file
 		//
-		return s.run(cfg_file
+		auto const rc = s.run(cfg_file
 			, out_dir
 			, vm["robot"].as< bool >()
 			, vm["sitemap"].as< bool >());
 
+		if (vm["assets"].as< bool >() && !assets.write_manifest()) {
+			std::cerr
+				<< "***error: cannot write asset manifest"
+				<< std::endl
+				;
+		}
+
+		if (vm.count("trace") && !t.write(vm["trace"].as< std::string >())) {
+			std::cerr
+				<< "***error: cannot write trace file "
+				<< vm["trace"].as< std::string >()
+				<< std::endl
+				;
+		}
+		return rc;
+
 
 	}
 	catch (std::exception& e)
@@ -8,6 +8,7 @@
 
 #include "site.h"
 #include "../../src/driver.h"
+#include <docscript/generator/sink.h>
 #include <html/dom.hpp>
 
 #include <cyng/json.h>
@@ -39,11 +40,49 @@ namespace docscript
 		, int verbose)
 	: includes_(inc.begin(), inc.end())
 		, verbose_(verbose)
+		, pool_(includes_)
+		, tracer_(nullptr)
+		, cache_(nullptr)
+		, assets_(nullptr)
+		, workers_(nullptr)
+		, minify_(false)
+		, precompress_(0)
+		, css_copied_()
 	{}
 
 	site::~site()
 	{}
 
+	void site::set_tracer(docscript::tracer& t)
+	{
+		tracer_ = &t;
+	}
+
+	void site::set_cache(docscript::content_cache& c)
+	{
+		cache_ = &c;
+	}
+
+	void site::set_assets(docscript::asset_store& a)
+	{
+		assets_ = &a;
+	}
+
+	void site::set_workers(docscript::worker_pool& w)
+	{
+		workers_ = &w;
+	}
+
+	void site::set_minify(bool b)
+	{
+		minify_ = b;
+	}
+
+	void site::set_precompress(unsigned formats)
+	{
+		precompress_ = formats;
+	}
+
 	int site::run(cyng::filesystem::path const& cfg
 		, cyng::filesystem::path const& out
 		, bool gen_robot
@@ -162,8 +201,9 @@ namespace docscript
 		//
 		//	build page
 		//
-		std::ofstream ofs((out / p.get_file()).string());
+		sink ofs(out / p.get_file());
 		if (ofs.is_open()) {
+			ofs.precompress(precompress_);
 
 			std::cout 
 				<< "***info: build page " 
@@ -287,10 +327,19 @@ namespace docscript
 		, boost::uuids::name_generator_sha1& gen
 		, cyng::filesystem::path const& out)
 	{
+		trace_scope ts(tracer_, p.get_name(), "page");
+
 		//
 		//	Construct driver instance
 		//
 		driver d(includes_, verbose_);
+		d.use_pool(pool_);
+		if (tracer_ != nullptr)	d.set_tracer(*tracer_);
+		if (cache_ != nullptr)	d.set_cache(*cache_);
+		if (assets_ != nullptr)	d.set_assets(*assets_);
+		if (workers_ != nullptr)	d.set_workers(*workers_);
+		d.set_minify(minify_);
+		d.set_precompress(precompress_);
 
 		//
 		//	generate some temporary file names for intermediate files
@@ -534,7 +583,7 @@ namespace docscript
 		}
 	}
 
-	void site::import_css(std::ofstream& ofs
+	void site::import_css(std::ostream& ofs
 		, page const& p
 		, cyng::filesystem::path css
 		, cyng::filesystem::path const& out)
@@ -543,7 +592,19 @@ namespace docscript
 		//	search css file
 		//
 		auto const r = resolve_path(includes_, css);
-		if (r.second) {
+		if (r.second && css_copied_.count(out / css) != 0) {
+
+			//
+			//	copied by a previous page
+			//
+			ofs
+				<< "\t<link rel=\"stylesheet\" href=\""
+				<< css.generic_string()
+				<< "\">"
+				<< std::endl
+				;
+		}
+		else if (r.second) {
 
 			std::cerr
 				<< "***info: copy ["
@@ -581,6 +642,7 @@ namespace docscript
 			}
 			cyng::filesystem::remove(full_path);
 			cyng::filesystem::copy(r.first, full_path);
+			css_copied_.insert(full_path);
 
 			//
 			//	insert link
@@ -733,7 +795,7 @@ namespace docscript
 		return dict;
 	}
 
-	void import_menu(std::ofstream& ofs, page const& p, cyng::filesystem::path const& out)
+	void import_menu(std::ostream& ofs, page const& p, cyng::filesystem::path const& out)
 	{
 		if (p.has_menu()) {
 
@@ -750,7 +812,7 @@ namespace docscript
 		}
 	}
 
-	void import_body(std::ofstream& ofs, page const& p, cyng::filesystem::path const& out)
+	void import_body(std::ostream& ofs, page const& p, cyng::filesystem::path const& out)
 	{
 		std::ifstream ifs(p.get_fragment().string());
 		if (ifs.is_open()) {
@@ -763,7 +825,7 @@ namespace docscript
 		}
 	}
 
-	void import_footer(std::ofstream& ofs, page const& p, cyng::filesystem::path const& out)
+	void import_footer(std::ostream& ofs, page const& p, cyng::filesystem::path const& out)
 	{
 		std::ifstream ifs(p.get_footer_file().string());
 		if (ifs.is_open()) {
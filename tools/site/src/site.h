@@ -10,9 +10,11 @@
 
 
 #include "page.h"
+#include <docscript/generator/pool.h>
 #include <cyng/object.h>
 #include <cyng/intrinsics/sets.h>
 #include <chrono>
+#include <set>
 #include <cyng/compatibility/file_system.hpp>
 
 #include <boost/uuid/uuid.hpp>
@@ -53,6 +55,41 @@ namespace docscript
 			, bool gen_robot
 			, bool gen_sitemap);
 
+		/**
+		 * Record the timing of all pages.
+		 * The tracer must outlive this object.
+		 */
+		void set_tracer(docscript::tracer&);
+
+		/**
+		 * Share encoded images and other processed resources
+		 * between all processed files.
+		 * The cache must outlive this object.
+		 */
+		void set_cache(docscript::content_cache&);
+
+		/**
+		 * Write images of all processed files into a shared 
+		 * asset directory. The asset store must outlive this object.
+		 */
+		void set_assets(docscript::asset_store&);
+
+		/**
+		 * Render listings, figures and tables of all processed files
+		 * on the specified threads. The worker pool must outlive this object.
+		 */
+		void set_workers(docscript::worker_pool&);
+
+		/**
+		 * Write minified HTML.
+		 */
+		void set_minify(bool);
+
+		/**
+		 * Write compressed sidecars (".gz", ".zst") of all pages.
+		 */
+		void set_precompress(unsigned formats);
+
 	private:
 		void generate(cyng::param_map_t&&, cyng::filesystem::path const&);
 
@@ -96,7 +133,7 @@ namespace docscript
 			, std::string const& css
 			, cyng::filesystem::path const& out);
 
-		void import_css(std::ofstream& of
+		void import_css(std::ostream& of
 			, page const& p
 			, cyng::filesystem::path css
 			, cyng::filesystem::path const& out);
@@ -115,6 +152,47 @@ namespace docscript
 		 */
 		int const verbose_;
 
+		/**
+		 * Reuse generators for all pages
+		 */
+		generator_pool pool_;
+
+		/**
+		 * optional timing trace
+		 */
+		tracer* tracer_;
+
+		/**
+		 * optional cache of processed resources
+		 */
+		content_cache* cache_;
+
+		/**
+		 * optional external asset directory
+		 */
+		asset_store* assets_;
+
+		/**
+		 * optional threads for expensive build-in functions
+		 */
+		worker_pool* workers_;
+
+		/**
+		 * minify HTML output
+		 */
+		bool minify_;
+
+		/**
+		 * formats of compressed sidecars
+		 */
+		unsigned precompress_;
+
+		/**
+		 * stylesheets already copied into the build directory.
+		 * All pages share the same copy.
+		 */
+		std::set<cyng::filesystem::path> css_copied_;
+
 	};
 
 	/**
@@ -129,9 +207,9 @@ namespace docscript
 		, boost::uuids::name_generator_sha1&
 		, cyng::filesystem::path const& out);
 
-	void import_menu(std::ofstream& of, page const& p, cyng::filesystem::path const& out);
-	void import_body(std::ofstream& of, page const& p, cyng::filesystem::path const& out);
-	void import_footer(std::ofstream& of, page const& p, cyng::filesystem::path const& out);
+	void import_menu(std::ostream& of, page const& p, cyng::filesystem::path const& out);
+	void import_body(std::ostream& of, page const& p, cyng::filesystem::path const& out);
+	void import_footer(std::ostream& of, page const& p, cyng::filesystem::path const& out);
 }
 
 #endif
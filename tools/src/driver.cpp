@@ -9,13 +9,10 @@
 #include "reader.h"
 #include <docscript/symbol.h>
 #include <docscript/parser.h>
-#include <docscript/generator/gen_html.h>
-#include <docscript/generator/gen_md.h>
-#include <docscript/generator/gen_asciidoc.h>
-#include <docscript/generator/gen_LaTeX.h>
-#include <docscript/generator/gen_bootstrap.h>
+#include <docscript/generator/pool.h>
 
 #include <cyng/io/serializer.h>
+#include <cyng/json.h>
 #include <cyng/io/parser/parser.h>
 #include <cyng/io/io_chrono.hpp>
 #include <cyng/traits.h>
@@ -38,6 +35,17 @@ namespace docscript
 		, stream_()
 		, ctx_()
 		, meta_()
+		, pool_(nullptr)
+		, profiling_(false)
+		, tracer_(nullptr)
+		, cache_(nullptr)
+		, assets_(nullptr)
+		, workers_(nullptr)
+		, style_sheet_(nullptr)
+		, minify_(false)
+		, precompress_(0)
+		, sanitize_time_(tracer::clock_t::duration::zero())
+		, tokenize_time_(tracer::clock_t::duration::zero())
 
 		//
 		//	sanitizer => tokenizer 
@@ -54,6 +62,17 @@ namespace docscript
 		, stream_()
 		, ctx_()
 		, meta_()
+		, pool_(nullptr)
+		, profiling_(false)
+		, tracer_(nullptr)
+		, cache_(nullptr)
+		, assets_(nullptr)
+		, workers_(nullptr)
+		, style_sheet_(nullptr)
+		, minify_(false)
+		, precompress_(0)
+		, sanitize_time_(tracer::clock_t::duration::zero())
+		, tokenize_time_(tracer::clock_t::duration::zero())
 		, sanitizer_(std::bind(&driver::sanitize, this, std::placeholders::_1), std::bind(&driver::print_error, this, std::placeholders::_1, std::placeholders::_2))
 		, tokenizer_(std::bind(&driver::tokenize, this, std::placeholders::_1), std::bind(&driver::print_error, this, std::placeholders::_1, std::placeholders::_2))
 	{}
@@ -61,6 +80,51 @@ namespace docscript
 	driver::~driver()
 	{}
 
+	void driver::use_pool(generator_pool& pool)
+	{
+		pool_ = &pool;
+	}
+
+	void driver::set_profiling(bool b)
+	{
+		profiling_ = b;
+	}
+
+	void driver::set_tracer(tracer& t)
+	{
+		tracer_ = &t;
+	}
+
+	void driver::set_cache(content_cache& c)
+	{
+		cache_ = &c;
+	}
+
+	void driver::set_assets(asset_store& a)
+	{
+		assets_ = &a;
+	}
+
+	void driver::set_workers(worker_pool& w)
+	{
+		workers_ = &w;
+	}
+
+	void driver::set_style_sheet(style_sheet& s)
+	{
+		style_sheet_ = &s;
+	}
+
+	void driver::set_minify(bool b)
+	{
+		minify_ = b;
+	}
+
+	void driver::set_precompress(unsigned formats)
+	{
+		precompress_ = formats;
+	}
+
 	void driver::tokenize(symbol&& sym)
 	{
 		if (verbose_ > 5)
@@ -85,6 +149,11 @@ namespace docscript
 			stats_[tok.value_] += tok.count_;
 		}
 
+		auto const start = (tracer_ != nullptr)
+			? tracer::clock_t::now()
+			: tracer::clock_t::time_point()
+			;
+
 		while (!tokenizer_.next(tok))
 		{
 #ifdef _DEBUG
@@ -97,6 +166,10 @@ namespace docscript
 			}
 #endif
 		}
+
+		if (tracer_ != nullptr) {
+			tokenize_time_ += tracer::clock_t::now() - start;
+		}
 	}
 
 	cyng::param_map_t const& driver::get_meta() const
@@ -182,6 +255,8 @@ namespace docscript
 		//	get a timestamp to measure performance
 		//
 		auto const now = std::chrono::system_clock::now();
+		trace_scope ts(tracer_, "compile", "compiler");
+		ts.arg("file", master.string());
 
 		//
 		//	read and tokenize file recursive
@@ -202,8 +277,25 @@ namespace docscript
 
 	int driver::run(cyng::filesystem::path const& inp, std::size_t start, std::size_t count, std::size_t depth)
 	{	
+		//
+		//	The reader feeds sanitizer and tokenizer line by line.
+		//	Their time is reported inclusive all nested includes.
+		//
+		trace_scope ts(tracer_, "read", "include");
+		auto const sanitize_time = sanitize_time_;
+		auto const tokenize_time = tokenize_time_;
+
 		reader r(*this, inp, start, count);
-		return r.run(depth)
+		auto const b = r.run(depth);
+
+		if (tracer_ != nullptr) {
+			ts.arg("file", inp.string());
+			ts.arg("depth", std::to_string(depth));
+			ts.arg("sanitize [us]", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>((sanitize_time_ - sanitize_time) - (tokenize_time_ - tokenize_time)).count()));
+			ts.arg("tokenize [us]", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(tokenize_time_ - tokenize_time).count()));
+		}
+
+		return b
 			? EXIT_SUCCESS
 			: EXIT_FAILURE
 			;
@@ -330,16 +422,23 @@ namespace docscript
 			//
 			//	generate parse tree (AST)
 			//
-			p.parse();
+			{
+				trace_scope ts(tracer_, "parse", "compiler");
+				p.parse();
+			}
 
 			//
 			//	generate code
 			//
-			auto const prg = p.get_ast().generate(out, meta, index);
+			auto const prg = [&]() {
+				trace_scope ts(tracer_, "codegen", "compiler");
+				return p.get_ast().generate(out, meta, index);
+			}();
 
 			//
 			//	serialize as program not as data (reverse on stack)
 			//
+			trace_scope ts(tracer_, "serialize IML", "compiler");
 			std::size_t counter{0};
 			for (auto obj : prg) {
 #ifdef _DEBUG
@@ -364,47 +463,10 @@ namespace docscript
 		//
 		//	read intermediate file
 		//
-		auto prg = read_iml_file(in);
+		auto prg = load_iml(in);
 
-		//
-		//	startup VM/generator
-		//
 		auto const extension = out.extension().string();
-		if (boost::algorithm::iequals(extension, ".html")) {
-			gen_html g(this->includes_, body_only);
-			g.run(std::move(prg));
-			auto const m = g.get_meta();
-			for (auto const& i : m) {
-				meta_[i.first] = i.second;
-			}
-		}
-		else if (boost::algorithm::iequals(extension, ".md")) {
-			gen_md g(this->includes_);
-			g.run(std::move(prg));
-			auto const m = g.get_meta();
-			for (auto const& i : m) {
-				meta_[i.first] = i.second;
-			}
-		}
-		else if (boost::algorithm::iequals(extension, ".asciidoc") 
-			|| boost::algorithm::iequals(extension, ".adoc") 
-			|| boost::algorithm::iequals(extension, ".asc")) {
-			gen_asciidoc g(this->includes_);
-			g.run(std::move(prg));
-			auto const m = g.get_meta();
-			for (auto const& i : m) {
-				meta_[i.first] = i.second;
-			}
-		}
-		else if (boost::algorithm::iequals(extension, ".tex")) {
-			gen_latex g(this->includes_);
-			g.run(std::move(prg));
-			auto const m = g.get_meta();
-			for (auto const& i : m) {
-				meta_[i.first] = i.second;
-			}
-		}
-		else {
+		if (!run_generator(get_format(extension, body_only), std::move(prg), out)) {
 			std::cerr
 				<< "***"
 				<< cyng::logging::to_string(cyng::logging::severity::LEVEL_FATAL)
@@ -420,17 +482,80 @@ namespace docscript
 		//
 		//	read intermediate file
 		//
-		auto prg = read_iml_file(in);
+		auto prg = load_iml(in);
 
+		run_generator("bootstrap", std::move(prg), out);
+	}
+
+	bool driver::run_generator(std::string const& format, cyng::vector_t&& prg, cyng::filesystem::path const& out)
+	{
 		//
 		//	startup VM/generator
+		//	The program runs synchronously on this thread. There is no
+		//	need to start a scheduler to process a single program.
+		//	Take a warm generator from the pool if available.
 		//
-		gen_bootstrap g(this->includes_);
-		g.run(std::move(prg));
-		auto const m = g.get_meta();
+		std::shared_ptr<generator> gp = (pool_ != nullptr)
+			? pool_->acquire(format)
+			: std::shared_ptr<generator>(make_generator(format, this->includes_))
+			;
+		if (!gp)	return false;
+
+		gp->set_profiling(profiling_);
+		gp->set_tracer(tracer_);
+		gp->set_cache(cache_);
+		gp->set_assets(assets_);
+		gp->set_workers(workers_);
+		gp->set_style_sheet(style_sheet_);
+		gp->set_minify(minify_);
+		gp->set_precompress(precompress_);
+		{
+			trace_scope ts(tracer_, "execute", "generator");
+			ts.arg("format", format);
+			ts.arg("file", out.string());
+			gp->run(std::move(prg));
+		}
+		auto const m = gp->get_meta();
 		for (auto const& i : m) {
 			meta_[i.first] = i.second;
 		}
+
+		auto const* prof = gp->get_profiler();
+		if (prof != nullptr) {
+			write_profile(*prof, out);
+		}
+		return true;
+	}
+
+	cyng::vector_t driver::load_iml(cyng::filesystem::path const& in)
+	{
+		trace_scope ts(tracer_, "load IML", "generator");
+		return read_iml_file(in);
+	}
+
+	void driver::write_profile(profiler const& prof, cyng::filesystem::path out)
+	{
+		//
+		//	next to the meta file
+		//
+		out.replace_extension(".profile.json");
+		std::ofstream ofs(out.string(), std::ios::out | std::ios::trunc);
+		if (!ofs.is_open()) {
+			print_msg(cyng::logging::severity::LEVEL_ERROR, "cannot open file [", out, "]");
+		}
+		else {
+			ofs << cyng::json::to_string(prof.to_object()) << std::flush;
+		}
+
+		if (verbose_ > 0) {
+			std::cout
+				<< "***info: profile of build-in functions ("
+				<< out
+				<< ")"
+				<< std::endl
+				;
+			prof.print(std::cout);
+		}
 	}
 
 
@@ -12,6 +12,7 @@
 #include <docscript/tokenizer.h>
 #include <docscript/statistics.h>
 #include <docscript/include.h>
+#include <docscript/tracer.h>
 
 #include <cyng/intrinsics/sets.h>
 #include <cyng/log/severity.h>
@@ -61,6 +62,12 @@ namespace docscript
 	 * forward declaration
 	 */
 	class reader;
+	class generator_pool;
+	class profiler;
+	class content_cache;
+	class asset_store;
+	class worker_pool;
+	class style_sheet;
 
 	/**
 	 * Driver class for docscript parser.
@@ -115,6 +122,61 @@ namespace docscript
 		 */
 		cyng::param_map_t const& get_meta() const;
 
+		/**
+		 * Take generators from the specified pool instead of
+		 * building a new one for each document.
+		 * The pool must outlive the driver.
+		 */
+		void use_pool(generator_pool&);
+
+		/**
+		 * Record execution statistics of all build-in functions.
+		 * The results are written into a "*.profile.json" file 
+		 * next to the meta file and printed at verbose level 1.
+		 */
+		void set_profiling(bool);
+
+		/**
+		 * Record the timing of all processing phases.
+		 * The tracer must outlive the driver.
+		 */
+		void set_tracer(tracer&);
+
+		/**
+		 * Reuse encoded images and other processed resources.
+		 * The cache must outlive the driver.
+		 */
+		void set_cache(content_cache&);
+
+		/**
+		 * Write images into an asset directory instead of inlining them.
+		 * The asset store must outlive the driver.
+		 */
+		void set_assets(asset_store&);
+
+		/**
+		 * Render listings, figures and tables on the specified threads.
+		 * The worker pool must outlive the driver.
+		 */
+		void set_workers(worker_pool&);
+
+		/**
+		 * Reference a shared stylesheet instead of inlining the style rules.
+		 * The stylesheet must outlive the driver.
+		 */
+		void set_style_sheet(style_sheet&);
+
+		/**
+		 * Write minified HTML.
+		 */
+		void set_minify(bool);
+
+		/**
+		 * Write compressed sidecars (".gz", ".zst") of generated
+		 * HTML and JSON files.
+		 */
+		void set_precompress(unsigned formats);
+
 	private:
 		int run(cyng::filesystem::path const& inp
 			, std::size_t start
@@ -145,6 +207,17 @@ namespace docscript
 		 */
 		void build_bootstrap(cyng::filesystem::path const& in, cyng::filesystem::path out);
 
+		/**
+		 * Execute the program with a generator of the specified format.
+		 *
+		 * @return false if format is unknown
+		 */
+		bool run_generator(std::string const& format, cyng::vector_t&& prg, cyng::filesystem::path const& out);
+
+		void write_profile(profiler const&, cyng::filesystem::path out);
+
+		cyng::vector_t load_iml(cyng::filesystem::path const& in);
+
 		void print_error(cyng::logging::severity, std::string);
 
 		template<typename ...Args>
@@ -230,6 +303,57 @@ namespace docscript
 		 * meta data
 		 */
 		cyng::param_map_t meta_;
+
+		/**
+		 * optional pool of generators
+		 */
+		generator_pool* pool_;
+
+		/**
+		 * profile build-in functions
+		 */
+		bool profiling_;
+
+		/**
+		 * optional timing trace
+		 */
+		tracer* tracer_;
+
+		/**
+		 * optional cache of processed resources
+		 */
+		content_cache* cache_;
+
+		/**
+		 * optional external asset directory
+		 */
+		asset_store* assets_;
+
+		/**
+		 * optional threads for expensive build-in functions
+		 */
+		worker_pool* workers_;
+
+		/**
+		 * optional external stylesheet
+		 */
+		style_sheet* style_sheet_;
+
+		/**
+		 * minify HTML output
+		 */
+		bool minify_;
+
+		/**
+		 * formats of compressed sidecars
+		 */
+		unsigned precompress_;
+
+		/**
+		 * accumulated time spent in sanitizer and tokenizer.
+		 * Only updated if tracing is enabled.
+		 */
+		tracer::clock_t::duration	sanitize_time_, tokenize_time_;
 	};
 
 	/**
@@ -148,7 +148,14 @@ namespace docscript
 	{
 		auto start = std::begin(str);
 		auto stop = std::end(str);
-		driver_.sanitizer_.read(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
+		if (driver_.tracer_ != nullptr) {
+			auto const now = tracer::clock_t::now();
+			driver_.sanitizer_.read(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
+			driver_.sanitize_time_ += tracer::clock_t::now() - now;
+		}
+		else {
+			driver_.sanitizer_.read(boost::u8_to_u32_iterator<std::string::const_iterator>(start), boost::u8_to_u32_iterator<std::string::const_iterator>(stop));
+		}
 	}
 
 	incl_t reader::parse_include(std::string const& line)